@@ -2,7 +2,11 @@
 #define __ACLIB_H
 
 #include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #define __USE_GNU // Include execvpe
 #include <sys/wait.h>
@@ -12,25 +16,33 @@
 // - ACLIB_IMPLEMENTATION
 // - ACLIB_STRIP_PREFIX
 // - ACLIBDEF
-// - ACLIB_VEC_GROWTH_RATE
+// - ACLIB_VEC_GROWTH_FACTOR
 // - ACLIB_VEC_START_CAP
+// - ACLIB_VEC_GROWTH_FN
+// - ACLIB_STR_GROWTH_FN
+// - ACLIB_ARENA_CHUNK_SIZE
 // - ACLIB_ASSERT_FN
-// - ACLIB_CALLOC_FN
 // - ACLIB_MALLOC_FN
 // - ACLIB_REALLOC_FN
 // - ACLIB_FREE_FN
 // - ACLIB_LOG_FN
+// - ACLIB_NO_SIMD
 
 // LIST OF FEATURES
 // - Generic Vector
+// - Generic Small Vector
+// - Generic Deque
+// - Generic Hash Map
 // - Generic Slice
 // - String
+// - Small String
 // - Log
 // - Result
 // - Option
+// - Allocator
+// - Arena
 //
 // LIST OF PLANNED FEATURES
-// - Arena
 // - Cmd runner
 
 #ifndef ACLIBDEF
@@ -42,25 +54,35 @@
 #define ACLIB_ASSERT_FN assert
 #endif
 
+#ifdef ACLIB_CALLOC_FN
+#error "ACLIB_CALLOC_FN was removed, zeroed memory is allocated with ACLIB_MALLOC_FN and cleared"
+#endif
+
+#if !defined(ACLIB_MALLOC_FN) && !defined(ACLIB_REALLOC_FN)
+/// Set when aclib allocates with the libc malloc, so it can ask libc for the usable size
+#define __ACLIB_LIBC_MALLOC
+#endif
+
 #ifndef ACLIB_MALLOC_FN
 #include <stdlib.h>
 #define ACLIB_MALLOC_FN malloc
 #endif
 
-#ifndef ACLIB_CALLOC_FN
+#ifndef ACLIB_REALLOC_FN
 #include <stdlib.h>
-#define ACLIB_CALLOC_FN calloc
+#define ACLIB_REALLOC_FN realloc
 #endif
 
-#ifndef ACLIB_REALLOC_FN
+#ifndef ACLIB_FREE_FN
 #include <stdlib.h>
-#define ACLIB_REALLOC_FN realloc
+#define ACLIB_FREE_FN free
 #endif
 
 #define _Nullable
 
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -170,6 +192,7 @@ typedef enum Ac_ResTag
 //  - Ac_OptTag
 //  - Ac_OptDef(T)
 //  - Ac_CharOpt
+//  - Ac_SizeOpt
 //
 // FUNCTIONS AND MACROS:
 //  - ac_opt_some(val)
@@ -198,6 +221,9 @@ typedef enum Ac_OptTag
 /// An option holding a char
 typedef Ac_OptDef(char) Ac_CharOpt;
 
+/// An option holding a size or an index
+typedef Ac_OptDef(size_t) Ac_SizeOpt;
+
 /// Construct a new opt with a some value
 #define ac_opt_some(val) {.tag = AC_OPT_SOME, .some = (val)}
 
@@ -227,17 +253,248 @@ typedef Ac_OptDef(char) Ac_CharOpt;
 
 
 
+/*             *
+ *  ALLOCATOR  *
+ *             */
+// CONFIG DEFINES:
+//  - ACLIB_MALLOC_FN
+//  - ACLIB_REALLOC_FN
+//  - ACLIB_FREE_FN
+//
+// CONST DEFINES:
+//  -
+//
+// TYPES AND TYPE MACROS:
+//  - Ac_Allocator
+//
+// FUNCTIONS AND MACROS:
+//  - ac_allocator_current()
+//  - ac_allocator_alloc(*allocator, size)
+//  - ac_allocator_realloc(*allocator, *ptr, old_size, new_size)
+//  - ac_allocator_free(*allocator, *ptr)
+//  - ac_allocator_usable_size(*allocator, *ptr, requested)
+//
+// USAGE:
+//  # DEFINING
+//  An allocator is a set of functions, and a context pointer that is passed to each of them
+//  ```c
+//  Ac_Allocator pool_allocator = {
+//      .alloc = pool_alloc,
+//      .realloc = pool_realloc,
+//      .free = pool_free,
+//      .ctx = &pool,
+//  };
+//  ```
+//
+//  # USING
+//  Vectors and strings hold a pointer to the allocator they allocate from. If it is NULL, it is
+//  set to `ac_allocator_current()` on their first allocation
+//  ```c
+//  Ac_String str = {.allocator = &pool_allocator};
+//  ac_str_append(&str, "foo"); // -> allocated with pool_alloc
+//  ac_str_free(&str);          // -> freed with pool_free
+//  ```
+//
+//  The allocator used by a thread can be changed by setting `aclib_thread_allocator`. This is
+//  also used for allocations that are not tied to a container, like cloned slices
+//  ```c
+//  aclib_thread_allocator = &pool_allocator;
+//  ```
+
+/// A set of allocation functions, and the context they work on
+typedef struct Ac_Allocator
+{
+    /// Allocate `size` bytes
+    void* (*alloc)(void* ctx, size_t size);
+    /// Resize an allocation of `old_size` bytes to `new_size` bytes
+    void* (*realloc)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+    /// Free an allocation. May be NULL if the allocator frees its memory in other ways
+    void (*free)(void* ctx, void* ptr);
+    /// Get the amount of bytes that can actually be used in an allocation, which may be more than
+    /// was asked for. May be NULL if the allocator cannot tell
+    size_t (*usable_size)(void* ctx, void* ptr);
+    /// The context passed to each of the functions
+    void* ctx;
+} Ac_Allocator;
+
+/// The default allocator, which uses `ACLIB_MALLOC_FN`, `ACLIB_REALLOC_FN` and `ACLIB_FREE_FN`
+extern const Ac_Allocator aclib_default_allocator;
+/// The allocator used by the current thread, when no other allocator is given. If NULL, the
+/// default allocator is used
+extern _Thread_local const Ac_Allocator* aclib_thread_allocator;
+
+/// Get the allocator used by the current thread
+ACLIBDEF const Ac_Allocator* ac_allocator_current(void);
+
+/// Allocate memory with an allocator. If allocator is NULL, the current thread's allocator is used
+ACLIBDEF void* ac_allocator_alloc(const Ac_Allocator* allocator, size_t size);
+
+/// Resize memory with an allocator. If allocator is NULL, the current thread's allocator is used
+ACLIBDEF void* ac_allocator_realloc(const Ac_Allocator* allocator, void* ptr, size_t old_size,
+                                    size_t new_size);
+
+/// Free memory with an allocator. If allocator is NULL, the current thread's allocator is used
+ACLIBDEF void ac_allocator_free(const Ac_Allocator* allocator, void* ptr);
+
+/// Get the usable size of an allocation, or `requested` if the allocator cannot tell. If allocator
+/// is NULL, the current thread's allocator is used
+ACLIBDEF size_t ac_allocator_usable_size(const Ac_Allocator* allocator, void* ptr,
+                                         size_t requested);
+
+/* END OF ALLOCATOR DECL */
+
+
+
+/*         *
+ *  ARENA  *
+ *         */
+// CONFIG DEFINES:
+//  - ACLIB_ARENA_CHUNK_SIZE
+//
+// CONST DEFINES:
+//  - AC_ARENA_ALIGN
+//
+// TYPES AND TYPE MACROS:
+//  - Ac_ArenaChunk
+//  - Ac_Arena
+//  - Ac_ArenaMark
+//
+// FUNCTIONS AND MACROS:
+//  - ac_arena_alloc(*arena, size)
+//  - ac_arena_alloc_aligned(*arena, size, align)
+//  - ac_arena_calloc(*arena, count, size)
+//  - ac_arena_realloc(*arena, *ptr, old_size, new_size)
+//  - ac_arena_mark(*arena)
+//  - ac_arena_reset_to(*arena, mark)
+//  - ac_arena_reset(*arena)
+//  - ac_arena_free(*arena)
+//  - ac_arena_allocator(*arena)
+//
+// USAGE:
+//  # INITIALIZING
+//  An arena can be zero initialized. The first chunk is allocated on the first allocation
+//  ```c
+//  Ac_Arena arena = {0};
+//  ```
+//
+//  # USING
+//  Allocations are bumped out of the current chunk. When a chunk runs out, a new one is chained
+//  after it. Vectors and strings can allocate from an arena through `ac_arena_allocator()`
+//  ```c
+//  Ac_Allocator arena_allocator = ac_arena_allocator(&arena);
+//  Ac_String str = {.allocator = &arena_allocator};
+//  ac_str_append(&str, "foo"); // -> str.chars now lives in the arena
+//  ```
+//
+//  # RESETTING
+//  Everything allocated after a mark can be released at once with `ac_arena_reset_to()`. The
+//  chunks are kept around, and reused by later allocations
+//  ```c
+//  Ac_ArenaMark mark = ac_arena_mark(&arena);
+//  Ac_StrVec parts = ac_str_split_by(str, ',');
+//  ac_arena_reset_to(&arena, mark); // -> parts is gone
+//  ```
+//
+//  # FREEING
+//  Remember to free the arena after use with `ac_arena_free()`. This frees every chunk, and
+//  with it everything that was allocated from the arena
+//  ```c
+//  ac_arena_free(&arena);
+//  ```
+
+#ifndef ACLIB_ARENA_CHUNK_SIZE
+/// The default size of each chunk in an arena, in bytes
+#define ACLIB_ARENA_CHUNK_SIZE (64 * 1024)
+#endif
+
+/// The alignment used by `ac_arena_alloc()`. This is suitable for any builtin type
+#define AC_ARENA_ALIGN (_Alignof(max_align_t))
+
+/// A single chunk of memory owned by an arena
+typedef struct Ac_ArenaChunk
+{
+    /// The next chunk in the chain, or NULL if this is the last chunk
+    struct Ac_ArenaChunk* next;
+    /// The amount of bytes that can be allocated from this chunk
+    size_t cap;
+    /// The amount of bytes that have been allocated from this chunk
+    size_t used;
+    /// The memory of the chunk
+    _Alignas(max_align_t) unsigned char data[];
+} Ac_ArenaChunk;
+
+/// A bump allocator, which allocates memory from a chain of chunks, and frees all of it at once
+typedef struct Ac_Arena
+{
+    /// The first chunk of the arena
+    Ac_ArenaChunk* first;
+    /// The chunk that is currently allocated from
+    Ac_ArenaChunk* current;
+    /// The minimum size of new chunks. Defaults to `ACLIB_ARENA_CHUNK_SIZE` if 0
+    size_t chunk_size;
+    /// The allocator the chunks are allocated from. If NULL, it is set to
+    /// `ac_allocator_current()` when the first chunk is allocated
+    const Ac_Allocator* allocator;
+} Ac_Arena;
+
+/// A position in an arena, which the arena can be reset back to
+typedef struct Ac_ArenaMark
+{
+    /// The chunk that was current when the mark was made
+    Ac_ArenaChunk* chunk;
+    /// The amount of bytes used in the chunk when the mark was made
+    size_t used;
+} Ac_ArenaMark;
+
+/// Allocate memory from an arena, aligned to `AC_ARENA_ALIGN`. The memory is freed when the arena
+/// is reset or freed
+ACLIBDEF void* ac_arena_alloc(Ac_Arena* arena, size_t size);
+
+/// Allocate memory from an arena with a given alignment. The alignment must be a power of two
+ACLIBDEF void* ac_arena_alloc_aligned(Ac_Arena* arena, size_t size, size_t align);
+
+/// Allocate zeroed memory for `count` elements of `size` bytes from an arena. Returns NULL if
+/// `count * size` overflows
+ACLIBDEF void* ac_arena_calloc(Ac_Arena* arena, size_t count, size_t size);
+
+/// Resize an allocation from an arena. If `ptr` is the latest allocation, and the chunk has room,
+/// it is grown in place. Otherwise new memory is allocated, and the contents are copied over
+ACLIBDEF void* ac_arena_realloc(Ac_Arena* arena, void* ptr, size_t old_size, size_t new_size);
+
+/// Get the current position of an arena, which it can later be reset to with
+/// `ac_arena_reset_to()`
+ACLIBDEF Ac_ArenaMark ac_arena_mark(Ac_Arena* arena);
+
+/// Release everything allocated after a mark was made. The chunks are kept for reuse
+ACLIBDEF void ac_arena_reset_to(Ac_Arena* arena, Ac_ArenaMark mark);
+
+/// Release everything allocated from an arena. The chunks are kept for reuse
+ACLIBDEF void ac_arena_reset(Ac_Arena* arena);
+
+/// Free an arena and all of its chunks
+ACLIBDEF void ac_arena_free(Ac_Arena* arena);
+
+/// Get an allocator that allocates from an arena. Freeing memory through it does nothing, as the
+/// memory is released when the arena is reset or freed
+ACLIBDEF Ac_Allocator ac_arena_allocator(Ac_Arena* arena);
+
+/* END OF ARENA DECL */
+
+
+
 /*          *
  *  VECTOR  *
  *          */
 // CONFIG DEFINES:
-//  - ACLIB_VEC_GROWTH
+//  - ACLIB_VEC_GROWTH_FACTOR
 //  - ACLIB_VEC_START_CAP
+//  - ACLIB_VEC_GROWTH_FN
 //
 // CONST DEFINES:
 //  - AC_VEC_FOREACH
 //
 // TYPES AND TYPE MACROS:
+//  - Ac_GrowthFn
 //  - Ac_VecDef(T)
 //
 // FUNCTIONS/MACROS:
@@ -261,6 +518,11 @@ typedef Ac_OptDef(char) Ac_CharOpt;
 //      - todo: ac_vec_split_at(vec, idx)
 //  - ac_vec_free(vec)
 //  - ac_vec_ensure_cap(vec, new_cap)
+//  - ac_vec_reserve_exact(vec, new_cap)
+//  - ac_vec_shrink_to_fit(vec)
+//  - ac_growth_geometric(cap, needed, elem_size)
+//  - ac_growth_pow2(cap, needed, elem_size)
+//  - ac_growth_exact(cap, needed, elem_size)
 //
 //
 // USAGE:
@@ -293,9 +555,15 @@ typedef Ac_OptDef(char) Ac_CharOpt;
 //  ac_vec_free(al);
 //  ```
 
-#ifndef ACLIB_VEC_GROWTH_RATE
-/// The rate of vectors growth
-#define ACLIB_VEC_GROWTH_RATE 1.5
+// ACLIB_VEC_GROWTH_RATE was renamed to ACLIB_VEC_GROWTH_FACTOR, so keep honoring the old name
+#if defined(ACLIB_VEC_GROWTH_RATE) && !defined(ACLIB_VEC_GROWTH_FACTOR)
+#define ACLIB_VEC_GROWTH_FACTOR ACLIB_VEC_GROWTH_RATE
+#endif
+
+#ifndef ACLIB_VEC_GROWTH_FACTOR
+/// The factor a vector's capacity is multiplied by, when it grows with `ac_growth_geometric()`.
+/// Can be fractional, e.g. 1.5, and must be greater than 1. Formerly `ACLIB_VEC_GROWTH_RATE`
+#define ACLIB_VEC_GROWTH_FACTOR 2
 #endif
 
 #ifndef ACLIB_VEC_START_CAP
@@ -303,20 +571,40 @@ typedef Ac_OptDef(char) Ac_CharOpt;
 #define ACLIB_VEC_START_CAP 10
 #endif
 
+#ifndef ACLIB_VEC_GROWTH_FN
+/// The growth policy used by `ac_vec_ensure_cap()`. Must be an `Ac_GrowthFn`
+#define ACLIB_VEC_GROWTH_FN ac_growth_geometric
+#endif
+
+/// A growth policy. Given the current capacity, the needed capacity, and the size of each element,
+/// it returns the new capacity to allocate. Returning less than `needed` is treated as `needed`
+typedef size_t (*Ac_GrowthFn)(size_t cap, size_t needed, size_t elem_size);
+
+/// Grow geometrically by `ACLIB_VEC_GROWTH_FACTOR`, starting at `ACLIB_VEC_START_CAP`. This makes
+/// the amount of reallocations logarithmic in the amount of pushes
+ACLIBDEF size_t ac_growth_geometric(size_t cap, size_t needed, size_t elem_size);
+
+/// Grow to the next power of two that fits the needed capacity
+ACLIBDEF size_t ac_growth_pow2(size_t cap, size_t needed, size_t elem_size);
+
+/// Grow to exactly the needed capacity
+ACLIBDEF size_t ac_growth_exact(size_t cap, size_t needed, size_t elem_size);
+
 /// Define a Vector struct with the given inner type T
-#define Ac_VecDef(T)              \
-    struct                        \
-    {                             \
-        union                     \
-        {                         \
-            Ac_SliceDef(T) slice; \
-            struct                \
-            {                     \
-                T* items;         \
-                size_t len;       \
-            };                    \
-        };                        \
-        size_t cap;               \
+#define Ac_VecDef(T)                   \
+    struct                             \
+    {                                  \
+        union                          \
+        {                              \
+            Ac_SliceDef(T) slice;      \
+            struct                     \
+            {                          \
+                T* items;              \
+                size_t len;            \
+            };                         \
+        };                             \
+        size_t cap;                    \
+        const Ac_Allocator* allocator; \
     }
 
 /// Iterate over a vector or slice
@@ -336,13 +624,14 @@ typedef Ac_OptDef(char) Ac_CharOpt;
          : ((T){0}))
 
 /// Create a new vector from a pointer or array. This will clone the contents of the pointer or
-/// array.
+/// array, with the current thread's allocator.
 /// The caller is responsible for freeing the new vector with `ac_vec_free()`
 #define ac_vec_from(arr, size)                                      \
     {                                                               \
         .items = __aclib_clone_arr((arr), (size) * sizeof(*(arr))), \
         .len = (size),                                              \
         .cap = (size),                                              \
+        .allocator = ac_allocator_current(),                        \
     }
 
 /// Push an item to a vector
@@ -355,12 +644,12 @@ typedef Ac_OptDef(char) Ac_CharOpt;
 
 
 /// Add an element to the front of the vector
-#define ac_vec_unshift(vec, item)                           \
-    {                                                       \
-        ac_vec_ensure_cap((vec), (vec)->len + 1);           \
-        memcpy((vec)->items + 1, (vec)->items, (vec)->len); \
-        (vec)->items[0] = (item);                           \
-        (vec)->len++;                                       \
+#define ac_vec_unshift(vec, item)                                                      \
+    {                                                                                  \
+        ac_vec_ensure_cap((vec), (vec)->len + 1);                                      \
+        memmove((vec)->items + 1, (vec)->items, (vec)->len * sizeof((vec)->items[0])); \
+        (vec)->items[0] = (item);                                                      \
+        (vec)->len++;                                                                  \
     }
 
 
@@ -404,7 +693,7 @@ typedef Ac_OptDef(char) Ac_CharOpt;
         ACLIB_ASSERT_FN((vec)->len >= 1 &&                                                       \
                         "Vector failed to shift, expected length of >= 1, but got length of 0"); \
         *(out) = (vec)->items[0];                                                                \
-        memcpy((vec)->items, (vec)->items + 1, (vec)->len - 1);                                  \
+        memmove((vec)->items, (vec)->items + 1, ((vec)->len - 1) * sizeof((vec)->items[0]));     \
         (vec)->len -= 1;                                                                         \
     }
 
@@ -416,46 +705,596 @@ typedef Ac_OptDef(char) Ac_CharOpt;
 /// Empty the given vector. This does not free or remove any memory
 #define ac_vec_empty(vec) (vec)->len = 0
 
-/// Free the given vector and its contents
-#define ac_vec_free(vec)   \
-    {                      \
-        free((vec).items); \
-        (vec).items = 0;   \
-        (vec).len = 0;     \
-        (vec).cap = 0;     \
-    }
-
-
-/// Ensure that a vector has atleast the given capacity.
-#define ac_vec_ensure_cap(vec, new_cap)                                                      \
-    if ((vec)->cap < new_cap)                                                                \
-    {                                                                                        \
-        size_t calced_cap;                                                                   \
-        if ((vec)->cap == 0)                                                                 \
-        {                                                                                    \
-            calced_cap = ACLIB_VEC_START_CAP;                                                \
-        }                                                                                    \
-        else                                                                                 \
-        {                                                                                    \
-            calced_cap = (new_cap * ACLIB_VEC_GROWTH_RATE);                                  \
-        }                                                                                    \
-        (vec)->items = ACLIB_REALLOC_FN((vec)->items, calced_cap * sizeof((vec)->items[0])); \
-                                                                                             \
-        if ((vec)->items == NULL)                                                            \
-        {                                                                                    \
-            ac_log(ACLIB_ERR, "Failed to reallocate vector\n");                              \
-            exit(EXIT_FAILURE);                                                              \
-        }                                                                                    \
-                                                                                             \
-        (vec)->cap = new_cap;                                                                \
+/// Free the given vector and its contents, with the vector's allocator
+#define ac_vec_free(vec)                                     \
+    {                                                        \
+        if (!__aclib_vec_is_inline(&(vec)))                  \
+            ac_allocator_free((vec).allocator, (vec).items); \
+        (vec).items = 0;                                     \
+        (vec).len = 0;                                       \
+        (vec).cap = 0;                                       \
+    }
+
+
+/// Ensure that a vector has atleast the given capacity, growing it with `ACLIB_VEC_GROWTH_FN`.
+/// The memory is allocated with the vector's allocator
+#define ac_vec_ensure_cap(vec, new_cap)                                         \
+    if ((vec)->cap < (new_cap))                                                 \
+    {                                                                           \
+        (vec)->items = __aclib_vec_grow((vec), (new_cap), ACLIB_VEC_GROWTH_FN); \
+    }
+
+/// Ensure that a vector has atleast the given capacity, without allocating any more than that
+#define ac_vec_reserve_exact(vec, new_cap)                                  \
+    if ((vec)->cap < (new_cap))                                             \
+    {                                                                       \
+        (vec)->items = __aclib_vec_grow((vec), (new_cap), ac_growth_exact); \
+    }
+
+/// Shrink the capacity of a vector down to its length. The inline items of a small vector are
+/// kept where they are
+#define ac_vec_shrink_to_fit(vec)                                                  \
+    if (!__aclib_vec_is_inline(vec))                                               \
+    {                                                                              \
+        (vec)->items = __aclib_shrink((vec)->items, &(vec)->cap, (vec)->allocator, \
+                                      sizeof((vec)->items[0]), (vec)->len);        \
     }
 
+/// The size of the members every vector and small vector start with
+#define __ACLIB_VEC_HEADER_SIZE sizeof(Ac_VecDef(char))
+
+/// Get the offset of a small vector's inline items, which come right after the vector members
+#define __aclib_vec_inline_offset(vec)                              \
+    ((__ACLIB_VEC_HEADER_SIZE + __alignof__((vec)->items[0]) - 1) & \
+     ~(__alignof__((vec)->items[0]) - 1))
+
+/// Get the amount of elements that fit inline in a vector. This is 0 for a vector, and atleast N
+/// for a small vector. It is known at compile time, so vectors pay nothing for small vectors
+#define __aclib_vec_inline_cap(vec)                                                    \
+    (sizeof(*(vec)) > __aclib_vec_inline_offset(vec)                                   \
+         ? (sizeof(*(vec)) - __aclib_vec_inline_offset(vec)) / sizeof((vec)->items[0]) \
+         : 0)
+
+/// Get a pointer to the inline items of a small vector
+#define __aclib_vec_inline_items(vec) ((void*)((char*)(vec) + __aclib_vec_inline_offset(vec)))
+
+/// Check if the items of a small vector are its inline ones. Always false for a vector
+#define __aclib_vec_is_inline(vec) \
+    (__aclib_vec_inline_cap(vec) > 0 && (void*)(vec)->items == __aclib_vec_inline_items(vec))
+
+/// Grow the items of a vector or small vector to fit atleast `new_cap` elements
+#define __aclib_vec_grow(vec, new_cap, growth_fn)                                              \
+    (__aclib_vec_inline_cap(vec) == 0                                                          \
+         ? __aclib_grow((vec)->items, &(vec)->cap, &(vec)->allocator, sizeof((vec)->items[0]), \
+                        (new_cap), (growth_fn))                                                \
+         : __aclib_smallvec_grow((vec)->items, (vec)->len, &(vec)->cap, &(vec)->allocator,     \
+                                 sizeof((vec)->items[0]), (new_cap), (growth_fn),              \
+                                 __aclib_vec_inline_items(vec), __aclib_vec_inline_cap(vec)))
+
 void* __aclib_clone_arr(void* ptr, size_t size);
 
+/// Grow an allocation of `*cap` elements, so it fits atleast `new_cap` elements. Sets `*cap` to the
+/// new capacity, and `*allocator` to the current allocator if it is NULL
+void* __aclib_grow(void* items, size_t* cap, const Ac_Allocator** allocator, size_t elem_size,
+                   size_t new_cap, Ac_GrowthFn growth_fn);
+
+/// Shrink an allocation of `*cap` elements down to `len` elements, freeing it if `len` is 0
+void* __aclib_shrink(void* items, size_t* cap, const Ac_Allocator* allocator, size_t elem_size,
+                     size_t len);
+
 /* END OF VECTOR DECL */
 
 
 
+/*                *
+ *  SMALL VECTOR  *
+ *                */
+// CONFIG DEFINES:
+//  -
+//
+// CONST DEFINES:
+//  -
+//
+// TYPES AND TYPE MACROS:
+//  - Ac_SmallVecDef(T, N)
+//
+// FUNCTIONS/MACROS:
+//  - ac_smallvec_is_inline(vec)
+//
+// USAGE:
+//  # DEFINING
+//  Define a small vector type with the `Ac_SmallVecDef(T, N)` macro, where N is the amount of
+//  elements that are stored inline, e.g:
+//  ```c
+//  typedef Ac_SmallVecDef(int, 8) IntSmallVec;
+//  ```
+//
+//  # USING
+//  A small vector starts with the same members as a vector, so it is used with the same `ac_vec_`
+//  macros and `AC_VEC_FOREACH`, and its elements are accessed through `items` like a vector's.
+//  Up to N elements are stored inside the struct itself, and the elements are only moved to the
+//  heap, once it grows past that
+//  ```c
+//  IntSmallVec ivec = {0};
+//
+//  ac_vec_push(&ivec, 1); // -> no allocation
+//  ivec.items[0]; // -> 1
+//  ```
+//
+//  While the elements are inline, `items` points into the struct itself. So a small vector must
+//  not be copied or returned by value while `ac_smallvec_is_inline()`, as the copy would still
+//  point at the original's elements
+//
+//  # FREEING
+//  Remember to free the vector after use with `ac_vec_free()`, as it might have moved to the heap
+//  ```c
+//  ac_vec_free(ivec);
+//  ```
+
+/// Define a Small Vector struct with the given inner type T, which stores up to N elements inline.
+/// Its first members are the same as `Ac_VecDef(T)`'s
+#define Ac_SmallVecDef(T, N)                                                  \
+    struct                                                                    \
+    {                                                                         \
+        union                                                                 \
+        {                                                                     \
+            Ac_SliceDef(T) slice;                                             \
+            struct                                                            \
+            {                                                                 \
+                T* items;                                                     \
+                size_t len;                                                   \
+            };                                                                \
+        };                                                                    \
+        size_t cap;                                                           \
+        const Ac_Allocator* allocator;                                        \
+        /* The inline storage, which items points at until it grows past N */ \
+        T inline_items[N];                                                    \
+    }
+
+/// Check if a small vector stores its elements inline
+#define ac_smallvec_is_inline(vec) __aclib_vec_is_inline(&(vec))
+
+/// Grow the items of a small vector, so they fit atleast `new_cap` elements. A vector without items
+/// starts out with its inline ones, and inline items are moved to a new heap allocation once they
+/// don't fit. Sets `*cap` to the new capacity
+void* __aclib_smallvec_grow(void* items, size_t len, size_t* cap, const Ac_Allocator** allocator,
+                            size_t elem_size, size_t new_cap, Ac_GrowthFn growth_fn,
+                            void* inline_items, size_t inline_cap);
+
+/* END OF SMALL VECTOR DECL */
+
+
+
+/*         *
+ *  DEQUE  *
+ *         */
+// CONFIG DEFINES:
+//  -
+//
+// CONST DEFINES:
+//  -
+//
+// TYPES AND TYPE MACROS:
+//  - Ac_DequeDef(T)
+//
+// FUNCTIONS/MACROS:
+//  - ac_deque_at(deque, idx)
+//  - ac_deque_front(deque)
+//  - ac_deque_back(deque)
+//  - ac_deque_push_back(*deque, item)
+//  - ac_deque_push_front(*deque, item)
+//  - ac_deque_pop_back(*deque)
+//  - ac_deque_pop_front(*deque)
+//  - ac_deque_pop_back_opt(T, *deque)
+//  - ac_deque_pop_front_opt(T, *deque)
+//  - ac_deque_front_slice(T, deque)
+//  - ac_deque_back_slice(T, deque)
+//  - ac_deque_empty(*deque)
+//  - ac_deque_free(*deque)
+//  - ac_deque_ensure_cap(*deque, new_cap)
+//
+// USAGE:
+//  # DEFINING
+//  Define a deque type with the `Ac_DequeDef(T)` macro, e.g:
+//  ```c
+//  typedef Ac_DequeDef(int) IntDeque;
+//  ```
+//
+//  # INITIALIZING
+//  To create such a deque, you can zero intialize it:
+//  ```c
+//  IntDeque ideque = {0};
+//  ```
+//
+//  # USING
+//  A deque is a ring buffer, so elements can be pushed and popped at both ends in O(1)
+//  ```c
+//  ac_deque_push_back(&ideque, 1);  // -> ideque = { 1 }
+//  ac_deque_push_front(&ideque, 2); // -> ideque = { 2, 1 }
+//  ac_deque_pop_back(&ideque);      // -> 1
+//  ```
+//
+//  The elements can wrap around the end of the buffer. `ac_deque_front_slice()` and
+//  `ac_deque_back_slice()` give the two contiguous parts, in order
+//
+//  # FREEING
+//  Remember to free the deque after use with `ac_deque_free()`, to avoid memory leaks
+//  ```c
+//  ac_deque_free(&ideque);
+//  ```
+
+/// Define a Deque struct with the given inner type T
+#define Ac_DequeDef(T)                                \
+    struct                                            \
+    {                                                 \
+        T* items;                                     \
+        /* The index of the first element in items */ \
+        size_t head;                                  \
+        size_t len;                                   \
+        /* Always 0 or a power of two */              \
+        size_t cap;                                   \
+        const Ac_Allocator* allocator;                \
+    }
+
+/// Get the element at an index in a deque. Can be assigned to
+#define ac_deque_at(deque, idx) ((deque).items[((deque).head + (idx)) & ((deque).cap - 1)])
+
+/// Get the first element of a deque
+#define ac_deque_front(deque) ac_deque_at((deque), 0)
+
+/// Get the last element of a deque
+#define ac_deque_back(deque) ac_deque_at((deque), (deque).len - 1)
+
+/// Push an item to the back of a deque
+#define ac_deque_push_back(deque, item)                 \
+    {                                                   \
+        ac_deque_ensure_cap((deque), (deque)->len + 1); \
+        ac_deque_at(*(deque), (deque)->len) = (item);   \
+        (deque)->len += 1;                              \
+    }
+
+/// Push an item to the front of a deque
+#define ac_deque_push_front(deque, item)                                         \
+    {                                                                            \
+        ac_deque_ensure_cap((deque), (deque)->len + 1);                          \
+        (deque)->head = ((deque)->head + (deque)->cap - 1) & ((deque)->cap - 1); \
+        (deque)->items[(deque)->head] = (item);                                  \
+        (deque)->len += 1;                                                       \
+    }
+
+/// Pops and returns the last element of a deque.
+/// This asserts that the deque has an element that can be popped
+#define ac_deque_pop_back(deque)                                                           \
+    (ACLIB_ASSERT_FN((deque)->len >= 1 &&                                                  \
+                     "Deque failed to pop, expected length of >= 1, but got length of 0"), \
+     (deque)->len -= 1, ac_deque_at(*(deque), (deque)->len))
+
+/// Pops and returns the first element of a deque.
+/// This asserts that the deque has an element that can be popped
+#define ac_deque_pop_front(deque)                                                          \
+    (ACLIB_ASSERT_FN((deque)->len >= 1 &&                                                  \
+                     "Deque failed to pop, expected length of >= 1, but got length of 0"), \
+     (deque)->len -= 1, (deque)->head = ((deque)->head + 1) & ((deque)->cap - 1),          \
+     (deque)->items[((deque)->head + (deque)->cap - 1) & ((deque)->cap - 1)])
+
+/// Pops and returns the last element of a deque as an option. Returns with AC_OPT_NONE if there
+/// was no value to pop
+#define ac_deque_pop_back_opt(T, deque) \
+    ((deque)->len >= 1 ? (T)ac_opt_some(ac_deque_pop_back(deque)) : (T)ac_opt_none())
+
+/// Pops and returns the first element of a deque as an option. Returns with AC_OPT_NONE if there
+/// was no value to pop
+#define ac_deque_pop_front_opt(T, deque) \
+    ((deque)->len >= 1 ? (T)ac_opt_some(ac_deque_pop_front(deque)) : (T)ac_opt_none())
+
+/// Get the first contiguous part of a deque as a slice of type T. This does not clone or copy any
+/// of the elements
+#define ac_deque_front_slice(T, deque)                                                \
+    ((T){.items = (deque).items + (deque).head,                                       \
+         .len = (deque).head + (deque).len > (deque).cap ? (deque).cap - (deque).head \
+                                                         : (deque).len})
+
+/// Get the second contiguous part of a deque as a slice of type T, which holds the elements that
+/// wrapped around to the start of the buffer. This does not clone or copy any of the elements
+#define ac_deque_back_slice(T, deque)                          \
+    ((T){.items = (deque).items,                               \
+         .len = (deque).head + (deque).len > (deque).cap       \
+                    ? (deque).head + (deque).len - (deque).cap \
+                    : 0})
+
+/// Empty the given deque. This does not free or remove any memory
+#define ac_deque_empty(deque) ((deque)->len = 0, (deque)->head = 0)
+
+/// Free the given deque and its contents, with the deque's allocator
+#define ac_deque_free(deque)                                   \
+    {                                                          \
+        ac_allocator_free((deque)->allocator, (deque)->items); \
+        (deque)->items = 0;                                    \
+        (deque)->head = 0;                                     \
+        (deque)->len = 0;                                      \
+        (deque)->cap = 0;                                      \
+    }
+
+/// Ensure that a deque has atleast the given capacity. The capacity is rounded up to a power of two
+#define ac_deque_ensure_cap(deque, new_cap)                                                    \
+    if ((deque)->cap < (new_cap))                                                              \
+    {                                                                                          \
+        (deque)->items = __aclib_deque_grow((deque)->items, (deque)->head, (deque)->len,       \
+                                            &(deque)->cap, &(deque)->allocator,                \
+                                            sizeof((deque)->items[0]), (new_cap));             \
+    }
+
+/// Grow the ring buffer of a deque to fit atleast `new_cap` elements, and move the elements that
+/// wrapped around, so they are contiguous with the rest again
+void* __aclib_deque_grow(void* items, size_t head, size_t len, size_t* cap,
+                         const Ac_Allocator** allocator, size_t elem_size, size_t new_cap);
+
+/* END OF DEQUE DECL */
+
+
+
+/*       *
+ *  MAP  *
+ *       */
+// CONFIG DEFINES:
+//  -
+//
+// CONST DEFINES:
+//  -
+//
+// TYPES AND TYPE MACROS:
+//  - Ac_MapHashFn
+//  - Ac_MapEqlFn
+//  - Ac_MapCore
+//  - Ac_MapDef(K, V)
+//
+// FUNCTIONS/MACROS:
+//  - ac_map_with(hash_fn, eql_fn)
+//  - ac_map_insert(*map, key, value)
+//  - ac_map_get(T, *map, key)
+//  - ac_map_find(*map, key)
+//  - ac_map_contains(*map, key)
+//  - ac_map_remove(T, *map, key)
+//  - ac_map_reserve(*map, count)
+//  - ac_map_rehash(*map, count)
+//  - ac_map_empty(*map)
+//  - ac_map_free(*map)
+//  - AC_MAP_FOREACH(map, entry)
+//  - ac_map_hash_bytes(*key, key_size)
+//  - ac_map_eql_bytes(*a, *b, key_size)
+//  - ac_map_hash_str(*key, key_size)
+//  - ac_map_eql_str(*a, *b, key_size)
+//
+// USAGE:
+//  # DEFINING
+//  Define a map type with the `Ac_MapDef(K, V)` macro, e.g:
+//  ```c
+//  typedef Ac_MapDef(int, float) IntFloatMap;
+//  typedef Ac_OptDef(float) FloatOpt;
+//  ```
+//
+//  # INITIALIZING
+//  To create such a map, you can zero intialize it. Keys are then hashed and compared byte by byte,
+//  except for `Ac_StrSlice` keys, which are hashed and compared by their contents. Keys with
+//  padding bytes, or keys that should be compared some other way, need their own functions:
+//  ```c
+//  IntFloatMap map = {0};
+//  PointMap points = ac_map_with(point_hash, point_eql);
+//  ```
+//
+//  # USING
+//  ```c
+//  ac_map_insert(&map, 1, 0.5f);         // -> map = { 1: 0.5 }
+//  ac_map_insert(&map, 1, 2.0f);         // -> map = { 1: 2.0 }
+//  ac_map_get(FloatOpt, &map, 1);        // -> { .tag = AC_OPT_SOME, .some = 2.0 }
+//  ac_map_remove(FloatOpt, &map, 1);     // -> { .tag = AC_OPT_SOME, .some = 2.0 }, map = {}
+//  ac_map_contains(&map, 1);             // -> false
+//  ```
+//
+//  The map is a Swiss table: a control byte per slot holds 7 bits of the key's hash, and lookups
+//  compare 16 control bytes at a time, so most keys are compared only once. The map never holds
+//  more than 7/8 of its capacity, and use `ac_map_reserve()` to avoid rehashing while filling it.
+//  The map only copies the keys and values, so e.g. the chars of `Ac_StrSlice` keys must outlive
+//  the map
+//
+//  # FREEING
+//  Remember to free the map after use with `ac_map_free()`, to avoid memory leaks
+//  ```c
+//  ac_map_free(&map);
+//  ```
+//  The macros use the GNU statement expression and `__typeof__` extensions
+
+/// Hash a key of a map. key points to the key, which is key_size bytes
+typedef uint64_t (*Ac_MapHashFn)(const void* key, size_t key_size);
+
+/// Check whether two keys of a map are equal. a and b point to the keys, which are key_size bytes
+typedef bool (*Ac_MapEqlFn)(const void* a, const void* b, size_t key_size);
+
+/// The part of a map that doesn't depend on its key and value types. It has the same layout as the
+/// maps defined with `Ac_MapDef()`
+typedef struct Ac_MapCore
+{
+    void* entries;
+    uint8_t* ctrl;
+    size_t len;
+    size_t cap;
+    size_t growth_left;
+    Ac_MapHashFn hash;
+    Ac_MapEqlFn eql;
+    const Ac_Allocator* allocator;
+} Ac_MapCore;
+
+/// Define a Map struct with the given key type K and value type V
+#define Ac_MapDef(K, V)                                                            \
+    union                                                                          \
+    {                                                                              \
+        Ac_MapCore core;                                                           \
+        struct                                                                     \
+        {                                                                          \
+            /* The slots of the map. Only the slots with a full control byte hold  \
+               an entry */                                                         \
+            struct                                                                 \
+            {                                                                      \
+                K key;                                                             \
+                V value;                                                           \
+            }* entries;                                                            \
+            /* A control byte for each slot, followed by a copy of the first 16 */ \
+            uint8_t* ctrl;                                                         \
+            size_t len;                                                            \
+            /* Always 0 or a power of two, which is atleast 16 */                  \
+            size_t cap;                                                            \
+            /* The amount of entries that can be added before rehashing */         \
+            size_t growth_left;                                                    \
+            /* If NULL, the default hash function for K is used */                 \
+            Ac_MapHashFn hash;                                                     \
+            /* If NULL, the default equality function for K is used */             \
+            Ac_MapEqlFn eql;                                                       \
+            const Ac_Allocator* allocator;                                         \
+        };                                                                         \
+    }
+
+/// Initialize a map with its own hash and equality functions
+#define ac_map_with(hash_fn, eql_fn) {.hash = (hash_fn), .eql = (eql_fn)}
+
+/// Insert a key and value into a map. If the key is already in the map, only its value is replaced
+#define ac_map_insert(map, k, v)                                                              \
+    {                                                                                         \
+        __typeof__((map)->entries->key) __aclib_map_key = (k);                                \
+        __typeof__((map)->entries->value) __aclib_map_value = (v);                            \
+        size_t __aclib_map_idx = __aclib_map_insert_slot(                                     \
+            &(map)->core, &__aclib_map_key, sizeof(*(map)->entries), sizeof(__aclib_map_key), \
+            __aclib_map_hash_fn(map), __aclib_map_eql_fn(map));                               \
+        (map)->entries[__aclib_map_idx].value = __aclib_map_value;                            \
+    }
+
+/// Get the value of a key in a map, as an option of type T. Returns with AC_OPT_NONE if the key
+/// isn't in the map
+#define ac_map_get(T, map, k)                                          \
+    ({                                                                 \
+        size_t __aclib_map_found = __aclib_map_find_key((map), (k));   \
+        __aclib_map_found == SIZE_MAX                                  \
+            ? (T)ac_opt_none()                                         \
+            : (T)ac_opt_some((map)->entries[__aclib_map_found].value); \
+    })
+
+/// Get a pointer to the entry of a key in a map, with its `key` and `value`, or NULL if the key
+/// isn't in the map. The value can be assigned to, but the pointer is only valid until the next
+/// insertion
+#define ac_map_find(map, k)                                                        \
+    ({                                                                             \
+        size_t __aclib_map_found = __aclib_map_find_key((map), (k));               \
+        __aclib_map_found == SIZE_MAX ? NULL : &(map)->entries[__aclib_map_found]; \
+    })
+
+/// Check whether a key is in a map
+#define ac_map_contains(map, k) (__aclib_map_find_key((map), (k)) != SIZE_MAX)
+
+/// Remove a key from a map, and return its value as an option of type T. Returns with AC_OPT_NONE
+/// if the key wasn't in the map
+#define ac_map_remove(T, map, k)                                                           \
+    ({                                                                                     \
+        size_t __aclib_map_found = __aclib_map_find_key((map), (k));                       \
+        T __aclib_map_removed = ac_opt_none();                                             \
+        if (__aclib_map_found != SIZE_MAX)                                                 \
+        {                                                                                  \
+            __aclib_map_removed = (T)ac_opt_some((map)->entries[__aclib_map_found].value); \
+            __aclib_map_erase(&(map)->core, __aclib_map_found);                            \
+        }                                                                                  \
+        __aclib_map_removed;                                                               \
+    })
+
+/// Ensure that a map can hold atleast count entries without rehashing
+#define ac_map_reserve(map, count)                                                 \
+    if ((map)->len + (map)->growth_left < (count))                                 \
+    {                                                                              \
+        __aclib_map_resize(&(map)->core, (count), sizeof(*(map)->entries),         \
+                           sizeof((map)->entries->key), __aclib_map_hash_fn(map)); \
+    }
+
+/// Rehash a map into the smallest capacity that holds count entries, or all of its entries if it
+/// has more than that. This can shrink the map, and it clears the slots left by removed entries
+#define ac_map_rehash(map, count)                                      \
+    __aclib_map_resize(&(map)->core, (count), sizeof(*(map)->entries), \
+                       sizeof((map)->entries->key), __aclib_map_hash_fn(map))
+
+/// Remove every entry from a map. This does not free any memory
+#define ac_map_empty(map) __aclib_map_clear(&(map)->core)
+
+/// Free the given map and its entries, with the map's allocator. The hash and equality functions
+/// are kept
+#define ac_map_free(map)                                  \
+    {                                                     \
+        ac_allocator_free((map)->allocator, (map)->ctrl); \
+        (map)->entries = 0;                               \
+        (map)->ctrl = 0;                                  \
+        (map)->len = 0;                                   \
+        (map)->cap = 0;                                   \
+        (map)->growth_left = 0;                           \
+    }
+
+/// Iterate over the entries of a map, in no particular order
+#define AC_MAP_FOREACH(map, entry)                                                             \
+    for (__typeof__((map).entries) entry = (map).entries; (entry) < (map).entries + (map).cap; \
+         (entry)++)                                                                            \
+        if ((map).ctrl[(entry) - (map).entries] < 0x80)
+
+/// Hash the bytes of a key. The default hash function of a map
+ACLIBDEF uint64_t ac_map_hash_bytes(const void* key, size_t key_size);
+
+/// Compare the bytes of two keys. The default equality function of a map
+ACLIBDEF bool ac_map_eql_bytes(const void* a, const void* b, size_t key_size);
+
+/// Hash the contents of an `Ac_StrSlice` key. The default hash function of maps with such keys
+ACLIBDEF uint64_t ac_map_hash_str(const void* key, size_t key_size);
+
+/// Compare the contents of two `Ac_StrSlice` keys. The default equality function of maps with such
+/// keys
+ACLIBDEF bool ac_map_eql_str(const void* a, const void* b, size_t key_size);
+
+/// Get the hash function of a map, picking the default for its key type if it has none
+#define __aclib_map_hash_fn(map)                                               \
+    ((map)->hash ? (map)->hash                                                 \
+                 : _Generic((map)->entries->key, Ac_StrSlice: ac_map_hash_str, \
+                            default: ac_map_hash_bytes))
+
+/// Get the equality function of a map, picking the default for its key type if it has none
+#define __aclib_map_eql_fn(map)                                              \
+    ((map)->eql ? (map)->eql                                                 \
+                : _Generic((map)->entries->key, Ac_StrSlice: ac_map_eql_str, \
+                           default: ac_map_eql_bytes))
+
+/// Find the slot of a key in a map, or SIZE_MAX if it isn't in the map
+#define __aclib_map_find_key(map, k)                                              \
+    ({                                                                            \
+        __typeof__((map)->entries->key) __aclib_map_key = (k);                    \
+        __aclib_map_find(&(map)->core, &__aclib_map_key, sizeof(*(map)->entries), \
+                         sizeof(__aclib_map_key), __aclib_map_hash_fn(map),       \
+                         __aclib_map_eql_fn(map));                                \
+    })
+
+/// Find the slot of a key in a map, or SIZE_MAX if it isn't in the map
+ACLIBDEF size_t __aclib_map_find(const Ac_MapCore* map, const void* key, size_t entry_size,
+                                 size_t key_size, Ac_MapHashFn hash, Ac_MapEqlFn eql);
+
+/// Find the slot of a key in a map. If it isn't in the map, claim a free slot for it and copy the
+/// key into it, rehashing the map first if it is full
+ACLIBDEF size_t __aclib_map_insert_slot(Ac_MapCore* map, const void* key, size_t entry_size,
+                                        size_t key_size, Ac_MapHashFn hash, Ac_MapEqlFn eql);
+
+/// Remove the entry in a slot of a map
+ACLIBDEF void __aclib_map_erase(Ac_MapCore* map, size_t idx);
+
+/// Rehash a map into the smallest capacity that holds count entries and all of its current ones
+ACLIBDEF void __aclib_map_resize(Ac_MapCore* map, size_t count, size_t entry_size,
+                                 size_t key_size, Ac_MapHashFn hash);
+
+/// Mark every slot of a map as empty
+ACLIBDEF void __aclib_map_clear(Ac_MapCore* map);
+
+/* END OF MAP DECL */
+
+
+
 /*          *
  *  SLICES  *
  *          */
@@ -506,12 +1345,12 @@ void* __aclib_clone_arr(void* ptr, size_t size);
     }
 
 
-/// Free a slice. Be sure that the slice owns its contents before calling this, as it otherwise can
-/// create memory issues
-#define ac_slice_free(slice)  \
-    {                         \
-        free((slice)->items); \
-        (slice)->len = 0;     \
+/// Free a slice with the current thread's allocator. Be sure that the slice owns its contents
+/// before calling this, as it otherwise can create memory issues
+#define ac_slice_free(slice)                     \
+    {                                            \
+        ac_allocator_free(NULL, (slice)->items); \
+        (slice)->len = 0;                        \
     }
 
 /* END OF SLICE DECL */
@@ -522,7 +1361,8 @@ void* __aclib_clone_arr(void* ptr, size_t size);
  *  STRING  *
  *          */
 // CONFIG DEFINES:
-//  -
+//  - ACLIB_STR_GROWTH_FN
+//  - ACLIB_LINE_READER_BUF_SIZE
 //
 // CONST DEFINES
 //  - AC_STR_FMT
@@ -532,6 +1372,26 @@ void* __aclib_clone_arr(void* ptr, size_t size);
 //  - Ac_StrSlice
 //  - Ac_String
 //  - Ac_StrVec
+//  - Ac_SizeVec
+//  - Ac_StrNeedle
+//  - Ac_StrHasher
+//  - Ac_StrLines
+//  - Ac_StrSliceOpt
+//  - Ac_LineReader
+//  - Ac_StrSliceRes
+//  - Ac_ParsedI64, Ac_ParsedI64Res
+//  - Ac_ParsedU64, Ac_ParsedU64Res
+//  - Ac_ParsedF64, Ac_ParsedF64Res
+//  - Ac_MapAdvice
+//  - Ac_ByteSet
+//  - Ac_StrSplitKind
+//  - Ac_StrSplitIter
+//  - Ac_MultiMatch
+//  - Ac_MultiMatchVec
+//  - Ac_MultiMatcher
+//  - Ac_InternedStr
+//  - Ac_InternedStrOpt
+//  - Ac_StrInterner
 //
 // FUNCTIONS AND MACROS:
 //  - ac_str_slice_with_len(len)
@@ -540,15 +1400,33 @@ void* __aclib_clone_arr(void* ptr, size_t size);
 //  - ac_str_slice_clone(slice)
 //  - ac_str_slice_range(str, start, end)
 //  - ac_str_slice_free(*slice)
+//  - ac_arena_str_slice_with_len(*arena, len)
+//  - ac_arena_str_slice_clone(*arena, slice)
+//  - ac_str_slice_clone_in(*allocator, slice)
+//  - ac_str_slice_free_in(*allocator, *slice)
 //
 //  - ac_str_with_capacity(capacity)
 //  - ac_str_from(*chs)
 //  - ac_str_push(*str, ch)
 //  - ac_str_unshift(*str, ch)
 //  - ac_str_append(*str, *chs)
+//  - ac_str_append_slice(*str, slice)
 //  - ac_str_appendf(*str, *fmt, ...)
 //  - ac_str_prepend(*str, *chs)
 //  - ac_str_prependf(*str, *chs)
+//  - ac_str_append_i64(*str, value)
+//  - ac_str_append_u64(*str, value)
+//  - ac_str_append_u64_hex(*str, value)
+//  - ac_str_append_f64(*str, value)
+//  - ac_str_append_i64_padded(*str, value, width, pad)
+//  - ac_str_append_u64_padded(*str, value, width, pad)
+//  - ac_str_append_u64_hex_padded(*str, value, width, pad)
+//  - ac_str_parse_i64(slice)
+//  - ac_str_parse_u64(slice)
+//  - ac_str_parse_f64(slice)
+//  - ac_str_utf8_validate(slice)
+//  - ac_str_utf8_count(slice)
+//  - ac_str_utf8_slice_range(slice, start, end)
 //  - ac_str_pop(*str)
 //  - ac_str_pop_opt(*str)
 //  - ac_str_shift(*str)
@@ -561,6 +1439,8 @@ void* __aclib_clone_arr(void* ptr, size_t size);
 //  - ac_str_empty(*str)
 //  - ac_str_free(*str)
 //  - ac_str_ensure_cap(*str, new_cap)
+//  - ac_str_reserve_exact(*str, new_cap)
+//  - ac_str_shrink_to_fit(*str)
 //  - ac_str_trim_front(*str)
 //  - ac_str_trim_back(*str)
 //  - ac_str_trim(*str)
@@ -568,12 +1448,75 @@ void* __aclib_clone_arr(void* ptr, size_t size);
 //  - ac_str_split_by_once(str, delim)
 //  - ac_str_split_by_many(str, *delims)
 //  - ac_str_split_at(str, idx)
+//  - ac_str_parts_free(*parts)
+//  - ac_str_split_by_borrowed(slice, delim)
+//  - ac_str_split_by_many_borrowed(slice, *delims)
+//  - ac_str_split_by_once_borrowed(slice, delim)
+//  - ac_str_split_at_borrowed(slice, idx)
+//  - ac_str_split_by_into(*parts, slice, delim)
+//  - ac_str_split_by_many_into(*parts, slice, *delims)
+//  - ac_str_split_by_once_into(*parts, slice, delim)
+//  - ac_str_split_at_into(*parts, slice, idx)
+//  - ac_str_split_by_set_borrowed(slice, *set)
+//  - ac_str_split_by_set_into(*parts, slice, *set)
+//  - ac_str_split_iter(slice, delim)
+//  - ac_str_split_iter_many(slice, *delims)
+//  - ac_str_split_iter_set(slice, *set)
+//  - ac_str_split_iter_substr(slice, needle)
+//  - ac_str_split_iter_limit(*iter, max_splits)
+//  - ac_str_split_iter_next(*iter)
 //  - ac_str_read_file(*buffer, *file)
 //  - ac_str_read_lines(*linebuffer, *file)
+//  - ac_str_read_lines_buffered(*file)
+//  - ac_str_lines_free(*lines)
+//  - ac_str_split_lines_into(*lines, slice)
+//  - ac_line_reader_from_fd(fd)
+//  - ac_line_reader_from_file(*file)
+//  - ac_line_reader_next(*reader)
+//  - ac_line_reader_free(*reader)
+//  - ac_str_map_file(*path, advice)
+//  - ac_str_unmap_file(*slice)
 //
 //  - ac_str_trimmed_front(slice)
 //  - ac_str_trimmed_back(slice)
 //  - ac_str_trimmed(slice)
+//  - ac_str_trimmed_by(slice, *set)
+//
+//  - ac_str_find(haystack, needle)
+//  - ac_str_rfind(haystack, needle)
+//  - ac_str_find_all(haystack, needle)
+//  - ac_str_needle(needle)
+//  - ac_str_needle_find(*needle, haystack)
+//  - ac_str_needle_rfind(*needle, haystack)
+//  - ac_str_needle_find_all_into(*matches, *needle, haystack)
+//
+//  - ac_str_hash(slice, seed)
+//  - ac_str_hash_bytes(*bytes, len, seed)
+//  - ac_str_hasher(seed)
+//  - ac_str_hasher_update(*hasher, slice)
+//  - ac_str_hasher_finish(*hasher)
+//
+//  - ac_byteset_from(*chars)
+//  - ac_byteset_from_slice(slice)
+//  - ac_byteset_add(*set, ch)
+//  - ac_byteset_add_range(*set, first, last)
+//  - ac_byteset_invert(*set)
+//  - ac_byteset_contains(*set, ch)
+//  - ac_byteset_find(*set, slice)
+//  - ac_byteset_find_not(*set, slice)
+//  - ac_byteset_classify(*set, slice, *out)
+//
+//  - ac_multi_matcher_from(patterns, ignore_case)
+//  - ac_multi_matcher_is_match(*matcher, haystack)
+//  - ac_multi_matcher_find_all(*matcher, haystack)
+//  - ac_multi_matcher_find_all_into(*matches, *matcher, haystack)
+//  - ac_multi_matcher_free(*matcher)
+//
+//  - ac_str_interner_init(*interner)
+//  - ac_str_interner_intern(*interner, slice)
+//  - ac_str_interner_find(*interner, slice)
+//  - ac_str_interner_get(*interner, id)
+//  - ac_str_interner_free(*interner)
 //
 // USAGE:
 //  # DEFINING
@@ -605,7 +1548,17 @@ void* __aclib_clone_arr(void* ptr, size_t size);
 //  ac_vec_free(al);
 //  ```
 
-/// A string slice, which holds a cstr and a length
+#ifndef ACLIB_STR_GROWTH_FN
+/// The growth policy used by `ac_str_ensure_cap()`. Must be an `Ac_GrowthFn`
+#define ACLIB_STR_GROWTH_FN ac_growth_geometric
+#endif
+
+#ifndef ACLIB_LINE_READER_BUF_SIZE
+/// The starting size of an `Ac_LineReader`'s buffer. It only grows if a line doesn't fit in it
+#define ACLIB_LINE_READER_BUF_SIZE (64 * 1024)
+#endif
+
+/// A string slice, which holds a cstr and a length
 typedef struct Ac_StrSlice
 {
     /// The characters of the string slice. Can be used as a cstr
@@ -632,6 +1585,9 @@ typedef struct Ac_String
     };
     /// The capacity of the string
     size_t cap;
+    /// The allocator the string allocates from. If NULL, it is set to `ac_allocator_current()` on
+    /// the first allocation
+    const Ac_Allocator* allocator;
 } Ac_String;
 
 
@@ -646,6 +1602,247 @@ typedef struct Ac_String
 /// `vec_free` will not do this for you.
 typedef Ac_VecDef(Ac_StrSlice) Ac_StrVec;
 
+/// A vector of sizes or indices, e.g. the positions returned by `ac_str_find_all()`
+typedef Ac_VecDef(size_t) Ac_SizeVec;
+
+/// A needle precompiled for repeated substring searches. Create it with `ac_str_needle()`. It
+/// borrows the needle's chars, so they must outlive it
+typedef struct Ac_StrNeedle
+{
+    /// The substring to search for
+    Ac_StrSlice needle;
+    /// The length of the left half of the needle's critical factorization, used by Two-Way
+    size_t crit;
+    /// The period of the right half of the needle, used by Two-Way
+    size_t period;
+    /// Whether the whole needle repeats with the period, which changes how far Two-Way can shift
+    bool periodic;
+    /// The critical factorization of the reversed needle, used for reverse searches
+    size_t rev_crit;
+    /// The period of the reversed needle
+    size_t rev_period;
+    /// Whether the reversed needle repeats with its period
+    bool rev_periodic;
+} Ac_StrNeedle;
+
+/// The state of a hash that is computed over several chunks, which gives the same hash as
+/// `ac_str_hash()` over all of the chunks at once. Create it with `ac_str_hasher()`
+typedef struct Ac_StrHasher
+{
+    /// The accumulators of the stripes hashed so far
+    uint64_t acc[8];
+    /// The bytes that aren't hashed yet, as the end of the input is hashed differently
+    uint8_t buffer[256];
+    /// The amount of bytes in the buffer
+    size_t buffered;
+    /// The amount of stripes hashed since the accumulators were last scrambled
+    size_t block_pos;
+    /// The amount of bytes given to the hasher
+    uint64_t len;
+    /// The seed of the hash
+    uint64_t seed;
+} Ac_StrHasher;
+
+/// The lines of a file, read into a single buffer. Create it with `ac_str_read_lines_buffered()`,
+/// and free it with `ac_str_lines_free()`
+typedef struct Ac_StrLines
+{
+    /// The contents of the file, with every '\n' replaced by '\0'
+    Ac_String buffer;
+    /// The lines of the file. They point into the buffer, and are '\0' terminated
+    Ac_StrVec lines;
+} Ac_StrLines;
+
+/// An option holding a string slice
+typedef Ac_OptDef(Ac_StrSlice) Ac_StrSliceOpt;
+
+/// A streaming line reader over a file descriptor or a `FILE*`. It reads through a single buffer
+/// that is reused for every line, so memory stays flat no matter how big the input is.
+/// Create it with `ac_line_reader_from_fd()` or `ac_line_reader_from_file()`, and free it with
+/// `ac_line_reader_free()`
+typedef struct Ac_LineReader
+{
+    /// The file descriptor to read from. Only used if file is NULL
+    int fd;
+    /// The file to read from
+    FILE* file;
+    /// The buffer holding the read, but not yet returned, bytes
+    Ac_String buffer;
+    /// The index of the first byte in the buffer, that hasn't been returned yet
+    size_t pos;
+    /// The index in the buffer to continue searching for a '\n' from
+    size_t scanned;
+    /// Whether the end of the input has been reached
+    bool eof;
+    /// The errno value of the read that made the last `ac_line_reader_next()` call return none,
+    /// or 0 if it returned none because the input ended
+    int error;
+} Ac_LineReader;
+
+/// A result holding a string slice, or an errno value
+typedef Ac_ResDef(Ac_StrSlice, int) Ac_StrSliceRes;
+
+/// A signed integer parsed from the start of a slice
+typedef struct Ac_ParsedI64
+{
+    int64_t value;
+    /// The number of chars the integer was parsed from
+    size_t consumed;
+} Ac_ParsedI64;
+
+/// An unsigned integer parsed from the start of a slice
+typedef struct Ac_ParsedU64
+{
+    uint64_t value;
+    /// The number of chars the integer was parsed from
+    size_t consumed;
+} Ac_ParsedU64;
+
+/// A double parsed from the start of a slice
+typedef struct Ac_ParsedF64
+{
+    double value;
+    /// The number of chars the double was parsed from
+    size_t consumed;
+} Ac_ParsedF64;
+
+/// A result holding a parsed signed integer, or an errno value
+typedef Ac_ResDef(Ac_ParsedI64, int) Ac_ParsedI64Res;
+/// A result holding a parsed unsigned integer, or an errno value
+typedef Ac_ResDef(Ac_ParsedU64, int) Ac_ParsedU64Res;
+/// A result holding a parsed double, or an errno value
+typedef Ac_ResDef(Ac_ParsedF64, int) Ac_ParsedF64Res;
+
+/// Hints for how a file mapped with `ac_str_map_file()` will be accessed. Can be or'ed together
+typedef enum Ac_MapAdvice
+{
+    /// No hints
+    AC_MAP_NORMAL = 0,
+    /// The file will be read from start to end, so the kernel can read ahead aggressively
+    AC_MAP_SEQUENTIAL = 1 << 0,
+    /// The file will be read in a random order, so reading ahead is wasted
+    AC_MAP_RANDOM = 1 << 1,
+    /// The whole file will be needed soon, so the kernel can start reading it right away
+    AC_MAP_WILLNEED = 1 << 2,
+    /// Back the mapping with huge pages where the kernel supports it
+    AC_MAP_HUGEPAGE = 1 << 3,
+} Ac_MapAdvice;
+
+/// A set of bytes, stored as a 256-bit bitmap. Build it once with `ac_byteset_from()`, and reuse it
+/// for finding, splitting and trimming by the bytes in it
+typedef struct Ac_ByteSet
+{
+    /// A bit for every byte value
+    uint64_t bits[4];
+    /// The set as two lookup tables, for bytes below and above 0x80, indexed by the low nibble of a
+    /// byte. Each entry holds a bit for every high nibble. Used by the vectorized lookups
+    uint8_t nibbles[2][16];
+} Ac_ByteSet;
+
+/// The kind of delimeter an `Ac_StrSplitIter` splits by
+typedef enum Ac_StrSplitKind
+{
+    /// Split by a single char
+    AC_SPLIT_CHAR,
+    /// Split by any byte in an `Ac_ByteSet`
+    AC_SPLIT_SET,
+    /// Split by a substring
+    AC_SPLIT_SUBSTR,
+} Ac_StrSplitKind;
+
+/// A lazy iterator over the parts of a string slice. It never allocates, and the parts point into
+/// the original slice. Create it with `ac_str_split_iter()`, `ac_str_split_iter_many()` or
+/// `ac_str_split_iter_substr()`, and get the parts with `ac_str_split_iter_next()`
+typedef struct Ac_StrSplitIter
+{
+    /// The part of the slice that has not been visited yet
+    Ac_StrSlice rest;
+    /// The kind of delimeter to split by
+    Ac_StrSplitKind kind;
+    /// The delimeter to split by, depending on `kind`
+    union
+    {
+        char delim;
+        Ac_ByteSet set;
+        Ac_StrSlice needle;
+    };
+    /// The amount of splits left before the rest is returned as the last part. SIZE_MAX if there
+    /// is no limit
+    size_t splits_left;
+    /// Whether the last part has been returned
+    bool done;
+} Ac_StrSplitIter;
+
+/// A match of one of the patterns of an `Ac_MultiMatcher`
+typedef struct Ac_MultiMatch
+{
+    /// The index of the matched pattern in the vector the matcher was compiled from
+    size_t pattern;
+    /// The index of the first byte of the match
+    size_t start;
+    /// The length of the match
+    size_t len;
+} Ac_MultiMatch;
+
+/// A vector of matches, e.g. the matches returned by `ac_multi_matcher_find_all()`
+typedef Ac_VecDef(Ac_MultiMatch) Ac_MultiMatchVec;
+
+/// A set of patterns compiled into an Aho-Corasick DFA, which finds every occurrence of every
+/// pattern in a single pass over a string slice. Create it with `ac_multi_matcher_from()`, and free
+/// it with `ac_multi_matcher_free()`
+typedef struct Ac_MultiMatcher
+{
+    /// The class of each byte. Bytes that are in no pattern share class 0, and when ignoring case,
+    /// both cases of a letter share a class
+    uint16_t classes[256];
+    /// The amount of byte classes, which is the width of each row in the transition table
+    size_t class_count;
+    /// The transition table, with a dense row for each state. The state after reading byte b in
+    /// state s is `transitions.items[s * class_count + classes[b]]`. State 0 is the root
+    Ac_VecDef(uint32_t) transitions;
+    /// For each state, the nearest state a pattern ends in, following the failure links from the
+    /// state itself. UINT32_MAX if there is none
+    Ac_VecDef(uint32_t) output_links;
+    /// For each state a pattern ends in, the next such state along its failure links, or UINT32_MAX
+    Ac_VecDef(uint32_t) next_outputs;
+    /// For each state, the index of the pattern ending in it, or UINT32_MAX
+    Ac_VecDef(uint32_t) outputs;
+    /// The length of each pattern
+    Ac_SizeVec pattern_lens;
+    /// Whether ASCII letters match regardless of case
+    bool ignore_case;
+} Ac_MultiMatcher;
+
+/// A string stored in an `Ac_StrInterner`
+typedef struct Ac_InternedStr
+{
+    /// The id of the string. Equal strings in an interner have equal ids, and the ids count up
+    /// from 0 in the order the strings were first interned
+    uint32_t id;
+    /// The string, stored in the interner. It is '\0' terminated, and stays valid until the
+    /// interner is freed
+    Ac_StrSlice str;
+} Ac_InternedStr;
+
+/// Define the option for an `Ac_InternedStr`
+typedef Ac_OptDef(Ac_InternedStr) Ac_InternedStrOpt;
+
+/// A table which stores each unique string once, and gives it a small id. Comparing the ids is
+/// then the same as comparing the strings. Lookups can run from several threads at once, while
+/// interning new strings takes an exclusive lock. Initialize it with `ac_str_interner_init()`,
+/// and free it with `ac_str_interner_free()`
+typedef struct Ac_StrInterner
+{
+    /// The storage of the interned strings
+    Ac_Arena arena;
+    /// The id of each interned string
+    Ac_MapDef(Ac_StrSlice, uint32_t) ids;
+    /// The interned strings, indexed by their id
+    Ac_StrVec strings;
+    /// Held for reading during lookups, and for writing while interning new strings
+    pthread_rwlock_t lock;
+} Ac_StrInterner;
+
 /// Allocate a new empty string slice with a specific length. The caller is responsible for freeing
 /// the memory with `ac_slice_free()`
 ACLIBDEF Ac_StrSlice ac_str_slice_with_len(size_t len);
@@ -669,6 +1866,22 @@ ACLIBDEF Ac_StrSlice ac_str_slice_range(Ac_String str, size_t start, size_t end)
 /// characters
 ACLIBDEF void ac_str_slice_free(Ac_StrSlice* slice);
 
+/// Allocate a new empty string slice with a specific length from an arena. The memory is owned by
+/// the arena. If arena is NULL, this behaves like `ac_str_slice_with_len()`
+ACLIBDEF Ac_StrSlice ac_arena_str_slice_with_len(Ac_Arena* arena, size_t len);
+
+/// Clone a string slice and its chars into an arena. The memory is owned by the arena. If arena is
+/// NULL, this behaves like `ac_str_slice_clone()`
+ACLIBDEF Ac_StrSlice ac_arena_str_slice_clone(Ac_Arena* arena, Ac_StrSlice slice);
+
+/// Clone a string slice and its chars with a given allocator. If allocator is NULL, this behaves
+/// like `ac_str_slice_clone()`. The caller is responsible for freeing the slice with
+/// `ac_str_slice_free_in()`
+ACLIBDEF Ac_StrSlice ac_str_slice_clone_in(const Ac_Allocator* allocator, Ac_StrSlice slice);
+
+/// Free a string slice, that was allocated with the given allocator
+ACLIBDEF void ac_str_slice_free_in(const Ac_Allocator* allocator, Ac_StrSlice* slice);
+
 /// Allocates a new string with a specific capacity. The caller is responsible for freeing the
 /// string with `ac_str_free()`
 ACLIBDEF Ac_String ac_str_with_capacity(size_t capacity);
@@ -686,6 +1899,9 @@ ACLIBDEF void ac_str_unshift(Ac_String* str, char ch);
 /// Append a cstr unto the end of a string
 ACLIBDEF void ac_str_append(Ac_String* str, char* chs);
 
+/// Append a string slice unto the end of a string
+ACLIBDEF void ac_str_append_slice(Ac_String* str, Ac_StrSlice slice);
+
 /// Append a formatted cstr unto the end of a string
 ACLIBDEF void ac_str_appendf(Ac_String* str, const char* fmt, ...);
 
@@ -695,6 +1911,62 @@ ACLIBDEF void ac_str_prepend(Ac_String* str, char* chs);
 /// Prepend a formatted cstr to the front of a string
 ACLIBDEF void ac_str_prependf(Ac_String* str, const char* fmt, ...);
 
+/// Append a signed integer in decimal unto the end of a string, e.g. "-42"
+ACLIBDEF void ac_str_append_i64(Ac_String* str, int64_t value);
+
+/// Append an unsigned integer in decimal unto the end of a string, e.g. "42"
+ACLIBDEF void ac_str_append_u64(Ac_String* str, uint64_t value);
+
+/// Append an unsigned integer in lowercase hex, without a prefix, unto the end of a string,
+/// e.g. "2a"
+ACLIBDEF void ac_str_append_u64_hex(Ac_String* str, uint64_t value);
+
+/// Append a double unto the end of a string, with the fewest digits that parse back to the same
+/// double, e.g. "0.1", "-1.5e+300" and "3". Infinities and NaN are written as "inf", "-inf" and
+/// "nan"
+ACLIBDEF void ac_str_append_f64(Ac_String* str, double value);
+
+/// Append a signed integer in decimal, left padded with pad to atleast width chars.
+/// With a '0' pad the sign is written before the padding, e.g. "-0042", like printf's "%05d"
+ACLIBDEF void ac_str_append_i64_padded(Ac_String* str, int64_t value, size_t width, char pad);
+
+/// Append an unsigned integer in decimal, left padded with pad to atleast width chars
+ACLIBDEF void ac_str_append_u64_padded(Ac_String* str, uint64_t value, size_t width, char pad);
+
+/// Append an unsigned integer in lowercase hex, left padded with pad to atleast width chars
+ACLIBDEF void ac_str_append_u64_hex_padded(Ac_String* str, uint64_t value, size_t width,
+                                           char pad);
+
+/// Parse a decimal signed integer, with an optional '+' or '-', from the start of a slice.
+/// Parsing stops at the first char that isn't a digit, and whitespace isn't skipped, so check that
+/// `consumed` is the slice's length to parse a whole field.
+/// Errors with EINVAL if the slice doesn't start with a number, and ERANGE if it doesn't fit
+ACLIBDEF Ac_ParsedI64Res ac_str_parse_i64(Ac_StrSlice slice);
+
+/// Parse a decimal unsigned integer, with an optional '+', from the start of a slice.
+/// Errors with EINVAL if the slice doesn't start with a number, and ERANGE if it doesn't fit
+ACLIBDEF Ac_ParsedU64Res ac_str_parse_u64(Ac_StrSlice slice);
+
+/// Parse a double from the start of a slice, like `strtod()` does for decimal numbers, e.g. "-12",
+/// ".5", "1.25e-3", "inf" and "nan". The result is correctly rounded, and unlike `strtod()` it
+/// doesn't depend on the locale and never allocates.
+/// Errors with EINVAL if the slice doesn't start with a number, and ERANGE if it's too large for a
+/// double
+ACLIBDEF Ac_ParsedF64Res ac_str_parse_f64(Ac_StrSlice slice);
+
+/// Checks if a slice is valid UTF-8, i.e. has no truncated, overlong or surrogate sequences, and
+/// no code points past U+10FFFF
+ACLIBDEF bool ac_str_utf8_validate(Ac_StrSlice slice);
+
+/// Count the code points in a UTF-8 slice. Only the bytes that start a code point are counted, so
+/// validate the slice first if it might not be UTF-8
+ACLIBDEF size_t ac_str_utf8_count(Ac_StrSlice slice);
+
+/// Make a slice of the bytes from start to end of a UTF-8 slice, like `ac_str_slice_range()`, but
+/// with both ends moved back to the start of the code point they are in. Ranges that meet in the
+/// middle of a code point still meet after that, so no code point is split or lost
+ACLIBDEF Ac_StrSlice ac_str_utf8_slice_range(Ac_StrSlice slice, size_t start, size_t end);
+
 /// Pop and return the last char of a string.
 /// This asserts that the string has a char that can be popped
 ACLIBDEF char ac_str_pop(Ac_String* str);
@@ -735,12 +2007,18 @@ ACLIBDEF void ac_str_remove_range(Ac_String* str, size_t start, size_t end);
 /// Empty the given string. This does not free or remove any memory
 ACLIBDEF void ac_str_empty(Ac_String* str);
 
-/// Free the given vector and its contents
+/// Free the given string and its contents, with the string's allocator
 ACLIBDEF void ac_str_free(Ac_String* str);
 
-/// Ensure that a string has atleast the given capacity.
+/// Ensure that a string has atleast the given capacity, growing it with `ACLIB_STR_GROWTH_FN`.
 ACLIBDEF void ac_str_ensure_cap(Ac_String* str, size_t new_cap);
 
+/// Ensure that a string has atleast the given capacity, without allocating any more than that
+ACLIBDEF void ac_str_reserve_exact(Ac_String* str, size_t new_cap);
+
+/// Shrink the capacity of a string down to its length
+ACLIBDEF void ac_str_shrink_to_fit(Ac_String* str);
+
 /// Trim all whitespace from the front of a string
 ACLIBDEF void ac_str_trim_front(Ac_String* str);
 
@@ -750,7 +2028,10 @@ ACLIBDEF void ac_str_trim_back(Ac_String* str);
 /// Trim all whitespace from the front and back of a string
 ACLIBDEF void ac_str_trim(Ac_String* str);
 
-/// Split a string by a delimeter
+/// Split a string by a delimeter.
+/// The parts and the returned vector are allocated with the string's allocator, so free them with
+/// `ac_str_parts_free()`, which frees through the vector's allocator. The same goes for the other
+/// owning split functions
 ACLIBDEF Ac_StrVec ac_str_split_by(Ac_String str, char delim);
 
 /// Split a string by a set of delimeters
@@ -762,12 +2043,124 @@ ACLIBDEF Ac_StrVec ac_str_split_by_once(Ac_String str, char delim);
 /// Split a string at an index
 ACLIBDEF Ac_StrVec ac_str_split_at(Ac_String str, size_t idx);
 
-/// Reads a file into a string buffer, and returns the amount of bytes read.
+/// Free the parts returned by an owning split function, and the vector holding them. Both are
+/// freed with the vector's allocator, which is the allocator of the string that was split
+ACLIBDEF void ac_str_parts_free(Ac_StrVec* parts);
+
+/// Split a string slice by a delimeter, without allocating or copying any chars. The parts point
+/// into the original slice, and are not '\0' terminated.
+/// The caller is responsible for freeing the returned vector with `ac_vec_free()`
+ACLIBDEF Ac_StrVec ac_str_split_by_borrowed(Ac_StrSlice slice, char delim);
+
+/// Split a string slice by a set of delimeters, without allocating or copying any chars. The
+/// parts point into the original slice, and are not '\0' terminated.
+/// The caller is responsible for freeing the returned vector with `ac_vec_free()`
+ACLIBDEF Ac_StrVec ac_str_split_by_many_borrowed(Ac_StrSlice slice, char* delims);
+
+/// Split a string slice by a delimeter once, without allocating or copying any chars. The parts
+/// point into the original slice, and are not '\0' terminated.
+/// The caller is responsible for freeing the returned vector with `ac_vec_free()`
+ACLIBDEF Ac_StrVec ac_str_split_by_once_borrowed(Ac_StrSlice slice, char delim);
+
+/// Split a string slice at an index, without allocating or copying any chars. The parts point
+/// into the original slice, and are not '\0' terminated.
+/// The caller is responsible for freeing the returned vector with `ac_vec_free()`
+ACLIBDEF Ac_StrVec ac_str_split_at_borrowed(Ac_StrSlice slice, size_t idx);
+
+/// Split a string slice by a delimeter, and push the borrowed parts unto the end of a vector.
+/// Empty the vector with `ac_vec_empty()` to reuse its memory across calls
+ACLIBDEF void ac_str_split_by_into(Ac_StrVec* parts, Ac_StrSlice slice, char delim);
+
+/// Split a string slice by a set of delimeters, and push the borrowed parts unto the end of a
+/// vector
+ACLIBDEF void ac_str_split_by_many_into(Ac_StrVec* parts, Ac_StrSlice slice, char* delims);
+
+/// Split a string slice by a delimeter once, and push the borrowed parts unto the end of a vector
+ACLIBDEF void ac_str_split_by_once_into(Ac_StrVec* parts, Ac_StrSlice slice, char delim);
+
+/// Split a string slice at an index, and push the borrowed parts unto the end of a vector
+ACLIBDEF void ac_str_split_at_into(Ac_StrVec* parts, Ac_StrSlice slice, size_t idx);
+
+/// Split a string slice by any of the bytes in a byte set, without allocating or copying any chars.
+/// The caller is responsible for freeing the returned vector with `ac_vec_free()`
+ACLIBDEF Ac_StrVec ac_str_split_by_set_borrowed(Ac_StrSlice slice, const Ac_ByteSet* set);
+
+/// Split a string slice by any of the bytes in a byte set, and push the borrowed parts unto the end
+/// of a vector
+ACLIBDEF void ac_str_split_by_set_into(Ac_StrVec* parts, Ac_StrSlice slice, const Ac_ByteSet* set);
+
+/// Create an iterator that lazily splits a string slice by a delimeter
+ACLIBDEF Ac_StrSplitIter ac_str_split_iter(Ac_StrSlice slice, char delim);
+
+/// Create an iterator that lazily splits a string slice by any of the chars in delims
+ACLIBDEF Ac_StrSplitIter ac_str_split_iter_many(Ac_StrSlice slice, char* delims);
+
+/// Create an iterator that lazily splits a string slice by any of the bytes in a byte set
+ACLIBDEF Ac_StrSplitIter ac_str_split_iter_set(Ac_StrSlice slice, const Ac_ByteSet* set);
+
+/// Create an iterator that lazily splits a string slice by a substring. The needle must outlive
+/// the iterator. An empty needle never splits
+ACLIBDEF Ac_StrSplitIter ac_str_split_iter_substr(Ac_StrSlice slice, Ac_StrSlice needle);
+
+/// Limit an iterator to at most max_splits splits, making it yield at most max_splits + 1 parts.
+/// The last part holds the rest of the slice
+#define ac_str_split_iter_limit(iter, max_splits) (iter)->splits_left = (max_splits)
+
+/// Get the next part of a split iterator, or none when all parts have been visited. The part
+/// points into the original slice, and is not '\0' terminated
+ACLIBDEF Ac_StrSliceOpt ac_str_split_iter_next(Ac_StrSplitIter* iter);
+
+/// Reads the rest of a file unto the end of a string buffer, and returns the amount of bytes read.
+/// Regular files are sized with fstat and read in a single call, other streams are read in chunks.
+/// Embedded '\0' bytes are kept
 ACLIBDEF size_t ac_str_read_file(Ac_String* buffer, FILE* file);
 
 /// Reads all the lines in a file into a line buffer, and returns the amount of bytes read.
+/// The lines are allocated with the line buffer's allocator. Returns 0 without reading anything, if
+/// the read buffer can't be allocated
 ACLIBDEF size_t ac_str_read_lines(Ac_StrVec* linebuffer, FILE* file);
 
+/// Reads the rest of a file into a single buffer, and splits it into lines pointing into it. This
+/// only allocates the buffer and the vector of lines, no matter how many lines there are.
+/// The caller is responsible for freeing the lines with `ac_str_lines_free()`
+ACLIBDEF Ac_StrLines ac_str_read_lines_buffered(FILE* file);
+
+/// Free the buffer and the vector of lines read with `ac_str_read_lines_buffered()`
+ACLIBDEF void ac_str_lines_free(Ac_StrLines* lines);
+
+/// Split a string slice into lines, and push the borrowed lines unto the end of a vector. A
+/// trailing '\n' does not start a new line. Works on any slice, e.g. one from `ac_str_map_file()`
+ACLIBDEF void ac_str_split_lines_into(Ac_StrVec* lines, Ac_StrSlice slice);
+
+/// Create a line reader reading from a file descriptor. The reader does not take ownership of it
+ACLIBDEF Ac_LineReader ac_line_reader_from_fd(int fd);
+
+/// Create a line reader reading from a file. The reader does not take ownership of it. Reads from
+/// a file wait until the buffer is filled or the file ends, so use `ac_line_reader_from_fd()` for
+/// interactive input
+ACLIBDEF Ac_LineReader ac_line_reader_from_file(FILE* file);
+
+/// Read the next line, or get none at the end of the input or when a read fails. The line does not
+/// include the '\n', and is '\0' terminated. It points into the reader's buffer, and is only valid
+/// until the next call.
+/// When none is returned, the reader's error is set to the errno value of the failed read, or 0 at
+/// the end of the input. A failed read doesn't lose any bytes, so after e.g. EAGAIN from a
+/// non-blocking fd, the next call picks up where the reader left off
+ACLIBDEF Ac_StrSliceOpt ac_line_reader_next(Ac_LineReader* reader);
+
+/// Free the buffer of a line reader, and reset its state, so it reads its fd or file afresh
+ACLIBDEF void ac_line_reader_free(Ac_LineReader* reader);
+
+/// Map a file into memory as read-only, and get a slice over its contents without copying them.
+/// advice is zero or more `Ac_MapAdvice` flags or'ed together. The slice is *not* '\0' terminated.
+/// On failure the errno value is returned as the error. Only regular files can be mapped, anything
+/// else (pipes, devices, /proc entries) fails with EINVAL, so read those with `ac_str_read_file()`.
+/// The caller is responsible for unmapping the file with `ac_str_unmap_file()`
+ACLIBDEF Ac_StrSliceRes ac_str_map_file(const char* path, int advice);
+
+/// Unmap a file mapped with `ac_str_map_file()`
+ACLIBDEF void ac_str_unmap_file(Ac_StrSlice* slice);
+
 /// Trim the front of a string slice, without allocating or copying any bytes. The returned slice is
 /// just a pointer to the original slice.
 ACLIBDEF Ac_StrSlice ac_str_trimmed_front(Ac_StrSlice slice);
@@ -776,14 +2169,276 @@ ACLIBDEF Ac_StrSlice ac_str_trimmed_front(Ac_StrSlice slice);
 /// just a pointer to the original slice.
 ACLIBDEF Ac_StrSlice ac_str_trimmed_back(Ac_StrSlice slice);
 
+/// Trim the bytes in a byte set from both ends of a string slice, without allocating or copying
+/// any bytes. The returned slice is just a pointer to the original slice.
+ACLIBDEF Ac_StrSlice ac_str_trimmed_by(Ac_StrSlice slice, const Ac_ByteSet* set);
+
 /// Trim a string slice, without allocating or copying any bytes. The returned slice is just a
 /// pointer to the original slice.
 ACLIBDEF Ac_StrSlice ac_str_trimmed(Ac_StrSlice slice);
 
+/// Find the index of the first occurrence of a needle in a string slice
+ACLIBDEF Ac_SizeOpt ac_str_find(Ac_StrSlice haystack, Ac_StrSlice needle);
+
+/// Find the index of the last occurrence of a needle in a string slice
+ACLIBDEF Ac_SizeOpt ac_str_rfind(Ac_StrSlice haystack, Ac_StrSlice needle);
+
+/// Find the indices of every non-overlapping occurrence of a needle in a string slice.
+/// The caller is responsible for freeing the returned vector with `ac_vec_free()`
+ACLIBDEF Ac_SizeVec ac_str_find_all(Ac_StrSlice haystack, Ac_StrSlice needle);
+
+/// Precompile a needle for repeated searches with `ac_str_needle_find()`, `ac_str_needle_rfind()`
+/// and `ac_str_needle_find_all_into()`. Searches take linear time, no matter the input
+ACLIBDEF Ac_StrNeedle ac_str_needle(Ac_StrSlice needle);
+
+/// Find the index of the first occurrence of a precompiled needle in a string slice
+ACLIBDEF Ac_SizeOpt ac_str_needle_find(const Ac_StrNeedle* needle, Ac_StrSlice haystack);
+
+/// Find the index of the last occurrence of a precompiled needle in a string slice
+ACLIBDEF Ac_SizeOpt ac_str_needle_rfind(const Ac_StrNeedle* needle, Ac_StrSlice haystack);
+
+/// Push the indices of every non-overlapping occurrence of a precompiled needle in a string slice
+/// unto the end of a vector
+ACLIBDEF void ac_str_needle_find_all_into(Ac_SizeVec* matches, const Ac_StrNeedle* needle,
+                                          Ac_StrSlice haystack);
+
+/// Hash a string slice into 64 bits. Different seeds give unrelated hashes, which is useful for
+/// e.g. randomizing hash maps. The hash is fast and well distributed, but not cryptographic, and
+/// it may differ between platforms of different endianness
+ACLIBDEF uint64_t ac_str_hash(Ac_StrSlice slice, uint64_t seed);
+
+/// Hash a range of bytes into 64 bits, the same way as `ac_str_hash()`
+ACLIBDEF uint64_t ac_str_hash_bytes(const void* bytes, size_t len, uint64_t seed);
+
+/// Create a hasher, for hashing data that arrives in chunks
+ACLIBDEF Ac_StrHasher ac_str_hasher(uint64_t seed);
+
+/// Add the next chunk of data to a hasher
+ACLIBDEF void ac_str_hasher_update(Ac_StrHasher* hasher, Ac_StrSlice slice);
+
+/// Get the hash of all the data added to a hasher so far. The hasher can still be updated after
+ACLIBDEF uint64_t ac_str_hasher_finish(const Ac_StrHasher* hasher);
+
+/// Create a byte set holding every char in a cstr
+ACLIBDEF Ac_ByteSet ac_byteset_from(const char* chars);
+
+/// Create a byte set holding every byte in a string slice
+ACLIBDEF Ac_ByteSet ac_byteset_from_slice(Ac_StrSlice slice);
+
+/// Add a byte to a byte set
+ACLIBDEF void ac_byteset_add(Ac_ByteSet* set, char ch);
+
+/// Add every byte from first to last, inclusive, to a byte set
+ACLIBDEF void ac_byteset_add_range(Ac_ByteSet* set, char first, char last);
+
+/// Invert a byte set, so it holds every byte it didn't hold before
+ACLIBDEF void ac_byteset_invert(Ac_ByteSet* set);
+
+/// Check if a byte set holds a byte
+#define ac_byteset_contains(set, ch) \
+    (bool)(((set)->bits[(unsigned char)(ch) >> 6] >> ((unsigned char)(ch) & 63)) & 1)
+
+/// Find the index of the first byte in a slice that is in the set, or the slice's length if there
+/// are none
+ACLIBDEF size_t ac_byteset_find(const Ac_ByteSet* set, Ac_StrSlice slice);
+
+/// Find the index of the first byte in a slice that is not in the set, or the slice's length if
+/// there are none
+ACLIBDEF size_t ac_byteset_find_not(const Ac_ByteSet* set, Ac_StrSlice slice);
+
+/// Check every byte in a slice against a byte set, and write the results to out, which must have
+/// room for `slice.len` bools
+ACLIBDEF void ac_byteset_classify(const Ac_ByteSet* set, Ac_StrSlice slice, bool* out);
+
+/// Compile a set of patterns into a matcher, which finds all of them in a single pass. The patterns
+/// are copied into the matcher's tables, so they don't have to outlive it. Empty patterns never
+/// match, and a pattern given more than once is only reported with its first index.
+/// If ignore_case is true, ASCII letters match regardless of case, like `ac_ascii_to_lowercase()`.
+/// The caller is responsible for freeing the matcher with `ac_multi_matcher_free()`
+ACLIBDEF Ac_MultiMatcher ac_multi_matcher_from(Ac_StrVec patterns, bool ignore_case);
+
+/// Check whether any of a matcher's patterns occur in a string slice, stopping at the first match
+ACLIBDEF bool ac_multi_matcher_is_match(const Ac_MultiMatcher* matcher, Ac_StrSlice haystack);
+
+/// Find every occurrence of a matcher's patterns in a string slice, including overlapping ones.
+/// The matches are ordered by where they end, and matches ending at the same byte are ordered from
+/// longest to shortest.
+/// The caller is responsible for freeing the returned vector with `ac_vec_free()`
+ACLIBDEF Ac_MultiMatchVec ac_multi_matcher_find_all(const Ac_MultiMatcher* matcher,
+                                                    Ac_StrSlice haystack);
+
+/// Push every occurrence of a matcher's patterns in a string slice unto the end of a vector, in the
+/// same order as `ac_multi_matcher_find_all()`
+ACLIBDEF void ac_multi_matcher_find_all_into(Ac_MultiMatchVec* matches,
+                                             const Ac_MultiMatcher* matcher, Ac_StrSlice haystack);
+
+/// Free a matcher and its tables
+ACLIBDEF void ac_multi_matcher_free(Ac_MultiMatcher* matcher);
+
+/// Initialize an empty interner
+ACLIBDEF void ac_str_interner_init(Ac_StrInterner* interner);
+
+/// Get the interned copy of a string slice, copying it into the interner if it isn't in it yet
+ACLIBDEF Ac_InternedStr ac_str_interner_intern(Ac_StrInterner* interner, Ac_StrSlice slice);
+
+/// Get the interned copy of a string slice. Returns with AC_OPT_NONE if it hasn't been interned
+ACLIBDEF Ac_InternedStrOpt ac_str_interner_find(Ac_StrInterner* interner, Ac_StrSlice slice);
+
+/// Get the string of an id. This asserts that the id was given out by the interner
+ACLIBDEF Ac_StrSlice ac_str_interner_get(Ac_StrInterner* interner, uint32_t id);
+
+/// Free an interner, along with every string in it
+ACLIBDEF void ac_str_interner_free(Ac_StrInterner* interner);
+
 /* END OF STRING DECL */
 
 
 
+/*                *
+ *  SMALL STRING  *
+ *                */
+// CONFIG DEFINES:
+//  -
+//
+// CONST DEFINES:
+//  - AC_SSO_CAP
+//  - AC_SSO_ARG
+//
+// TYPES AND TYPE MACROS:
+//  - Ac_SsoString
+//
+// FUNCTIONS AND MACROS:
+//  - ac_sso_is_inline(*str)
+//  - ac_sso_chars(*str)
+//  - ac_sso_len(*str)
+//  - ac_sso_cap(*str)
+//  - ac_sso_slice(*str)
+//  - ac_sso_from(*chs)
+//  - ac_sso_from_slice(slice)
+//  - ac_sso_push(*str, ch)
+//  - ac_sso_append(*str, *chs)
+//  - ac_sso_append_slice(*str, slice)
+//  - ac_sso_pop(*str)
+//  - ac_sso_empty(*str)
+//  - ac_sso_ensure_cap(*str, new_cap)
+//  - ac_sso_free(*str)
+//
+// USAGE:
+//  # INITIALIZING
+//  A small string can be zero initialized, which makes it an empty inline string
+//  ```c
+//  Ac_SsoString str = {0};
+//  ```
+//
+//  # USING
+//  Strings of up to `AC_SSO_CAP` chars are stored inside the struct itself. Only when a string
+//  grows past that, its contents are moved to the heap. Since the chars can live in either place,
+//  they must be accessed through `ac_sso_chars()` and `ac_sso_len()`
+//  ```c
+//  Ac_SsoString str = ac_sso_from("foo"); // -> no allocation
+//  printf(AC_STR_FMT "\n", AC_SSO_ARG(str));
+//  ```
+//
+//  # FREEING
+//  Remember to free the string after use with `ac_sso_free()`. Inline strings own no memory, but
+//  a string may have moved to the heap. The heap memory is allocated with the thread's allocator at
+//  the time it moves there, and that allocator is kept with the chars, so growing and freeing it
+//  later goes through the same allocator, even if the thread's allocator has changed since
+//  ```c
+//  ac_sso_free(&str);
+//  ```
+
+/// The max amount of chars a small string can hold, before it moves to the heap
+#define AC_SSO_CAP (3 * sizeof(size_t) - 2)
+
+/// A string, which stores short contents inline, and only allocates when it grows past
+/// `AC_SSO_CAP` chars
+typedef union Ac_SsoString
+{
+    /// The layout of a string that has moved to the heap
+    struct
+    {
+        char* chars;
+        size_t len;
+        /// The capacity, tagged with the heap flag. Use `ac_sso_cap()` to read it
+        size_t cap;
+    } heap;
+    /// The layout of an inline string
+    struct
+    {
+        char chars[AC_SSO_CAP + 1];
+        /// The length of the string. The high bit is set when the string is on the heap
+        unsigned char len;
+    } small;
+} Ac_SsoString;
+
+_Static_assert(sizeof(Ac_SsoString) == 3 * sizeof(size_t),
+               "Ac_SsoString must be as small as its heap layout");
+
+/// The arg used to print a small string with `AC_STR_FMT`
+#define AC_SSO_ARG(str) (int)ac_sso_len(&(str)), ac_sso_chars(&(str))
+
+// The heap flag lives in the last byte of the struct, which is the top byte of `heap.cap` on
+// little endian, and the bottom byte on big endian
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define __ACLIB_SSO_HEAP_CAP(cap) (((size_t)(cap) << 8) | 0x80)
+#define __ACLIB_SSO_CAP_OF(tagged) ((tagged) >> 8)
+#else
+#define __ACLIB_SSO_HEAP_CAP(cap) ((size_t)(cap) | ((size_t)0x80 << (8 * (sizeof(size_t) - 1))))
+#define __ACLIB_SSO_CAP_OF(tagged) ((tagged) & ~((size_t)0xFF << (8 * (sizeof(size_t) - 1))))
+#endif
+
+/// Check if a small string stores its chars inline
+#define ac_sso_is_inline(str) (!((str)->small.len & 0x80))
+
+/// Get the chars of a small string. Can be used as a cstr
+#define ac_sso_chars(str) (ac_sso_is_inline(str) ? (str)->small.chars : (str)->heap.chars)
+
+/// Get the length of a small string
+#define ac_sso_len(str) (ac_sso_is_inline(str) ? (size_t)(str)->small.len : (str)->heap.len)
+
+/// Get the capacity of a small string
+#define ac_sso_cap(str) \
+    (ac_sso_is_inline(str) ? (size_t)AC_SSO_CAP : __ACLIB_SSO_CAP_OF((str)->heap.cap))
+
+/// Get a slice to the contents of a small string. The slice is only valid as long as the string
+/// is not moved or modified
+#define ac_sso_slice(str) ((Ac_StrSlice){.chars = ac_sso_chars(str), .len = ac_sso_len(str)})
+
+/// Create a new small string from a cstr. This will clone the contents of the cstr.
+/// The caller is responsible for freeing the new string with `ac_sso_free()`
+ACLIBDEF Ac_SsoString ac_sso_from(char* chs);
+
+/// Create a new small string from a string slice. This will clone the contents of the slice.
+/// The caller is responsible for freeing the new string with `ac_sso_free()`
+ACLIBDEF Ac_SsoString ac_sso_from_slice(Ac_StrSlice slice);
+
+/// Push a char unto the end of a small string
+ACLIBDEF void ac_sso_push(Ac_SsoString* str, char ch);
+
+/// Append a cstr unto the end of a small string
+ACLIBDEF void ac_sso_append(Ac_SsoString* str, char* chs);
+
+/// Append a string slice unto the end of a small string
+ACLIBDEF void ac_sso_append_slice(Ac_SsoString* str, Ac_StrSlice slice);
+
+/// Pop and return the last char of a small string.
+/// This asserts that the string has a char that can be popped
+ACLIBDEF char ac_sso_pop(Ac_SsoString* str);
+
+/// Empty the given small string. This does not free or remove any memory
+ACLIBDEF void ac_sso_empty(Ac_SsoString* str);
+
+/// Ensure that a small string has atleast the given capacity, moving it to the heap if needed
+ACLIBDEF void ac_sso_ensure_cap(Ac_SsoString* str, size_t new_cap);
+
+/// Free a small string, and make it an empty inline string
+ACLIBDEF void ac_sso_free(Ac_SsoString* str);
+
+/* END OF SMALL STRING DECL */
+
+
+
 /*         *
  *  ASCII  *
  *         */
@@ -805,25 +2460,141 @@ ACLIBDEF Ac_StrSlice ac_str_trimmed(Ac_StrSlice slice);
 //  - ac_ascii_is_lowercase(ch)
 //  - ac_ascii_to_uppercase(ch)
 //  - ac_ascii_to_lowercase(ch)
+//  - ac_ascii_make_uppercase(slice)
+//  - ac_ascii_make_lowercase(slice)
+//  - ac_ascii_uppercased(slice)
+//  - ac_ascii_lowercased(slice)
+//  - ac_ascii_all_alphabetic(slice)
+//  - ac_ascii_all_numeric(slice)
+//  - ac_ascii_all_alphanumeric(slice)
+//  - ac_ascii_all_whitespace(slice)
+//  - ac_ascii_find_non_alphabetic(slice)
+//  - ac_ascii_find_non_numeric(slice)
+//  - ac_ascii_find_non_alphanumeric(slice)
+//  - ac_ascii_find_non_whitespace(slice)
 //
 // USAGE:
+// The slice functions work on many chars at a time, so prefer them over looping over the single
+// char functions. An Ac_String is converted in place with e.g. `ac_ascii_make_lowercase(str.slice)`
+
+/// The class bits of a char in `__aclib_ascii_classes`
+#define __ACLIB_ASCII_LOWER 0x01
+#define __ACLIB_ASCII_UPPER 0x02
+#define __ACLIB_ASCII_DIGIT 0x04
+#define __ACLIB_ASCII_SPACE 0x08
+#define __ACLIB_ASCII_LETTERS (__ACLIB_ASCII_LOWER | __ACLIB_ASCII_UPPER)
+
+#define __ACLIB_L __ACLIB_ASCII_LOWER
+#define __ACLIB_U __ACLIB_ASCII_UPPER
+#define __ACLIB_D __ACLIB_ASCII_DIGIT
+#define __ACLIB_S __ACLIB_ASCII_SPACE
+/// The class bits of every char, so classifying a char is a single load. Non-ascii chars have none
+static const uint8_t __aclib_ascii_classes[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, __ACLIB_S, __ACLIB_S, __ACLIB_S, __ACLIB_S, __ACLIB_S, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    __ACLIB_S, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    __ACLIB_D, __ACLIB_D, __ACLIB_D, __ACLIB_D, __ACLIB_D, __ACLIB_D, __ACLIB_D, __ACLIB_D,
+    __ACLIB_D, __ACLIB_D, 0, 0, 0, 0, 0, 0,
+    0, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U,
+    __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U,
+    __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U, __ACLIB_U,
+    __ACLIB_U, __ACLIB_U, __ACLIB_U, 0, 0, 0, 0, 0,
+    0, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L,
+    __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L,
+    __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L, __ACLIB_L,
+    __ACLIB_L, __ACLIB_L, __ACLIB_L, 0, 0, 0, 0, 0,
+};
+#undef __ACLIB_L
+#undef __ACLIB_U
+#undef __ACLIB_D
+#undef __ACLIB_S
+
+// The single char functions are defined in the header, so every translation unit can inline them
 
 /// Checks if an ascii char is alphabetic, i.e. [a-zA-Z]
-char ac_ascii_is_alphabetic(char ch);
+static inline char ac_ascii_is_alphabetic(char ch)
+{
+    return (__aclib_ascii_classes[(uint8_t)ch] & __ACLIB_ASCII_LETTERS) != 0;
+}
+
 /// Checks if an ascii char is numeric, i.e. [0-9]
-bool ac_ascii_is_numeric(char ch);
+static inline bool ac_ascii_is_numeric(char ch)
+{
+    return (__aclib_ascii_classes[(uint8_t)ch] & __ACLIB_ASCII_DIGIT) != 0;
+}
+
 /// Checks if an ascii char is alphanumeric, i.e. [a-zA-Z0-9]
-bool ac_ascii_is_alphanumeric(char ch);
+static inline bool ac_ascii_is_alphanumeric(char ch)
+{
+    uint8_t classes = __aclib_ascii_classes[(uint8_t)ch];
+    return (classes & (__ACLIB_ASCII_LETTERS | __ACLIB_ASCII_DIGIT)) != 0;
+}
+
 /// Checks if an ascii char is whitespace, e.g. '\n', '\t', ' '
-bool ac_ascii_is_whitespace(char ch);
+static inline bool ac_ascii_is_whitespace(char ch)
+{
+    return (__aclib_ascii_classes[(uint8_t)ch] & __ACLIB_ASCII_SPACE) != 0;
+}
+
 /// Checks if an ascii char is uppercase
-bool ac_ascii_is_uppercase(char ch);
+static inline bool ac_ascii_is_uppercase(char ch)
+{
+    return (__aclib_ascii_classes[(uint8_t)ch] & __ACLIB_ASCII_UPPER) != 0;
+}
+
 /// Checks if an ascii char is lowercase
-bool ac_ascii_is_lowercase(char ch);
+static inline bool ac_ascii_is_lowercase(char ch)
+{
+    return (__aclib_ascii_classes[(uint8_t)ch] & __ACLIB_ASCII_LOWER) != 0;
+}
+
 /// Returns the uppercase version of an ascii char
-char ac_ascii_to_uppercase(char ch);
+static inline char ac_ascii_to_uppercase(char ch)
+{
+    // Shift the lowercase bit up to 0x20, the bit that differs between e.g. 'b' and 'B'
+    return ch ^ ((__aclib_ascii_classes[(uint8_t)ch] & __ACLIB_ASCII_LOWER) << 5);
+}
+
 /// Returns the lowercase version of an ascii char
-char ac_ascii_to_lowercase(char ch);
+static inline char ac_ascii_to_lowercase(char ch)
+{
+    // Shift the uppercase bit up to 0x20, the bit that differs between e.g. 'B' and 'b'
+    return ch ^ ((__aclib_ascii_classes[(uint8_t)ch] & __ACLIB_ASCII_UPPER) << 4);
+}
+
+/// Converts every ascii letter in a slice to uppercase, in place
+ACLIBDEF void ac_ascii_make_uppercase(Ac_StrSlice slice);
+/// Converts every ascii letter in a slice to lowercase, in place
+ACLIBDEF void ac_ascii_make_lowercase(Ac_StrSlice slice);
+/// Returns a new string with the contents of a slice, with every ascii letter in uppercase
+ACLIBDEF Ac_String ac_ascii_uppercased(Ac_StrSlice slice);
+/// Returns a new string with the contents of a slice, with every ascii letter in lowercase
+ACLIBDEF Ac_String ac_ascii_lowercased(Ac_StrSlice slice);
+
+/// Checks if every char in a slice is alphabetic. An empty slice is all alphabetic
+ACLIBDEF bool ac_ascii_all_alphabetic(Ac_StrSlice slice);
+/// Checks if every char in a slice is numeric. An empty slice is all numeric
+ACLIBDEF bool ac_ascii_all_numeric(Ac_StrSlice slice);
+/// Checks if every char in a slice is alphanumeric. An empty slice is all alphanumeric
+ACLIBDEF bool ac_ascii_all_alphanumeric(Ac_StrSlice slice);
+/// Checks if every char in a slice is whitespace. An empty slice is all whitespace
+ACLIBDEF bool ac_ascii_all_whitespace(Ac_StrSlice slice);
+
+/// Finds the index of the first char in a slice that isn't alphabetic, or the slice's length if
+/// there is none
+ACLIBDEF size_t ac_ascii_find_non_alphabetic(Ac_StrSlice slice);
+/// Finds the index of the first char in a slice that isn't numeric, or the slice's length if there
+/// is none
+ACLIBDEF size_t ac_ascii_find_non_numeric(Ac_StrSlice slice);
+/// Finds the index of the first char in a slice that isn't alphanumeric, or the slice's length if
+/// there is none
+ACLIBDEF size_t ac_ascii_find_non_alphanumeric(Ac_StrSlice slice);
+/// Finds the index of the first char in a slice that isn't whitespace, or the slice's length if
+/// there is none
+ACLIBDEF size_t ac_ascii_find_non_whitespace(Ac_StrSlice slice);
 
 /* END OF ASCII DECL */
 
@@ -908,102 +2679,1847 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...);
 
 
 
-/*                         *
- *  VECTOR IMPLEMENTATION  *
- *                         */
+/*                            *
+ *  ALLOCATOR IMPLEMENTATION  *
+ *                            */
 
-ACLIBDEF void* __aclib_clone_arr(void* ptr, size_t size)
+ACLIBDEF void* __aclib_default_alloc(void* ctx, size_t size)
 {
-    void* buffer = malloc(size);
-    memcpy(buffer, ptr, size);
-    return buffer;
+    (void)ctx;
+    return ACLIB_MALLOC_FN(size);
 }
 
-/* END OF VECTOR IMPLEMENTATION */
-
+ACLIBDEF void* __aclib_default_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
+{
+    (void)ctx;
+    (void)old_size;
+    return ACLIB_REALLOC_FN(ptr, new_size);
+}
 
+ACLIBDEF void __aclib_default_free(void* ctx, void* ptr)
+{
+    (void)ctx;
+    ACLIB_FREE_FN(ptr);
+}
 
-/*                         *
- *  STRING IMPLEMENTATION  *
- *                         */
+#if defined(__ACLIB_LIBC_MALLOC) && defined(__GLIBC__)
+#include <malloc.h>
 
-ACLIBDEF Ac_StrSlice ac_str_slice_with_len(size_t len)
+ACLIBDEF size_t __aclib_default_usable_size(void* ctx, void* ptr)
 {
-    return (Ac_StrSlice){
-        .chars = (char*)ACLIB_CALLOC_FN(len + 1, sizeof(char)),
-        .len = len,
-    };
+    (void)ctx;
+    return malloc_usable_size(ptr);
 }
+#else
+#define __aclib_default_usable_size NULL
+#endif
 
-ACLIBDEF Ac_StrSlice ac_str_slice_from(char* chs)
+const Ac_Allocator aclib_default_allocator = {
+    .alloc = __aclib_default_alloc,
+    .realloc = __aclib_default_realloc,
+    .free = __aclib_default_free,
+    .usable_size = __aclib_default_usable_size,
+    .ctx = NULL,
+};
+_Thread_local const Ac_Allocator* aclib_thread_allocator = NULL;
+
+ACLIBDEF const Ac_Allocator* ac_allocator_current(void)
 {
-    return (Ac_StrSlice){
-        .chars = chs,
-        .len = strlen(chs),
-    };
+    return aclib_thread_allocator ? aclib_thread_allocator : &aclib_default_allocator;
 }
 
-ACLIBDEF Ac_StrSlice ac_str_owned_slice(Ac_String str)
+ACLIBDEF void* ac_allocator_alloc(const Ac_Allocator* allocator, size_t size)
 {
-    if (str.cap == 0)
-        return (Ac_StrSlice){0};
+    if (allocator == NULL)
+        allocator = ac_allocator_current();
 
-    char* buffer = ac_str_clone_chars(str);
-    return ac_str_slice_from(buffer);
+    return allocator->alloc(allocator->ctx, size);
 }
 
-ACLIBDEF Ac_StrSlice ac_str_slice_clone(Ac_StrSlice slice)
+ACLIBDEF void* ac_allocator_realloc(const Ac_Allocator* allocator, void* ptr, size_t old_size,
+                                    size_t new_size)
 {
-    char* chars = (char*)ACLIB_MALLOC_FN((slice.len + 1) * sizeof(char));
-    memcpy(chars, slice.chars, slice.len * sizeof(char));
+    if (allocator == NULL)
+        allocator = ac_allocator_current();
 
-    chars[slice.len] = '\0';
-    return (Ac_StrSlice){.chars = chars, .len = slice.len};
+    return allocator->realloc(allocator->ctx, ptr, old_size, new_size);
 }
 
-ACLIBDEF Ac_StrSlice ac_str_slice_range(Ac_String str, size_t start, size_t end)
+ACLIBDEF void ac_allocator_free(const Ac_Allocator* allocator, void* ptr)
 {
-    if (start >= str.len || end > str.len || start >= end)
-        return (Ac_StrSlice){0};
+    if (ptr == NULL)
+        return;
 
-    return (Ac_StrSlice){
-        .chars = str.chars + start,
-        .len = end - start,
-    };
+    if (allocator == NULL)
+        allocator = ac_allocator_current();
+
+    if (allocator->free)
+        allocator->free(allocator->ctx, ptr);
 }
 
-ACLIBDEF void ac_str_slice_free(Ac_StrSlice* slice)
+ACLIBDEF size_t ac_allocator_usable_size(const Ac_Allocator* allocator, void* ptr,
+                                         size_t requested)
 {
-    free(slice->chars);
-    slice->len = 0;
+    if (allocator == NULL)
+        allocator = ac_allocator_current();
+
+    if (ptr == NULL || allocator->usable_size == NULL)
+        return requested;
+
+    size_t usable = allocator->usable_size(allocator->ctx, ptr);
+    return usable > requested ? usable : requested;
 }
 
-ACLIBDEF Ac_String ac_str_with_capacity(size_t capacity)
+/* END OF ALLOCATOR IMPLEMENTATION */
+
+
+
+/*                        *
+ *  ARENA IMPLEMENTATION  *
+ *                        */
+
+ACLIBDEF Ac_ArenaChunk* __aclib_arena_new_chunk(Ac_Arena* arena, size_t cap)
 {
-    return (Ac_String){
-        .chars = (char*)ACLIB_CALLOC_FN(capacity + 1, sizeof(char)),
-        .len = 0,
-        .cap = capacity,
-    };
+    if (arena->allocator == NULL)
+        arena->allocator = ac_allocator_current();
+
+    Ac_ArenaChunk* chunk =
+        (Ac_ArenaChunk*)ac_allocator_alloc(arena->allocator, sizeof(Ac_ArenaChunk) + cap);
+
+    if (chunk == NULL)
+    {
+        ac_log(ACLIB_ERR, "Failed to allocate arena chunk\n");
+        exit(EXIT_FAILURE);
+    }
+
+    chunk->next = NULL;
+    chunk->cap = cap;
+    chunk->used = 0;
+    return chunk;
 }
 
-ACLIBDEF Ac_String ac_str_from(char* chs)
+/// Get the offset into a chunk, where an allocation with the given alignment can start
+ACLIBDEF size_t __aclib_arena_aligned_offset(Ac_ArenaChunk* chunk, size_t align)
 {
-    Ac_String str = {0};
-    ac_str_append(&str, chs);
-    return str;
+    uintptr_t addr = (uintptr_t)(chunk->data + chunk->used);
+    uintptr_t aligned = (addr + (align - 1)) & ~(uintptr_t)(align - 1);
+    return chunk->used + (aligned - addr);
 }
 
-ACLIBDEF void ac_str_push(Ac_String* str, char ch)
+ACLIBDEF void* ac_arena_alloc(Ac_Arena* arena, size_t size)
 {
-    ac_str_ensure_cap(str, str->len + 1);
-
-    str->chars[str->len] = ch;
-    str->chars[str->len + 1] = '\0';
-    str->len += 1;
+    return ac_arena_alloc_aligned(arena, size, AC_ARENA_ALIGN);
 }
 
-ACLIBDEF void ac_str_unshift(Ac_String* str, char ch)
+ACLIBDEF void* ac_arena_alloc_aligned(Ac_Arena* arena, size_t size, size_t align)
+{
+    ACLIB_ASSERT_FN(align != 0 && (align & (align - 1)) == 0 &&
+                    "Arena alignment must be a power of two");
+
+    if (arena->current == NULL)
+        arena->current = arena->first;
+
+    while (arena->current != NULL)
+    {
+        Ac_ArenaChunk* chunk = arena->current;
+        size_t offset = __aclib_arena_aligned_offset(chunk, align);
+
+        if (offset <= chunk->cap && size <= chunk->cap - offset)
+        {
+            chunk->used = offset + size;
+            return chunk->data + offset;
+        }
+
+        // Move on to the chunks that were kept by a reset, if any
+        if (chunk->next == NULL)
+            break;
+        arena->current = chunk->next;
+        arena->current->used = 0;
+    }
+
+    size_t chunk_size = arena->chunk_size ? arena->chunk_size : ACLIB_ARENA_CHUNK_SIZE;
+    size_t needed = size + align;
+    Ac_ArenaChunk* chunk =
+        __aclib_arena_new_chunk(arena, needed > chunk_size ? needed : chunk_size);
+
+    if (arena->current == NULL)
+        arena->first = chunk;
+    else
+        arena->current->next = chunk;
+    arena->current = chunk;
+
+    size_t offset = __aclib_arena_aligned_offset(chunk, align);
+    chunk->used = offset + size;
+    return chunk->data + offset;
+}
+
+ACLIBDEF void* ac_arena_calloc(Ac_Arena* arena, size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+        return NULL;
+
+    void* ptr = ac_arena_alloc(arena, count * size);
+    memset(ptr, 0, count * size);
+    return ptr;
+}
+
+ACLIBDEF void* ac_arena_realloc(Ac_Arena* arena, void* ptr, size_t old_size, size_t new_size)
+{
+    if (ptr == NULL)
+        return ac_arena_alloc(arena, new_size);
+
+    Ac_ArenaChunk* chunk = arena->current;
+    // The latest allocation can be resized in place, if the chunk has room for it
+    if (chunk != NULL && (unsigned char*)ptr + old_size == chunk->data + chunk->used)
+    {
+        size_t offset = (unsigned char*)ptr - chunk->data;
+        if (new_size <= chunk->cap - offset)
+        {
+            chunk->used = offset + new_size;
+            return ptr;
+        }
+    }
+
+    if (new_size <= old_size)
+        return ptr;
+
+    void* new_ptr = ac_arena_alloc(arena, new_size);
+    memcpy(new_ptr, ptr, old_size);
+    return new_ptr;
+}
+
+ACLIBDEF Ac_ArenaMark ac_arena_mark(Ac_Arena* arena)
+{
+    if (arena->current == NULL)
+        return (Ac_ArenaMark){0};
+
+    return (Ac_ArenaMark){.chunk = arena->current, .used = arena->current->used};
+}
+
+ACLIBDEF void ac_arena_reset_to(Ac_Arena* arena, Ac_ArenaMark mark)
+{
+    if (mark.chunk == NULL)
+    {
+        ac_arena_reset(arena);
+        return;
+    }
+
+    for (Ac_ArenaChunk* chunk = mark.chunk->next; chunk != NULL; chunk = chunk->next)
+        chunk->used = 0;
+
+    mark.chunk->used = mark.used;
+    arena->current = mark.chunk;
+}
+
+ACLIBDEF void ac_arena_reset(Ac_Arena* arena)
+{
+    for (Ac_ArenaChunk* chunk = arena->first; chunk != NULL; chunk = chunk->next)
+        chunk->used = 0;
+
+    arena->current = arena->first;
+}
+
+ACLIBDEF void ac_arena_free(Ac_Arena* arena)
+{
+    Ac_ArenaChunk* chunk = arena->first;
+    while (chunk != NULL)
+    {
+        Ac_ArenaChunk* next = chunk->next;
+        ac_allocator_free(arena->allocator, chunk);
+        chunk = next;
+    }
+
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+ACLIBDEF void* __aclib_arena_allocator_alloc(void* ctx, size_t size)
+{
+    return ac_arena_alloc((Ac_Arena*)ctx, size);
+}
+
+ACLIBDEF void* __aclib_arena_allocator_realloc(void* ctx, void* ptr, size_t old_size,
+                                               size_t new_size)
+{
+    return ac_arena_realloc((Ac_Arena*)ctx, ptr, old_size, new_size);
+}
+
+ACLIBDEF Ac_Allocator ac_arena_allocator(Ac_Arena* arena)
+{
+    return (Ac_Allocator){
+        .alloc = __aclib_arena_allocator_alloc,
+        .realloc = __aclib_arena_allocator_realloc,
+        .free = NULL,
+        .ctx = arena,
+    };
+}
+
+/* END OF ARENA IMPLEMENTATION */
+
+
+
+/*                         *
+ *  VECTOR IMPLEMENTATION  *
+ *                         */
+
+ACLIBDEF void* __aclib_clone_arr(void* ptr, size_t size)
+{
+    void* buffer = ac_allocator_alloc(NULL, size);
+    memcpy(buffer, ptr, size);
+    return buffer;
+}
+
+ACLIBDEF size_t ac_growth_geometric(size_t cap, size_t needed, size_t elem_size)
+{
+    (void)elem_size;
+    size_t new_cap = cap > 0 ? cap : ACLIB_VEC_START_CAP;
+
+    while (new_cap < needed)
+    {
+        if (new_cap > SIZE_MAX / ACLIB_VEC_GROWTH_FACTOR)
+            return needed;
+
+        // A fractional factor rounds down, so always grow by at least one
+        size_t grown = (size_t)(new_cap * ACLIB_VEC_GROWTH_FACTOR);
+        new_cap = grown > new_cap ? grown : new_cap + 1;
+    }
+
+    return new_cap;
+}
+
+ACLIBDEF size_t ac_growth_pow2(size_t cap, size_t needed, size_t elem_size)
+{
+    (void)cap;
+    (void)elem_size;
+    size_t new_cap = 1;
+
+    while (new_cap < needed)
+    {
+        if (new_cap > SIZE_MAX / 2)
+            return needed;
+        new_cap *= 2;
+    }
+
+    return new_cap;
+}
+
+ACLIBDEF size_t ac_growth_exact(size_t cap, size_t needed, size_t elem_size)
+{
+    (void)cap;
+    (void)elem_size;
+    return needed;
+}
+
+ACLIBDEF void* __aclib_grow(void* items, size_t* cap, const Ac_Allocator** allocator,
+                            size_t elem_size, size_t new_cap, Ac_GrowthFn growth_fn)
+{
+    if (*allocator == NULL)
+        *allocator = ac_allocator_current();
+
+    size_t calced_cap = growth_fn(*cap, new_cap, elem_size);
+    if (calced_cap < new_cap)
+        calced_cap = new_cap;
+
+    items = ac_allocator_realloc(*allocator, items, *cap * elem_size, calced_cap * elem_size);
+
+    if (items == NULL)
+    {
+        ac_log(ACLIB_ERR, "Failed to grow an allocation to %zu bytes\n", calced_cap * elem_size);
+        exit(EXIT_FAILURE);
+    }
+
+    // Use the slack the allocator gave us, so it doesn't go to waste
+    *cap = ac_allocator_usable_size(*allocator, items, calced_cap * elem_size) / elem_size;
+    return items;
+}
+
+ACLIBDEF void* __aclib_shrink(void* items, size_t* cap, const Ac_Allocator* allocator,
+                              size_t elem_size, size_t len)
+{
+    if (items == NULL || *cap <= len)
+        return items;
+
+    if (len == 0)
+    {
+        ac_allocator_free(allocator, items);
+        *cap = 0;
+        return NULL;
+    }
+
+    void* shrunk = ac_allocator_realloc(allocator, items, *cap * elem_size, len * elem_size);
+    if (shrunk == NULL)
+        return items;
+
+    *cap = len;
+    return shrunk;
+}
+
+/* END OF VECTOR IMPLEMENTATION */
+
+
+
+/*                               *
+ *  SMALL VECTOR IMPLEMENTATION  *
+ *                               */
+
+ACLIBDEF void* __aclib_smallvec_grow(void* items, size_t len, size_t* cap,
+                                     const Ac_Allocator** allocator, size_t elem_size,
+                                     size_t new_cap, Ac_GrowthFn growth_fn, void* inline_items,
+                                     size_t inline_cap)
+{
+    if (items == NULL && new_cap <= inline_cap)
+    {
+        *cap = inline_cap;
+        return inline_items;
+    }
+
+    if (items != NULL && items != inline_items)
+        return __aclib_grow(items, cap, allocator, elem_size, new_cap, growth_fn);
+
+    // Grow from the inline capacity, as if the inline items had been a heap allocation
+    size_t calced_cap = growth_fn(inline_cap, new_cap, elem_size);
+    size_t heap_cap = 0;
+    void* heap = __aclib_grow(NULL, &heap_cap, allocator, elem_size,
+                              calced_cap > new_cap ? calced_cap : new_cap, ac_growth_exact);
+
+    if (items != NULL)
+        memcpy(heap, items, len * elem_size);
+
+    *cap = heap_cap;
+    return heap;
+}
+
+/* END OF SMALL VECTOR IMPLEMENTATION */
+
+
+
+/*                        *
+ *  DEQUE IMPLEMENTATION  *
+ *                        */
+
+ACLIBDEF void* __aclib_deque_grow(void* items, size_t head, size_t len, size_t* cap,
+                                  const Ac_Allocator** allocator, size_t elem_size,
+                                  size_t new_cap)
+{
+    if (*allocator == NULL)
+        *allocator = ac_allocator_current();
+
+    size_t old_cap = *cap;
+    size_t needed = new_cap;
+    if (needed < old_cap * 2)
+        needed = old_cap * 2;
+    if (needed < ACLIB_VEC_START_CAP)
+        needed = ACLIB_VEC_START_CAP;
+
+    // The capacity must stay a power of two, so the allocator's slack is not used here
+    size_t calced_cap = ac_growth_pow2(old_cap, needed, elem_size);
+    items = ac_allocator_realloc(*allocator, items, old_cap * elem_size, calced_cap * elem_size);
+
+    if (items == NULL)
+    {
+        ac_log(ACLIB_ERR, "Failed to reallocate deque\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // The new capacity is atleast twice the old one, so the wrapped elements fit right after the
+    // old end of the buffer
+    if (head + len > old_cap)
+    {
+        size_t wrapped = head + len - old_cap;
+        memcpy((char*)items + old_cap * elem_size, items, wrapped * elem_size);
+    }
+
+    *cap = calced_cap;
+    return items;
+}
+
+/* END OF DEQUE IMPLEMENTATION */
+
+
+
+/*                                *
+ *  BYTE SCANNING IMPLEMENTATION  *
+ *                               */
+// The scanning kernels used by the string functions. They use SSE2 on x86-64, with AVX2 picked at
+// runtime when the CPU supports it, and fall back to word-at-a-time (SWAR) scanning elsewhere.
+// Define ACLIB_NO_SIMD to always use the portable kernels.
+
+#if !defined(ACLIB_NO_SIMD) && defined(__GNUC__) && defined(__SSE2__)
+#define __ACLIB_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__) || defined(__x86_64__)
+#define __ACLIB_AVX2
+#include <immintrin.h>
+#ifdef __AVX2__
+#define __aclib_has_avx2() true
+#else
+#define __aclib_has_avx2() __builtin_cpu_supports("avx2")
+#endif
+#ifdef __SSSE3__
+#define __aclib_has_ssse3() true
+#else
+#define __aclib_has_ssse3() __builtin_cpu_supports("ssse3")
+#endif
+#endif
+#endif
+
+/// A word with every byte set to 0x01
+#define __ACLIB_SWAR_ONES ((uint64_t)0x0101010101010101ULL)
+/// A word with every byte set to 0x80
+#define __ACLIB_SWAR_HIGHS ((uint64_t)0x8080808080808080ULL)
+/// Non-zero if any byte in the word is zero
+#define __aclib_swar_has_zero(word) (((word) - __ACLIB_SWAR_ONES) & ~(word) & __ACLIB_SWAR_HIGHS)
+
+#ifdef __ACLIB_SSE2
+/// Get a mask of the whitespace bytes in a block, i.e. ' ' and '\t' through '\r'
+#define __aclib_sse2_ws_mask(block)                                                            \
+    _mm_movemask_epi8(_mm_or_si128(                                                            \
+        _mm_cmpeq_epi8((block), _mm_set1_epi8(' ')),                                           \
+        _mm_cmpeq_epi8(_mm_min_epu8(_mm_sub_epi8((block), _mm_set1_epi8('\t')),                \
+                                    _mm_set1_epi8('\r' - '\t')),                               \
+                       _mm_sub_epi8((block), _mm_set1_epi8('\t')))))
+#endif
+
+#ifdef __ACLIB_AVX2
+__attribute__((target("avx2"))) ACLIBDEF size_t __aclib_avx2_scan_byte(const char* chars,
+                                                                       size_t len, char byte)
+{
+    __m256i pattern = _mm256_set1_epi8(byte);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(chars + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    return i;
+}
+#endif
+
+/// Find the index of the first occurrence of byte, or len if it isn't found
+ACLIBDEF size_t __aclib_scan_byte(const char* chars, size_t len, char byte)
+{
+    size_t i = 0;
+
+#if defined(__ACLIB_SSE2)
+#if defined(__ACLIB_AVX2)
+    if (len >= 64 && __aclib_has_avx2())
+    {
+        i = __aclib_avx2_scan_byte(chars, len, byte);
+        if (i + 32 <= len)
+            return i;
+    }
+#endif
+    __m128i pattern = _mm_set1_epi8(byte);
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+
+    // Scan the tail with a block overlapping the bytes that are already scanned
+    if (i < len && len >= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + len - 16));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)) >> (16 - (len - i));
+        return mask != 0 ? i + __builtin_ctz(mask) : len;
+    }
+#else
+    uint64_t pattern = __ACLIB_SWAR_ONES * (unsigned char)byte;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, chars + i, sizeof(word));
+        if (__aclib_swar_has_zero(word ^ pattern))
+            break;
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        if (chars[i] == byte)
+            return i;
+    }
+    return len;
+}
+
+/// Find the index of the first byte that isn't whitespace, or len if all of them are
+ACLIBDEF size_t __aclib_scan_non_ws(const char* chars, size_t len)
+{
+    size_t i = 0;
+
+#ifdef __ACLIB_SSE2
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + i));
+        int mask = ~__aclib_sse2_ws_mask(block) & 0xFFFF;
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+
+    while (i < len && ac_ascii_is_whitespace(chars[i]))
+        i++;
+    return i;
+}
+
+/// Find the index after the last byte that isn't whitespace, or 0 if all of them are
+ACLIBDEF size_t __aclib_rscan_non_ws(const char* chars, size_t len)
+{
+    size_t end = len;
+
+#ifdef __ACLIB_SSE2
+    for (; end >= 16; end -= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + end - 16));
+        int mask = ~__aclib_sse2_ws_mask(block) & 0xFFFF;
+        if (mask != 0)
+            return end - 16 + (32 - __builtin_clz(mask));
+    }
+#endif
+
+    while (end > 0 && ac_ascii_is_whitespace(chars[end - 1]))
+        end--;
+    return end;
+}
+
+#ifdef __ACLIB_AVX2
+/// Get the bytes in a block that are in a byte set, as 0xFF for a hit and 0 for a miss. The low
+/// nibble of every byte picks a byte from the set's tables, holding a bit for each high nibble, and
+/// the high nibble picks which of those bits to test
+__attribute__((target("ssse3"))) ACLIBDEF __m128i __aclib_ssse3_byteset_hits(__m128i block,
+                                                                             __m128i table_lo,
+                                                                             __m128i table_hi)
+{
+    __m128i lo = _mm_and_si128(block, _mm_set1_epi8(0x0F));
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(block, 4), _mm_set1_epi8(0x0F));
+    __m128i bit = _mm_shuffle_epi8(
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128), hi);
+    __m128i is_hi = _mm_cmpgt_epi8(hi, _mm_set1_epi8(7));
+
+    __m128i row = _mm_or_si128(_mm_andnot_si128(is_hi, _mm_shuffle_epi8(table_lo, lo)),
+                               _mm_and_si128(is_hi, _mm_shuffle_epi8(table_hi, lo)));
+    return _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+}
+
+/// Get a mask of the bytes in a block that are in a byte set
+#define __aclib_ssse3_byteset_mask(block, table_lo, table_hi) \
+    (unsigned)_mm_movemask_epi8(__aclib_ssse3_byteset_hits((block), (table_lo), (table_hi)))
+
+__attribute__((target("avx2"))) ACLIBDEF unsigned __aclib_avx2_byteset_mask(__m256i block,
+                                                                            __m256i table_lo,
+                                                                            __m256i table_hi)
+{
+    __m256i lo = _mm256_and_si256(block, _mm256_set1_epi8(0x0F));
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0F));
+    __m256i bit = _mm256_shuffle_epi8(
+        _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8,
+                         16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128),
+        hi);
+    __m256i is_hi = _mm256_cmpgt_epi8(hi, _mm256_set1_epi8(7));
+
+    __m256i row = _mm256_or_si256(_mm256_andnot_si256(is_hi, _mm256_shuffle_epi8(table_lo, lo)),
+                                  _mm256_and_si256(is_hi, _mm256_shuffle_epi8(table_hi, lo)));
+    return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit));
+}
+
+__attribute__((target("avx2"))) ACLIBDEF size_t __aclib_avx2_byteset_scan(const Ac_ByteSet* set,
+                                                                          const char* chars,
+                                                                          size_t len,
+                                                                          unsigned flip)
+{
+    __m256i table_lo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->nibbles[0]));
+    __m256i table_hi =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->nibbles[1]));
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(chars + i));
+        unsigned mask = __aclib_avx2_byteset_mask(block, table_lo, table_hi) ^ flip;
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    return i;
+}
+
+__attribute__((target("ssse3"))) ACLIBDEF size_t __aclib_ssse3_byteset_scan(const Ac_ByteSet* set,
+                                                                            const char* chars,
+                                                                            size_t len,
+                                                                            unsigned flip)
+{
+    __m128i table_lo = _mm_loadu_si128((const __m128i*)set->nibbles[0]);
+    __m128i table_hi = _mm_loadu_si128((const __m128i*)set->nibbles[1]);
+    flip &= 0xFFFF;
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + i));
+        unsigned mask = __aclib_ssse3_byteset_mask(block, table_lo, table_hi) ^ flip;
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+
+    // Scan the tail with a block overlapping the bytes that are already scanned
+    if (i < len && len >= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + len - 16));
+        unsigned mask = (__aclib_ssse3_byteset_mask(block, table_lo, table_hi) ^ flip) >>
+                        (16 - (len - i));
+        return mask != 0 ? i + __builtin_ctz(mask) : len;
+    }
+    return i;
+}
+
+__attribute__((target("ssse3"))) ACLIBDEF size_t __aclib_ssse3_byteset_rscan(const Ac_ByteSet* set,
+                                                                             const char* chars,
+                                                                             size_t len,
+                                                                             unsigned flip)
+{
+    __m128i table_lo = _mm_loadu_si128((const __m128i*)set->nibbles[0]);
+    __m128i table_hi = _mm_loadu_si128((const __m128i*)set->nibbles[1]);
+    flip &= 0xFFFF;
+
+    size_t end = len;
+    for (; end >= 16; end -= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + end - 16));
+        unsigned mask = __aclib_ssse3_byteset_mask(block, table_lo, table_hi) ^ flip;
+        if (mask != 0)
+            return end - 16 + (32 - __builtin_clz(mask));
+    }
+    return end;
+}
+
+__attribute__((target("ssse3"))) ACLIBDEF void __aclib_ssse3_byteset_classify(const Ac_ByteSet* set,
+                                                                              const char* chars,
+                                                                              size_t len,
+                                                                              bool* out)
+{
+    __m128i table_lo = _mm_loadu_si128((const __m128i*)set->nibbles[0]);
+    __m128i table_hi = _mm_loadu_si128((const __m128i*)set->nibbles[1]);
+
+    for (size_t i = 0; i < len; i += 16)
+    {
+        // The last block overlaps the one before it, and rewrites the same values
+        if (i + 16 > len)
+            i = len - 16;
+
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + i));
+        __m128i hits = __aclib_ssse3_byteset_hits(block, table_lo, table_hi);
+        _mm_storeu_si128((__m128i*)(out + i), _mm_and_si128(hits, _mm_set1_epi8(1)));
+    }
+}
+#endif
+
+/// Find the index of the first byte that is in the set, or len if none are. If negate is true,
+/// find the first byte that is not in the set instead
+ACLIBDEF size_t __aclib_byteset_scan(const Ac_ByteSet* set, const char* chars, size_t len,
+                                     bool negate)
+{
+    size_t i = 0;
+
+#ifdef __ACLIB_AVX2
+    unsigned flip = negate ? ~0u : 0u;
+    if (len >= 64 && __aclib_has_avx2())
+    {
+        i = __aclib_avx2_byteset_scan(set, chars, len, flip);
+        if (i + 32 <= len)
+            return i;
+    }
+    if (len - i >= 16 && __aclib_has_ssse3())
+        return i + __aclib_ssse3_byteset_scan(set, chars + i, len - i, flip);
+#endif
+
+    for (; i < len; i++)
+    {
+        if (ac_byteset_contains(set, chars[i]) != negate)
+            return i;
+    }
+    return len;
+}
+
+/// Find the index after the last byte that is in the set, or 0 if none are. If negate is true,
+/// find the last byte that is not in the set instead
+ACLIBDEF size_t __aclib_byteset_rscan(const Ac_ByteSet* set, const char* chars, size_t len,
+                                      bool negate)
+{
+    size_t end = len;
+
+#ifdef __ACLIB_AVX2
+    if (len >= 16 && __aclib_has_ssse3())
+        end = __aclib_ssse3_byteset_rscan(set, chars, len, negate ? ~0u : 0u);
+#endif
+
+    for (; end > 0; end--)
+    {
+        if (ac_byteset_contains(set, chars[end - 1]) != negate)
+            return end;
+    }
+    return 0;
+}
+
+ACLIBDEF Ac_ByteSet ac_byteset_from(const char* chars)
+{
+    Ac_ByteSet set = {0};
+    for (; *chars != '\0'; chars++)
+        ac_byteset_add(&set, *chars);
+    return set;
+}
+
+ACLIBDEF Ac_ByteSet ac_byteset_from_slice(Ac_StrSlice slice)
+{
+    Ac_ByteSet set = {0};
+    for (size_t i = 0; i < slice.len; i++)
+        ac_byteset_add(&set, slice.chars[i]);
+    return set;
+}
+
+ACLIBDEF void ac_byteset_add(Ac_ByteSet* set, char ch)
+{
+    unsigned char byte = (unsigned char)ch;
+    set->bits[byte >> 6] |= (uint64_t)1 << (byte & 63);
+    set->nibbles[byte >> 7][byte & 0x0F] |= (uint8_t)(1 << ((byte >> 4) & 7));
+}
+
+ACLIBDEF void ac_byteset_add_range(Ac_ByteSet* set, char first, char last)
+{
+    for (unsigned byte = (unsigned char)first; byte <= (unsigned char)last; byte++)
+        ac_byteset_add(set, (char)byte);
+}
+
+ACLIBDEF void ac_byteset_invert(Ac_ByteSet* set)
+{
+    for (size_t i = 0; i < 4; i++)
+        set->bits[i] = ~set->bits[i];
+    for (size_t i = 0; i < 16; i++)
+    {
+        set->nibbles[0][i] = (uint8_t)~set->nibbles[0][i];
+        set->nibbles[1][i] = (uint8_t)~set->nibbles[1][i];
+    }
+}
+
+ACLIBDEF size_t ac_byteset_find(const Ac_ByteSet* set, Ac_StrSlice slice)
+{
+    return __aclib_byteset_scan(set, slice.chars, slice.len, false);
+}
+
+ACLIBDEF size_t ac_byteset_find_not(const Ac_ByteSet* set, Ac_StrSlice slice)
+{
+    return __aclib_byteset_scan(set, slice.chars, slice.len, true);
+}
+
+ACLIBDEF void ac_byteset_classify(const Ac_ByteSet* set, Ac_StrSlice slice, bool* out)
+{
+#ifdef __ACLIB_AVX2
+    if (sizeof(bool) == 1 && slice.len >= 16 && __aclib_has_ssse3())
+    {
+        __aclib_ssse3_byteset_classify(set, slice.chars, slice.len, out);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < slice.len; i++)
+        out[i] = ac_byteset_contains(set, slice.chars[i]);
+}
+
+/// Needles shorter than this are searched for with the first and last byte filter, and longer
+/// ones with Two-Way
+#define __ACLIB_SHORT_NEEDLE_LEN 32
+
+#ifdef __ACLIB_SSE2
+/// Whether a needle is searched for with Two-Way, and therefore needs to be factorized
+#define __aclib_uses_two_way(needle_len) ((needle_len) >= __ACLIB_SHORT_NEEDLE_LEN)
+#else
+#define __aclib_uses_two_way(needle_len) ((needle_len) > 0)
+#endif
+
+#ifdef __ACLIB_SSE2
+#ifdef __ACLIB_AVX2
+/// Search the full 32 byte blocks of a haystack with the first and last byte filter. Returns the
+/// index of the match, or SIZE_MAX and the index to continue from in next
+__attribute__((target("avx2"))) ACLIBDEF size_t __aclib_avx2_filter_find(const char* haystack,
+                                                                         size_t len,
+                                                                         const char* needle,
+                                                                         size_t needle_len,
+                                                                         size_t* next)
+{
+    __m256i first = _mm256_set1_epi8(needle[0]);
+    __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+
+    size_t i = 0;
+    for (; i + needle_len + 31 <= len; i += 32)
+    {
+        __m256i block_first = _mm256_loadu_si256((const __m256i*)(haystack + i));
+        __m256i block_last = _mm256_loadu_si256((const __m256i*)(haystack + i + needle_len - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+
+        while (mask != 0)
+        {
+            size_t idx = i + __builtin_ctz(mask);
+            if (needle_len < 3 || memcmp(haystack + idx + 1, needle + 1, needle_len - 2) == 0)
+                return idx;
+            mask &= mask - 1;
+        }
+    }
+
+    *next = i;
+    return SIZE_MAX;
+}
+#endif
+
+/// Find the first occurrence of a short needle, by only comparing the positions where both the
+/// first and the last byte of the needle match. Returns SIZE_MAX if it isn't found
+ACLIBDEF size_t __aclib_filter_find(const char* haystack, size_t len, const char* needle,
+                                    size_t needle_len)
+{
+    size_t i = 0;
+
+#ifdef __ACLIB_AVX2
+    if (len >= 64 && __aclib_has_avx2())
+    {
+        size_t idx = __aclib_avx2_filter_find(haystack, len, needle, needle_len, &i);
+        if (idx != SIZE_MAX)
+            return idx;
+    }
+#endif
+
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[needle_len - 1]);
+    for (; i + needle_len + 15 <= len; i += 16)
+    {
+        __m128i block_first = _mm_loadu_si128((const __m128i*)(haystack + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i*)(haystack + i + needle_len - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+
+        while (mask != 0)
+        {
+            size_t idx = i + __builtin_ctz(mask);
+            if (needle_len < 3 || memcmp(haystack + idx + 1, needle + 1, needle_len - 2) == 0)
+                return idx;
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i + needle_len <= len; i++)
+    {
+        if (haystack[i] == needle[0] && memcmp(haystack + i, needle, needle_len) == 0)
+            return i;
+    }
+    return SIZE_MAX;
+}
+
+/// Find the last occurrence of a short needle with the first and last byte filter. Returns
+/// SIZE_MAX if it isn't found
+ACLIBDEF size_t __aclib_filter_rfind(const char* haystack, size_t len, const char* needle,
+                                     size_t needle_len)
+{
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[needle_len - 1]);
+
+    // The amount of positions the needle could start at, that haven't been checked yet
+    size_t end = len - needle_len + 1;
+    for (; end >= 16; end -= 16)
+    {
+        size_t i = end - 16;
+        __m128i block_first = _mm_loadu_si128((const __m128i*)(haystack + i));
+        __m128i block_last = _mm_loadu_si128((const __m128i*)(haystack + i + needle_len - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+
+        while (mask != 0)
+        {
+            unsigned bit = 31 - __builtin_clz(mask);
+            if (needle_len < 3 || memcmp(haystack + i + bit + 1, needle + 1, needle_len - 2) == 0)
+                return i + bit;
+            mask &= ~(1u << bit);
+        }
+    }
+
+    for (; end > 0; end--)
+    {
+        if (haystack[end - 1] == needle[0] &&
+            memcmp(haystack + end - 1, needle, needle_len) == 0)
+            return end - 1;
+    }
+    return SIZE_MAX;
+}
+#endif
+
+/// Get the byte at an index of a string, counting from the back if reverse is set
+#define __aclib_byte_at(chars, len, idx, reverse) \
+    ((unsigned char)(chars)[(reverse) ? (len) - 1 - (idx) : (idx)])
+
+/// Find the maximal suffix of a needle, under the normal or the inverted byte order. Returns the
+/// index before the suffix starts, which is -1 if the suffix is the whole needle
+ACLIBDEF ptrdiff_t __aclib_max_suffix(const char* needle, size_t len, bool reverse, bool invert,
+                                      size_t* period)
+{
+    ptrdiff_t suffix = -1;
+    size_t j = 0;
+    size_t k = 1;
+    size_t p = 1;
+
+    while (j + k < len)
+    {
+        unsigned char a = __aclib_byte_at(needle, len, j + k, reverse);
+        unsigned char b = __aclib_byte_at(needle, len, (size_t)(suffix + (ptrdiff_t)k), reverse);
+
+        if (invert ? a > b : a < b)
+        {
+            j += k;
+            k = 1;
+            p = j - (size_t)suffix;
+        }
+        else if (a == b)
+        {
+            if (k != p)
+            {
+                k++;
+            }
+            else
+            {
+                j += p;
+                k = 1;
+            }
+        }
+        else
+        {
+            suffix = (ptrdiff_t)j;
+            j = (size_t)suffix + 1;
+            k = p = 1;
+        }
+    }
+
+    *period = p;
+    return suffix;
+}
+
+/// Compute the critical factorization of a needle, or of the reversed needle
+ACLIBDEF void __aclib_two_way_factorize(const char* needle, size_t len, bool reverse, size_t* crit,
+                                        size_t* period, bool* periodic)
+{
+    size_t period_a, period_b;
+    ptrdiff_t suffix_a = __aclib_max_suffix(needle, len, reverse, false, &period_a);
+    ptrdiff_t suffix_b = __aclib_max_suffix(needle, len, reverse, true, &period_b);
+
+    ptrdiff_t suffix = suffix_a > suffix_b ? suffix_a : suffix_b;
+    *period = suffix_a > suffix_b ? period_a : period_b;
+    *crit = (size_t)(suffix + 1);
+
+    // The needle is periodic, if its left half is repeated after one period
+    *periodic = *crit + *period <= len;
+    for (size_t i = 0; *periodic && i < *crit; i++)
+    {
+        if (__aclib_byte_at(needle, len, i, reverse) !=
+            __aclib_byte_at(needle, len, i + *period, reverse))
+            *periodic = false;
+    }
+
+    if (!*periodic)
+        *period = (*crit > len - *crit ? *crit : len - *crit) + 1;
+}
+
+/// Search for a needle with the Two-Way algorithm, in linear time and constant space. If reverse is
+/// set, both the haystack and the needle are read from the back, and the returned index counts
+/// from the back of the haystack. Returns SIZE_MAX if the needle isn't found
+ACLIBDEF size_t __aclib_two_way(const char* haystack, size_t len, const char* needle,
+                                size_t needle_len, size_t crit, size_t period, bool periodic,
+                                bool reverse)
+{
+    // How much of the left half is known to match after a shift by the period
+    size_t memory = 0;
+    size_t j = 0;
+
+    while (j + needle_len <= len)
+    {
+        // Match the right half, left to right
+        size_t i = crit > memory ? crit : memory;
+        while (i < needle_len && __aclib_byte_at(needle, needle_len, i, reverse) ==
+                                     __aclib_byte_at(haystack, len, i + j, reverse))
+            i++;
+
+        if (i < needle_len)
+        {
+            j += i - crit + 1;
+            memory = 0;
+            continue;
+        }
+
+        // Match the left half, right to left
+        size_t matched = periodic ? memory : 0;
+        i = crit;
+        while (i > matched && __aclib_byte_at(needle, needle_len, i - 1, reverse) ==
+                                  __aclib_byte_at(haystack, len, i - 1 + j, reverse))
+            i--;
+
+        if (i <= matched)
+            return j;
+
+        j += period;
+        memory = periodic ? needle_len - period : 0;
+    }
+
+    return SIZE_MAX;
+}
+
+/* END OF BYTE SCANNING IMPLEMENTATION */
+
+
+
+/*                       *
+ *  HASH IMPLEMENTATION  *
+ *                       */
+// The string hash. Inputs up to 256 bytes are hashed like wyhash, by mixing 16 bytes at a time
+// through a 64x64->128 bit multiply. Longer inputs are hashed like XXH3, by accumulating 64 byte
+// stripes into 8 lanes, which maps directly onto SSE2 and AVX2 registers.
+
+/// Inputs longer than this are hashed in stripes
+#define __ACLIB_HASH_SHORT_MAX 256
+/// The size of a stripe
+#define __ACLIB_HASH_STRIPE_LEN 64
+/// The amount of stripes between each scramble of the accumulators
+#define __ACLIB_HASH_BLOCK_STRIPES 16
+
+/// The secret the stripes are mixed with. 192 bytes of splitmix64 output
+static const uint8_t __aclib_hash_secret[192] = {
+    0x21, 0xA2, 0xBE, 0x4A, 0x9F, 0xF6, 0xB0, 0x2C, 0x89, 0x89, 0x14, 0x23,
+    0x47, 0x03, 0x17, 0x94, 0x03, 0xFE, 0x9D, 0x60, 0x50, 0x59, 0x55, 0xDD,
+    0x00, 0x28, 0xB1, 0xDE, 0x50, 0xB1, 0xAF, 0xDB, 0xB6, 0x2C, 0x44, 0x6C,
+    0x2E, 0x9B, 0x78, 0x7E, 0xC4, 0xF8, 0xE4, 0xC7, 0x36, 0x56, 0x1E, 0xF4,
+    0xE4, 0xA7, 0xFB, 0xF8, 0x50, 0xD1, 0x59, 0x09, 0xEA, 0x9E, 0xDB, 0x3C,
+    0xF1, 0x16, 0x73, 0xA9, 0x68, 0x00, 0x52, 0xF9, 0x58, 0x82, 0xCD, 0x74,
+    0x8B, 0x86, 0x16, 0xE1, 0x62, 0x4A, 0xC7, 0x55, 0xBD, 0x3C, 0x02, 0xA2,
+    0x99, 0xC7, 0xF4, 0xD2, 0xB9, 0x51, 0x7B, 0xA3, 0x79, 0xCB, 0x98, 0xDF,
+    0x05, 0x39, 0x4F, 0x52, 0x85, 0x58, 0x6F, 0x39, 0x76, 0xB2, 0xA3, 0x6C,
+    0x38, 0x56, 0x1D, 0xAF, 0x5A, 0xE8, 0x04, 0x51, 0x6B, 0xBE, 0xFF, 0xA9,
+    0xB3, 0x33, 0xD5, 0x9F, 0x1B, 0xC5, 0xD0, 0x6B, 0x56, 0x4B, 0xAB, 0x50,
+    0x1C, 0xE9, 0x0C, 0x98, 0xC5, 0x62, 0xFE, 0x80, 0x57, 0x39, 0xAC, 0x28,
+    0xC7, 0xED, 0xBC, 0xA6, 0xE3, 0x12, 0x89, 0x76, 0x88, 0x7C, 0x2C, 0x33,
+    0xC9, 0xE8, 0xB3, 0x50, 0xDA, 0x47, 0xBD, 0x20, 0xE5, 0xBF, 0x3B, 0xCE,
+    0x4F, 0x7C, 0xBB, 0xE0, 0xE8, 0xC8, 0xA6, 0xCB, 0x6D, 0x34, 0x4A, 0x43,
+    0xB8, 0x4D, 0x19, 0xBF, 0x7F, 0x6D, 0x41, 0x60, 0x7B, 0x2A, 0x8F, 0x7D,
+};
+
+/// The odd constants of wyhash, used by the short inputs
+#define __ACLIB_HASH_P0 0xA0761D6478BD642FULL
+#define __ACLIB_HASH_P1 0xE7037ED1A0B428DBULL
+#define __ACLIB_HASH_P2 0x8EBC6AF09C88C6E3ULL
+#define __ACLIB_HASH_P3 0x589965CC75374CC3ULL
+
+/// The 32 bit multiplier used when scrambling the accumulators
+#define __ACLIB_HASH_SCRAMBLE_PRIME 0x9E3779B1U
+
+/// Read 8 bytes as a native endian word
+ACLIBDEF uint64_t __aclib_hash_read64(const uint8_t* bytes)
+{
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+/// Read 4 bytes as a native endian word
+ACLIBDEF uint64_t __aclib_hash_read32(const uint8_t* bytes)
+{
+    uint32_t word;
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+/// Multiply two words into 128 bits, and fold the high half into the low half
+ACLIBDEF uint64_t __aclib_hash_mix(uint64_t a, uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    uint64_t hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    uint64_t lo = (cross << 32) | (uint32_t)lo_lo;
+    return lo ^ hi;
+#endif
+}
+
+/// Hash an input of at most `__ACLIB_HASH_SHORT_MAX` bytes
+ACLIBDEF uint64_t __aclib_hash_short(const uint8_t* bytes, size_t len, uint64_t seed)
+{
+    seed ^= __aclib_hash_mix(seed ^ __ACLIB_HASH_P0, __ACLIB_HASH_P1);
+
+    uint64_t a, b;
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            // Two overlapping reads from each end cover every byte of 4 to 16 bytes
+            size_t mid = (len >> 3) << 2;
+            a = (__aclib_hash_read32(bytes) << 32) | __aclib_hash_read32(bytes + mid);
+            b = (__aclib_hash_read32(bytes + len - 4) << 32) |
+                __aclib_hash_read32(bytes + len - 4 - mid);
+        }
+        else if (len > 0)
+        {
+            a = ((uint64_t)bytes[0] << 16) | ((uint64_t)bytes[len >> 1] << 8) | bytes[len - 1];
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        size_t left = len;
+        if (left > 48)
+        {
+            uint64_t seed1 = seed, seed2 = seed;
+            do
+            {
+                seed = __aclib_hash_mix(__aclib_hash_read64(bytes) ^ __ACLIB_HASH_P1,
+                                        __aclib_hash_read64(bytes + 8) ^ seed);
+                seed1 = __aclib_hash_mix(__aclib_hash_read64(bytes + 16) ^ __ACLIB_HASH_P2,
+                                         __aclib_hash_read64(bytes + 24) ^ seed1);
+                seed2 = __aclib_hash_mix(__aclib_hash_read64(bytes + 32) ^ __ACLIB_HASH_P3,
+                                         __aclib_hash_read64(bytes + 40) ^ seed2);
+                bytes += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        for (; left > 16; bytes += 16, left -= 16)
+        {
+            seed = __aclib_hash_mix(__aclib_hash_read64(bytes) ^ __ACLIB_HASH_P1,
+                                    __aclib_hash_read64(bytes + 8) ^ seed);
+        }
+
+        // The last 16 bytes, which may overlap the bytes that are already mixed in
+        a = __aclib_hash_read64(bytes + left - 16);
+        b = __aclib_hash_read64(bytes + left - 8);
+    }
+
+    return __aclib_hash_mix(__ACLIB_HASH_P1 ^ len,
+                            __aclib_hash_mix(a ^ __ACLIB_HASH_P1, b ^ seed) ^ __ACLIB_HASH_P0);
+}
+
+/// Accumulate a stripe into the 8 accumulators
+ACLIBDEF void __aclib_hash_accumulate(uint64_t* acc, const uint8_t* stripe, const uint8_t* secret)
+{
+#ifdef __ACLIB_SSE2
+    for (size_t i = 0; i < 4; i++)
+    {
+        __m128i acc_vec = _mm_loadu_si128((const __m128i*)(acc + i * 2));
+        __m128i data = _mm_loadu_si128((const __m128i*)(stripe + i * 16));
+        __m128i key = _mm_xor_si128(data, _mm_loadu_si128((const __m128i*)(secret + i * 16)));
+        // Multiply the low and high 32 bits of each keyed lane, and add the lane next to it
+        __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        acc_vec = _mm_add_epi64(acc_vec, _mm_add_epi64(product, swapped));
+        _mm_storeu_si128((__m128i*)(acc + i * 2), acc_vec);
+    }
+#else
+    for (size_t i = 0; i < 8; i++)
+    {
+        uint64_t data = __aclib_hash_read64(stripe + i * 8);
+        uint64_t key = data ^ __aclib_hash_read64(secret + i * 8);
+        acc[i ^ 1] += data;
+        acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+    }
+#endif
+}
+
+/// Scramble the accumulators, so the bits that the multiplications shift out of the low half
+/// are mixed back in
+ACLIBDEF void __aclib_hash_scramble(uint64_t* acc, const uint8_t* secret)
+{
+#ifdef __ACLIB_SSE2
+    __m128i prime = _mm_set1_epi32((int)__ACLIB_HASH_SCRAMBLE_PRIME);
+    for (size_t i = 0; i < 4; i++)
+    {
+        __m128i acc_vec = _mm_loadu_si128((const __m128i*)(acc + i * 2));
+        acc_vec = _mm_xor_si128(acc_vec, _mm_srli_epi64(acc_vec, 47));
+        acc_vec = _mm_xor_si128(acc_vec, _mm_loadu_si128((const __m128i*)(secret + i * 16)));
+        __m128i lo = _mm_mul_epu32(acc_vec, prime);
+        __m128i hi = _mm_mul_epu32(_mm_srli_epi64(acc_vec, 32), prime);
+        acc_vec = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+        _mm_storeu_si128((__m128i*)(acc + i * 2), acc_vec);
+    }
+#else
+    for (size_t i = 0; i < 8; i++)
+    {
+        acc[i] ^= acc[i] >> 47;
+        acc[i] ^= __aclib_hash_read64(secret + i * 8);
+        acc[i] *= __ACLIB_HASH_SCRAMBLE_PRIME;
+    }
+#endif
+}
+
+#ifdef __ACLIB_AVX2
+__attribute__((target("avx2"))) ACLIBDEF void __aclib_avx2_hash_stripes(uint64_t* acc,
+                                                                        const uint8_t* stripes,
+                                                                        size_t count,
+                                                                        size_t* block_pos)
+{
+    __m256i acc_lo = _mm256_loadu_si256((const __m256i*)acc);
+    __m256i acc_hi = _mm256_loadu_si256((const __m256i*)(acc + 4));
+    __m256i prime = _mm256_set1_epi32((int)__ACLIB_HASH_SCRAMBLE_PRIME);
+
+    for (size_t i = 0; i < count; i++, stripes += __ACLIB_HASH_STRIPE_LEN)
+    {
+        const uint8_t* secret = __aclib_hash_secret + *block_pos * 8;
+        __m256i data_lo = _mm256_loadu_si256((const __m256i*)stripes);
+        __m256i data_hi = _mm256_loadu_si256((const __m256i*)(stripes + 32));
+        __m256i key_lo = _mm256_xor_si256(data_lo, _mm256_loadu_si256((const __m256i*)secret));
+        __m256i key_hi =
+            _mm256_xor_si256(data_hi, _mm256_loadu_si256((const __m256i*)(secret + 32)));
+
+        // The same as the SSE2 accumulate, as the shuffles work within each 128 bit half
+        __m256i swap_lo = _mm256_shuffle_epi32(data_lo, _MM_SHUFFLE(1, 0, 3, 2));
+        __m256i swap_hi = _mm256_shuffle_epi32(data_hi, _MM_SHUFFLE(1, 0, 3, 2));
+        __m256i product_lo =
+            _mm256_mul_epu32(key_lo, _mm256_shuffle_epi32(key_lo, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m256i product_hi =
+            _mm256_mul_epu32(key_hi, _mm256_shuffle_epi32(key_hi, _MM_SHUFFLE(0, 3, 0, 1)));
+        acc_lo = _mm256_add_epi64(acc_lo, _mm256_add_epi64(product_lo, swap_lo));
+        acc_hi = _mm256_add_epi64(acc_hi, _mm256_add_epi64(product_hi, swap_hi));
+
+        if (++*block_pos < __ACLIB_HASH_BLOCK_STRIPES)
+            continue;
+        *block_pos = 0;
+
+        const uint8_t* scramble_secret = __aclib_hash_secret + sizeof(__aclib_hash_secret) - 64;
+        __m256i* accs[2] = {&acc_lo, &acc_hi};
+        for (size_t j = 0; j < 2; j++)
+        {
+            __m256i acc_vec = *accs[j];
+            acc_vec = _mm256_xor_si256(acc_vec, _mm256_srli_epi64(acc_vec, 47));
+            acc_vec = _mm256_xor_si256(
+                acc_vec, _mm256_loadu_si256((const __m256i*)(scramble_secret + j * 32)));
+            __m256i lo = _mm256_mul_epu32(acc_vec, prime);
+            __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(acc_vec, 32), prime);
+            *accs[j] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+        }
+    }
+
+    _mm256_storeu_si256((__m256i*)acc, acc_lo);
+    _mm256_storeu_si256((__m256i*)(acc + 4), acc_hi);
+}
+#endif
+
+/// Accumulate count stripes, scrambling the accumulators after every block of stripes. block_pos
+/// is the amount of stripes already accumulated in the current block
+ACLIBDEF void __aclib_hash_stripes(uint64_t* acc, const uint8_t* stripes, size_t count,
+                                   size_t* block_pos)
+{
+#ifdef __ACLIB_AVX2
+    if (count >= 4 && __aclib_has_avx2())
+    {
+        __aclib_avx2_hash_stripes(acc, stripes, count, block_pos);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < count; i++, stripes += __ACLIB_HASH_STRIPE_LEN)
+    {
+        __aclib_hash_accumulate(acc, stripes, __aclib_hash_secret + *block_pos * 8);
+        if (++*block_pos == __ACLIB_HASH_BLOCK_STRIPES)
+        {
+            __aclib_hash_scramble(acc, __aclib_hash_secret + sizeof(__aclib_hash_secret) - 64);
+            *block_pos = 0;
+        }
+    }
+}
+
+/// Set the accumulators to their starting values
+ACLIBDEF void __aclib_hash_init_acc(uint64_t* acc, uint64_t seed)
+{
+    static const uint64_t init[8] = {
+        0x00000000C2B2AE3DULL, 0x9E3779B185EBCA87ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL,
+        0x85EBCA77C2B2AE63ULL, 0x0000000085EBCA77ULL, 0x27D4EB2F165667C5ULL, 0x000000009E3779B1ULL,
+    };
+    for (size_t i = 0; i < 8; i++)
+        acc[i] = i % 2 == 0 ? init[i] + seed : init[i] - seed;
+}
+
+/// Accumulate the last stripe of an input, which may overlap the stripes before it, and merge the
+/// accumulators into the hash
+ACLIBDEF uint64_t __aclib_hash_finish_long(uint64_t* acc, const uint8_t* last_stripe,
+                                           uint64_t len)
+{
+    __aclib_hash_accumulate(acc, last_stripe,
+                            __aclib_hash_secret + sizeof(__aclib_hash_secret) - 64 - 7);
+
+    uint64_t hash = len * 0x9E3779B185EBCA87ULL;
+    for (size_t i = 0; i < 4; i++)
+    {
+        const uint8_t* secret = __aclib_hash_secret + 11 + i * 16;
+        hash += __aclib_hash_mix(acc[i * 2] ^ __aclib_hash_read64(secret),
+                                 acc[i * 2 + 1] ^ __aclib_hash_read64(secret + 8));
+    }
+
+    hash ^= hash >> 37;
+    hash *= 0x165667919E3779F9ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+ACLIBDEF uint64_t ac_str_hash_bytes(const void* bytes, size_t len, uint64_t seed)
+{
+    if (len <= __ACLIB_HASH_SHORT_MAX)
+        return __aclib_hash_short(bytes, len, seed);
+
+    // Every stripe but the last one is accumulated in order, and the last 1 to 64 bytes are
+    // always finished with the last 64 bytes of the input, just like `Ac_StrHasher` does it
+    uint64_t acc[8];
+    size_t block_pos = 0;
+    __aclib_hash_init_acc(acc, seed);
+    __aclib_hash_stripes(acc, bytes, (len - 1) / __ACLIB_HASH_STRIPE_LEN, &block_pos);
+    return __aclib_hash_finish_long(acc, (const uint8_t*)bytes + len - __ACLIB_HASH_STRIPE_LEN,
+                                    len);
+}
+
+ACLIBDEF uint64_t ac_str_hash(Ac_StrSlice slice, uint64_t seed)
+{
+    return ac_str_hash_bytes(slice.chars, slice.len, seed);
+}
+
+ACLIBDEF Ac_StrHasher ac_str_hasher(uint64_t seed)
+{
+    Ac_StrHasher hasher = {.seed = seed};
+    __aclib_hash_init_acc(hasher.acc, seed);
+    return hasher;
+}
+
+ACLIBDEF void ac_str_hasher_update(Ac_StrHasher* hasher, Ac_StrSlice slice)
+{
+    const uint8_t* bytes = (const uint8_t*)slice.chars;
+    size_t len = slice.len;
+    size_t buffer_size = sizeof(hasher->buffer);
+    hasher->len += len;
+
+    if (hasher->buffered + len <= buffer_size)
+    {
+        memcpy(hasher->buffer + hasher->buffered, bytes, len);
+        hasher->buffered += len;
+        return;
+    }
+
+    // The stripes are only accumulated once more bytes follow them, so the buffer always holds the
+    // end of the input, which is hashed differently
+    if (hasher->buffered > 0)
+    {
+        size_t fill = buffer_size - hasher->buffered;
+        memcpy(hasher->buffer + hasher->buffered, bytes, fill);
+        bytes += fill;
+        len -= fill;
+        __aclib_hash_stripes(hasher->acc, hasher->buffer, buffer_size / __ACLIB_HASH_STRIPE_LEN,
+                             &hasher->block_pos);
+        hasher->buffered = 0;
+    }
+
+    if (len > buffer_size)
+    {
+        size_t count = (len - 1) / __ACLIB_HASH_STRIPE_LEN;
+        __aclib_hash_stripes(hasher->acc, bytes, count, &hasher->block_pos);
+        bytes += count * __ACLIB_HASH_STRIPE_LEN;
+        len -= count * __ACLIB_HASH_STRIPE_LEN;
+
+        // Keep the last accumulated stripe, in case the last stripe of the input overlaps it
+        memcpy(hasher->buffer + buffer_size - __ACLIB_HASH_STRIPE_LEN,
+               bytes - __ACLIB_HASH_STRIPE_LEN, __ACLIB_HASH_STRIPE_LEN);
+    }
+
+    memcpy(hasher->buffer, bytes, len);
+    hasher->buffered = len;
+}
+
+ACLIBDEF uint64_t ac_str_hasher_finish(const Ac_StrHasher* hasher)
+{
+    if (hasher->len <= __ACLIB_HASH_SHORT_MAX)
+        return __aclib_hash_short(hasher->buffer, (size_t)hasher->len, hasher->seed);
+
+    uint64_t acc[8];
+    size_t block_pos = hasher->block_pos;
+    memcpy(acc, hasher->acc, sizeof(acc));
+
+    size_t buffered = hasher->buffered;
+    __aclib_hash_stripes(acc, hasher->buffer, (buffered - 1) / __ACLIB_HASH_STRIPE_LEN,
+                         &block_pos);
+    if (buffered >= __ACLIB_HASH_STRIPE_LEN)
+        return __aclib_hash_finish_long(acc, hasher->buffer + buffered - __ACLIB_HASH_STRIPE_LEN,
+                                        hasher->len);
+
+    // The last stripe starts in the bytes that were already accumulated, which are kept at the end
+    // of the buffer
+    uint8_t last_stripe[__ACLIB_HASH_STRIPE_LEN];
+    size_t kept = __ACLIB_HASH_STRIPE_LEN - buffered;
+    memcpy(last_stripe, hasher->buffer + sizeof(hasher->buffer) - kept, kept);
+    memcpy(last_stripe + kept, hasher->buffer, buffered);
+    return __aclib_hash_finish_long(acc, last_stripe, hasher->len);
+}
+
+/* END OF HASH IMPLEMENTATION */
+
+
+
+/*                      *
+ *  MAP IMPLEMENTATION  *
+ *                      */
+
+/// The control byte of a slot that has never held an entry
+#define __ACLIB_MAP_EMPTY ((uint8_t)0x80)
+/// The control byte of a slot whose entry was removed, but which a probe may have passed over
+#define __ACLIB_MAP_DELETED ((uint8_t)0xFE)
+/// The amount of control bytes compared at a time, which is also the smallest capacity of a map
+#define __ACLIB_MAP_GROUP_WIDTH 16
+
+/// Get a mask of the control bytes in a group that are equal to byte
+ACLIBDEF uint32_t __aclib_map_group_match(const uint8_t* group, uint8_t byte)
+{
+#ifdef __ACLIB_SSE2
+    __m128i block = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8((char)byte)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < __ACLIB_MAP_GROUP_WIDTH; i++)
+        mask |= (uint32_t)(group[i] == byte) << i;
+    return mask;
+#endif
+}
+
+/// Get a mask of the control bytes in a group that are empty or deleted, which are the only ones
+/// with the high bit set
+ACLIBDEF uint32_t __aclib_map_group_free(const uint8_t* group)
+{
+#ifdef __ACLIB_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < __ACLIB_MAP_GROUP_WIDTH; i++)
+        mask |= (uint32_t)(group[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+/// Set the control byte of a slot, and its copy after the last slot
+ACLIBDEF void __aclib_map_set_ctrl(Ac_MapCore* map, size_t idx, uint8_t ctrl)
+{
+    map->ctrl[idx] = ctrl;
+    map->ctrl[((idx - __ACLIB_MAP_GROUP_WIDTH) & (map->cap - 1)) + __ACLIB_MAP_GROUP_WIDTH] = ctrl;
+}
+
+/// Find the first empty or deleted slot in the probe sequence of a hash
+ACLIBDEF size_t __aclib_map_find_free(const Ac_MapCore* map, uint64_t hash)
+{
+    size_t mask = map->cap - 1;
+    size_t pos = (size_t)(hash >> 7) & mask;
+    for (size_t stride = __ACLIB_MAP_GROUP_WIDTH;; stride += __ACLIB_MAP_GROUP_WIDTH)
+    {
+        uint32_t free_slots = __aclib_map_group_free(map->ctrl + pos);
+        if (free_slots != 0)
+            return (pos + __builtin_ctz(free_slots)) & mask;
+        pos = (pos + stride) & mask;
+    }
+}
+
+/// The smallest capacity that holds count entries, without going over the max load of 7/8
+ACLIBDEF size_t __aclib_map_cap_for(size_t count)
+{
+    size_t cap = __ACLIB_MAP_GROUP_WIDTH;
+    while (cap - cap / 8 < count)
+        cap *= 2;
+    return cap;
+}
+
+ACLIBDEF size_t __aclib_map_find(const Ac_MapCore* map, const void* key, size_t entry_size,
+                                 size_t key_size, Ac_MapHashFn hash, Ac_MapEqlFn eql)
+{
+    if (map->len == 0)
+        return SIZE_MAX;
+
+    uint64_t key_hash = hash(key, key_size);
+    uint8_t h2 = (uint8_t)(key_hash & 0x7F);
+    size_t mask = map->cap - 1;
+    size_t pos = (size_t)(key_hash >> 7) & mask;
+
+    for (size_t stride = __ACLIB_MAP_GROUP_WIDTH;; stride += __ACLIB_MAP_GROUP_WIDTH)
+    {
+        const uint8_t* group = map->ctrl + pos;
+        for (uint32_t hits = __aclib_map_group_match(group, h2); hits != 0; hits &= hits - 1)
+        {
+            size_t idx = (pos + __builtin_ctz(hits)) & mask;
+            if (eql((const char*)map->entries + idx * entry_size, key, key_size))
+                return idx;
+        }
+
+        // A probe for the key would have stopped at an empty slot, so it can't be any further
+        if (__aclib_map_group_match(group, __ACLIB_MAP_EMPTY) != 0)
+            return SIZE_MAX;
+        pos = (pos + stride) & mask;
+    }
+}
+
+ACLIBDEF size_t __aclib_map_insert_slot(Ac_MapCore* map, const void* key, size_t entry_size,
+                                        size_t key_size, Ac_MapHashFn hash, Ac_MapEqlFn eql)
+{
+    size_t idx = __aclib_map_find(map, key, entry_size, key_size, hash, eql);
+    if (idx != SIZE_MAX)
+        return idx;
+
+    if (map->cap == 0)
+        __aclib_map_resize(map, 1, entry_size, key_size, hash);
+
+    uint64_t key_hash = hash(key, key_size);
+    idx = __aclib_map_find_free(map, key_hash);
+
+    // Reusing a deleted slot doesn't use up any of the empty slots, which keep probes short
+    if (map->growth_left == 0 && map->ctrl[idx] == __ACLIB_MAP_EMPTY)
+    {
+        __aclib_map_resize(map, map->len + 1, entry_size, key_size, hash);
+        idx = __aclib_map_find_free(map, key_hash);
+    }
+
+    if (map->ctrl[idx] == __ACLIB_MAP_EMPTY)
+        map->growth_left--;
+    __aclib_map_set_ctrl(map, idx, (uint8_t)(key_hash & 0x7F));
+    map->len++;
+
+    memcpy((char*)map->entries + idx * entry_size, key, key_size);
+    return idx;
+}
+
+ACLIBDEF void __aclib_map_erase(Ac_MapCore* map, size_t idx)
+{
+    size_t mask = map->cap - 1;
+    size_t idx_before = (idx - __ACLIB_MAP_GROUP_WIDTH) & mask;
+    uint32_t empty_after = __aclib_map_group_match(map->ctrl + idx, __ACLIB_MAP_EMPTY);
+    uint32_t empty_before = __aclib_map_group_match(map->ctrl + idx_before, __ACLIB_MAP_EMPTY);
+
+    // If every run of full or deleted slots around the slot is shorter than a group, every probe
+    // that reached the slot also saw an empty slot and stopped. The slot can then be marked as
+    // empty again, instead of leaving a tombstone
+    bool was_never_full =
+        empty_before != 0 && empty_after != 0 &&
+        (size_t)__builtin_ctz(empty_after) + (size_t)(__builtin_clz(empty_before) - 16) <
+            __ACLIB_MAP_GROUP_WIDTH;
+
+    __aclib_map_set_ctrl(map, idx, was_never_full ? __ACLIB_MAP_EMPTY : __ACLIB_MAP_DELETED);
+    if (was_never_full)
+        map->growth_left++;
+    map->len--;
+}
+
+ACLIBDEF void __aclib_map_resize(Ac_MapCore* map, size_t count, size_t entry_size,
+                                 size_t key_size, Ac_MapHashFn hash)
+{
+    if (count < map->len)
+        count = map->len;
+
+    if (map->allocator == NULL)
+        map->allocator = ac_allocator_current();
+
+    Ac_MapCore old = *map;
+    size_t cap = __aclib_map_cap_for(count);
+
+    // The control bytes and the entries share an allocation. cap is a multiple of 16, so the
+    // entries after the control bytes are aligned to 16 bytes
+    size_t ctrl_size = cap + __ACLIB_MAP_GROUP_WIDTH;
+    map->ctrl = ac_allocator_alloc(map->allocator, ctrl_size + cap * entry_size);
+    if (map->ctrl == NULL)
+    {
+        ac_log(ACLIB_ERR, "Failed to allocate map\n");
+        exit(EXIT_FAILURE);
+    }
+
+    map->entries = map->ctrl + ctrl_size;
+    map->cap = cap;
+    __aclib_map_clear(map);
+
+    for (size_t i = 0; i < old.cap; i++)
+    {
+        if (old.ctrl[i] >= 0x80)
+            continue;
+
+        const char* entry = (const char*)old.entries + i * entry_size;
+        uint64_t key_hash = hash(entry, key_size);
+        size_t idx = __aclib_map_find_free(map, key_hash);
+        __aclib_map_set_ctrl(map, idx, (uint8_t)(key_hash & 0x7F));
+        memcpy((char*)map->entries + idx * entry_size, entry, entry_size);
+    }
+    map->len = old.len;
+    map->growth_left -= old.len;
+
+    ac_allocator_free(map->allocator, old.ctrl);
+}
+
+ACLIBDEF void __aclib_map_clear(Ac_MapCore* map)
+{
+    if (map->cap == 0)
+        return;
+
+    memset(map->ctrl, __ACLIB_MAP_EMPTY, map->cap + __ACLIB_MAP_GROUP_WIDTH);
+    map->len = 0;
+    map->growth_left = map->cap - map->cap / 8;
+}
+
+ACLIBDEF uint64_t ac_map_hash_bytes(const void* key, size_t key_size)
+{
+    return ac_str_hash_bytes(key, key_size, 0);
+}
+
+ACLIBDEF bool ac_map_eql_bytes(const void* a, const void* b, size_t key_size)
+{
+    return memcmp(a, b, key_size) == 0;
+}
+
+ACLIBDEF uint64_t ac_map_hash_str(const void* key, size_t key_size)
+{
+    return ac_str_hash(*(const Ac_StrSlice*)key, 0);
+}
+
+ACLIBDEF bool ac_map_eql_str(const void* a, const void* b, size_t key_size)
+{
+    const Ac_StrSlice* slice_a = a;
+    const Ac_StrSlice* slice_b = b;
+    return slice_a->len == slice_b->len &&
+           memcmp(slice_a->chars, slice_b->chars, slice_a->len) == 0;
+}
+
+/* END OF MAP IMPLEMENTATION */
+
+
+
+/*                         *
+ *  STRING IMPLEMENTATION  *
+ *                         */
+
+/// Get the part of a slice from start to end, without any bounds checks
+#define __aclib_str_sub(slice, start, end) \
+    ((Ac_StrSlice){.chars = (slice).chars + (start), .len = (end) - (start)})
+
+ACLIBDEF Ac_StrSlice ac_str_slice_with_len(size_t len)
+{
+    return (Ac_StrSlice){
+        .chars = (char*)memset(ac_allocator_alloc(NULL, (len + 1) * sizeof(char)), 0,
+                               (len + 1) * sizeof(char)),
+        .len = len,
+    };
+}
+
+ACLIBDEF Ac_StrSlice ac_str_slice_from(char* chs)
+{
+    return (Ac_StrSlice){
+        .chars = chs,
+        .len = strlen(chs),
+    };
+}
+
+ACLIBDEF Ac_StrSlice ac_str_owned_slice(Ac_String str)
+{
+    if (str.cap == 0)
+        return (Ac_StrSlice){0};
+
+    char* buffer = ac_str_clone_chars(str);
+    return ac_str_slice_from(buffer);
+}
+
+ACLIBDEF Ac_StrSlice ac_str_slice_clone(Ac_StrSlice slice)
+{
+    return ac_str_slice_clone_in(NULL, slice);
+}
+
+ACLIBDEF Ac_StrSlice ac_str_slice_range(Ac_String str, size_t start, size_t end)
+{
+    if (start >= str.len || end > str.len || start >= end)
+        return (Ac_StrSlice){0};
+
+    return (Ac_StrSlice){
+        .chars = str.chars + start,
+        .len = end - start,
+    };
+}
+
+ACLIBDEF void ac_str_slice_free(Ac_StrSlice* slice)
+{
+    ac_str_slice_free_in(NULL, slice);
+}
+
+ACLIBDEF Ac_StrSlice ac_arena_str_slice_with_len(Ac_Arena* arena, size_t len)
+{
+    if (arena == NULL)
+        return ac_str_slice_with_len(len);
+
+    return (Ac_StrSlice){
+        .chars = (char*)ac_arena_calloc(arena, len + 1, sizeof(char)),
+        .len = len,
+    };
+}
+
+ACLIBDEF Ac_StrSlice ac_arena_str_slice_clone(Ac_Arena* arena, Ac_StrSlice slice)
+{
+    if (arena == NULL)
+        return ac_str_slice_clone(slice);
+
+    char* chars = (char*)ac_arena_alloc_aligned(arena, (slice.len + 1) * sizeof(char), 1);
+    memcpy(chars, slice.chars, slice.len * sizeof(char));
+
+    chars[slice.len] = '\0';
+    return (Ac_StrSlice){.chars = chars, .len = slice.len};
+}
+
+ACLIBDEF Ac_StrSlice ac_str_slice_clone_in(const Ac_Allocator* allocator, Ac_StrSlice slice)
+{
+    char* chars = (char*)ac_allocator_alloc(allocator, (slice.len + 1) * sizeof(char));
+    memcpy(chars, slice.chars, slice.len * sizeof(char));
+
+    chars[slice.len] = '\0';
+    return (Ac_StrSlice){.chars = chars, .len = slice.len};
+}
+
+ACLIBDEF void ac_str_slice_free_in(const Ac_Allocator* allocator, Ac_StrSlice* slice)
+{
+    ac_allocator_free(allocator, slice->chars);
+    slice->len = 0;
+}
+
+ACLIBDEF Ac_String ac_str_with_capacity(size_t capacity)
+{
+    const Ac_Allocator* allocator = ac_allocator_current();
+    return (Ac_String){
+        .chars = (char*)memset(ac_allocator_alloc(allocator, (capacity + 1) * sizeof(char)), 0,
+                               (capacity + 1) * sizeof(char)),
+        .len = 0,
+        .cap = capacity,
+        .allocator = allocator,
+    };
+}
+
+ACLIBDEF Ac_String ac_str_from(char* chs)
+{
+    Ac_String str = {0};
+    ac_str_append(&str, chs);
+    return str;
+}
+
+ACLIBDEF void ac_str_push(Ac_String* str, char ch)
+{
+    ac_str_ensure_cap(str, str->len + 1);
+
+    str->chars[str->len] = ch;
+    str->chars[str->len + 1] = '\0';
+    str->len += 1;
+}
+
+ACLIBDEF void ac_str_unshift(Ac_String* str, char ch)
 {
     ac_str_ensure_cap(str, str->len + 1);
     memmove(str->chars + 1, str->chars, str->len * sizeof(char));
@@ -1012,487 +4528,3283 @@ ACLIBDEF void ac_str_unshift(Ac_String* str, char ch)
     str->chars[str->len] = '\0';
 }
 
-ACLIBDEF void ac_str_append(Ac_String* str, char* chs)
+ACLIBDEF void ac_str_append(Ac_String* str, char* chs)
+{
+    ac_str_append_slice(str, ac_str_slice_from(chs));
+}
+
+ACLIBDEF void ac_str_append_slice(Ac_String* str, Ac_StrSlice slice)
+{
+    ac_str_ensure_cap(str, str->len + slice.len);
+
+    if (slice.len > 0)
+        memcpy(str->chars + str->len, slice.chars, slice.len);
+
+    str->len += slice.len;
+    str->chars[str->len] = '\0';
+}
+
+/// Format unto the end of a string. The chars are formatted straight into the string's spare
+/// capacity, and only formatted a second time if they didn't fit
+ACLIBDEF void __aclib_str_vappendf(Ac_String* str, const char* fmt, va_list args)
+{
+    // The formatted chars are rarely shorter than the format, so make room for those up front
+    ac_str_ensure_cap(str, str->len + strlen(fmt));
+
+    va_list retry_args;
+    va_copy(retry_args, args);
+
+    size_t spare = str->cap - str->len;
+    int written = vsnprintf(str->chars + str->len, spare + 1, fmt, args);
+    if (written < 0)
+    {
+        str->chars[str->len] = '\0';
+        va_end(retry_args);
+        return;
+    }
+
+    if ((size_t)written > spare)
+    {
+        ac_str_ensure_cap(str, str->len + written);
+        vsnprintf(str->chars + str->len, written + 1, fmt, retry_args);
+    }
+    va_end(retry_args);
+
+    str->len += written;
+}
+
+ACLIBDEF void ac_str_appendf(Ac_String* str, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    __aclib_str_vappendf(str, fmt, args);
+    va_end(args);
+}
+
+ACLIBDEF void ac_str_prepend(Ac_String* str, char* chs)
+{
+    size_t size = strlen(chs);
+    ac_str_ensure_cap(str, str->len + size);
+
+    memmove(str->chars + size, str->chars, str->len * sizeof(char));
+    memcpy(str->chars, chs, size * sizeof(char));
+
+    str->chars[str->len + size] = '\0';
+    str->len += size;
+}
+
+/// Reverse the order of a range of chars in place
+ACLIBDEF void __aclib_reverse_chars(char* chars, size_t len)
+{
+    for (size_t i = 0, j = len; i + 1 < j; i++, j--)
+    {
+        char tmp = chars[i];
+        chars[i] = chars[j - 1];
+        chars[j - 1] = tmp;
+    }
+}
+
+ACLIBDEF void ac_str_prependf(Ac_String* str, const char* fmt, ...)
+{
+    size_t old_len = str->len;
+
+    va_list args;
+    va_start(args, fmt);
+    __aclib_str_vappendf(str, fmt, args);
+    va_end(args);
+
+    size_t size = str->len - old_len;
+    if (size == 0)
+        return;
+
+    // The formatted chars are now after the old ones, so rotate them to the front in place. Short
+    // ones are held on the stack while the old chars are moved up, long ones are rotated by
+    // reversing both parts and then the whole
+    char held[256];
+    if (size <= sizeof(held))
+    {
+        memcpy(held, str->chars + old_len, size * sizeof(char));
+        memmove(str->chars + size, str->chars, old_len * sizeof(char));
+        memcpy(str->chars, held, size * sizeof(char));
+    }
+    else
+    {
+        __aclib_reverse_chars(str->chars, old_len);
+        __aclib_reverse_chars(str->chars + old_len, size);
+        __aclib_reverse_chars(str->chars, str->len);
+    }
+
+    str->chars[str->len] = '\0';
+}
+
+/// Every pair of decimal digits from "00" to "99", so integers can be written two digits at a time
+static const char __aclib_digit_pairs[] = "00010203040506070809"
+                                          "10111213141516171819"
+                                          "20212223242526272829"
+                                          "30313233343536373839"
+                                          "40414243444546474849"
+                                          "50515253545556575859"
+                                          "60616263646566676869"
+                                          "70717273747576777879"
+                                          "80818283848586878889"
+                                          "90919293949596979899";
+
+/// Count the decimal digits of an integer
+ACLIBDEF size_t __aclib_count_digits(uint64_t value)
+{
+    size_t digits = 1;
+    for (;;)
+    {
+        if (value < 10)
+            return digits;
+        if (value < 100)
+            return digits + 1;
+        if (value < 1000)
+            return digits + 2;
+        if (value < 10000)
+            return digits + 3;
+        value /= 10000;
+        digits += 4;
+    }
+}
+
+/// Write the decimal digits of an integer backwards, so the last digit is right before end
+ACLIBDEF void __aclib_write_digits(char* end, uint64_t value)
+{
+    while (value >= 100)
+    {
+        const char* pair = __aclib_digit_pairs + (value % 100) * 2;
+        value /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+
+    if (value >= 10)
+    {
+        *--end = __aclib_digit_pairs[value * 2 + 1];
+        *--end = __aclib_digit_pairs[value * 2];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+}
+
+/// Append an integer's magnitude in decimal or hex, with a '-' if it's negative, padded to width
+ACLIBDEF void __aclib_str_append_int(Ac_String* str, uint64_t magnitude, bool negative, bool hex,
+                                     size_t width, char pad)
+{
+    size_t digits = hex ? (size_t)(64 - __builtin_clzll(magnitude | 1) + 3) / 4
+                        : __aclib_count_digits(magnitude);
+    size_t size = digits + negative;
+    size_t padding = width > size ? width - size : 0;
+
+    ac_str_ensure_cap(str, str->len + padding + size);
+    char* out = str->chars + str->len;
+
+    // A '0' pad goes between the sign and the digits, any other pad goes before the sign
+    if (negative && pad == '0')
+        *out++ = '-';
+    memset(out, pad, padding);
+    out += padding;
+    if (negative && pad != '0')
+        *out++ = '-';
+
+    if (hex)
+    {
+        for (size_t i = digits; i > 0; i--, magnitude >>= 4)
+            out[i - 1] = "0123456789abcdef"[magnitude & 0xF];
+    }
+    else
+    {
+        __aclib_write_digits(out + digits, magnitude);
+    }
+
+    str->len += padding + size;
+    str->chars[str->len] = '\0';
+}
+
+ACLIBDEF void ac_str_append_i64(Ac_String* str, int64_t value)
+{
+    // Negate as unsigned, so INT64_MIN doesn't overflow
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    __aclib_str_append_int(str, magnitude, value < 0, false, 0, ' ');
+}
+
+ACLIBDEF void ac_str_append_u64(Ac_String* str, uint64_t value)
+{
+    __aclib_str_append_int(str, value, false, false, 0, ' ');
+}
+
+ACLIBDEF void ac_str_append_u64_hex(Ac_String* str, uint64_t value)
+{
+    __aclib_str_append_int(str, value, false, true, 0, ' ');
+}
+
+ACLIBDEF void ac_str_append_i64_padded(Ac_String* str, int64_t value, size_t width, char pad)
+{
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    __aclib_str_append_int(str, magnitude, value < 0, false, width, pad);
+}
+
+ACLIBDEF void ac_str_append_u64_padded(Ac_String* str, uint64_t value, size_t width, char pad)
+{
+    __aclib_str_append_int(str, value, false, false, width, pad);
+}
+
+ACLIBDEF void ac_str_append_u64_hex_padded(Ac_String* str, uint64_t value, size_t width,
+                                           char pad)
+{
+    __aclib_str_append_int(str, value, false, true, width, pad);
+}
+
+/// A big unsigned integer for the exact slow paths of writing and parsing doubles, in 32-bit limbs
+/// from the least significant. The numbers they use stay below 2^2560
+typedef struct __Aclib_BigInt
+{
+    uint32_t limbs[96];
+    size_t len;
+} __Aclib_BigInt;
+
+ACLIBDEF __Aclib_BigInt __aclib_bigint_from_u64(uint64_t value)
+{
+    __Aclib_BigInt big = {.limbs = {(uint32_t)value, (uint32_t)(value >> 32)}};
+    big.len = value >> 32 ? 2 : value != 0;
+    return big;
+}
+
+ACLIBDEF void __aclib_bigint_mul_add(__Aclib_BigInt* big, uint32_t mul, uint32_t add)
+{
+    uint64_t carry = add;
+    for (size_t i = 0; i < big->len; i++)
+    {
+        carry += (uint64_t)big->limbs[i] * mul;
+        big->limbs[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (carry != 0 && big->len < sizeof(big->limbs) / sizeof(big->limbs[0]))
+        big->limbs[big->len++] = (uint32_t)carry;
+}
+
+ACLIBDEF void __aclib_bigint_mul_pow5(__Aclib_BigInt* big, int64_t exp)
+{
+    // 5^13 is the largest power of five that fits in a limb
+    for (; exp >= 13; exp -= 13)
+        __aclib_bigint_mul_add(big, 1220703125, 0);
+
+    uint32_t pow5 = 1;
+    for (; exp > 0; exp--)
+        pow5 *= 5;
+    __aclib_bigint_mul_add(big, pow5, 0);
+}
+
+ACLIBDEF void __aclib_bigint_shift_left(__Aclib_BigInt* big, int64_t shift)
+{
+    size_t max_len = sizeof(big->limbs) / sizeof(big->limbs[0]);
+    size_t limbs = (size_t)shift / 32;
+    int bits = (int)(shift % 32);
+    if (big->len == 0 || big->len + limbs >= max_len)
+        return;
+
+    if (bits != 0)
+    {
+        uint32_t carry = 0;
+        for (size_t i = 0; i < big->len; i++)
+        {
+            uint32_t limb = big->limbs[i];
+            big->limbs[i] = (limb << bits) | carry;
+            carry = limb >> (32 - bits);
+        }
+        if (carry != 0)
+            big->limbs[big->len++] = carry;
+    }
+
+    memmove(big->limbs + limbs, big->limbs, big->len * sizeof(big->limbs[0]));
+    memset(big->limbs, 0, limbs * sizeof(big->limbs[0]));
+    big->len += limbs;
+}
+
+/// a += b
+ACLIBDEF void __aclib_bigint_add(__Aclib_BigInt* a, const __Aclib_BigInt* b)
+{
+    size_t max_len = sizeof(a->limbs) / sizeof(a->limbs[0]);
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < b->len || (carry != 0 && i < max_len); i++)
+    {
+        carry += (uint64_t)(i < a->len ? a->limbs[i] : 0) + (i < b->len ? b->limbs[i] : 0);
+        a->limbs[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (i > a->len)
+        a->len = i;
+}
+
+/// a -= b * mul, where a >= b * mul
+ACLIBDEF void __aclib_bigint_sub_mul(__Aclib_BigInt* a, const __Aclib_BigInt* b, uint32_t mul)
+{
+    uint64_t carry = 0;
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a->len; i++)
+    {
+        carry += (uint64_t)(i < b->len ? b->limbs[i] : 0) * mul;
+        borrow += (int64_t)a->limbs[i] - (uint32_t)carry;
+        carry >>= 32;
+        a->limbs[i] = (uint32_t)borrow;
+        borrow = borrow < 0 ? -1 : 0;
+    }
+    while (a->len > 0 && a->limbs[a->len - 1] == 0)
+        a->len--;
+}
+
+ACLIBDEF int __aclib_bigint_cmp(const __Aclib_BigInt* a, const __Aclib_BigInt* b)
+{
+    if (a->len != b->len)
+        return a->len < b->len ? -1 : 1;
+
+    for (size_t i = a->len; i-- > 0;)
+    {
+        if (a->limbs[i] != b->limbs[i])
+            return a->limbs[i] < b->limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+/// Compare a + b with c
+ACLIBDEF int __aclib_bigint_cmp_sum(const __Aclib_BigInt* a, const __Aclib_BigInt* b,
+                                   const __Aclib_BigInt* c)
+{
+    __Aclib_BigInt sum;
+    sum.len = a->len;
+    memcpy(sum.limbs, a->limbs, a->len * sizeof(a->limbs[0]));
+    __aclib_bigint_add(&sum, b);
+    return __aclib_bigint_cmp(&sum, c);
+}
+
+// Doubles are written with Grisu3 (Loitsch, "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers"). It finds the shortest digits that parse back to the same double
+// using only 64-bit integer math, and detects the ~0.5% of doubles where that math is too
+// imprecise to be sure. Those are written with the exact big integer algorithm from Burger and
+// Dybvig, "Printing Floating-Point Numbers Quickly and Accurately".
+
+/// A floating point number with a 64-bit significand, i.e. f * 2^e
+typedef struct __Aclib_DiyFp
+{
+    uint64_t f;
+    int e;
+} __Aclib_DiyFp;
+
+/// The normalized powers of ten from 10^-348 to 10^340 in steps of 8
+static const __Aclib_DiyFp __aclib_cached_pow10s[] = {
+    {0xfa8fd5a0081c0288ULL, -1220}, {0xbaaee17fa23ebf76ULL, -1193}, {0x8b16fb203055ac76ULL, -1166},
+    {0xcf42894a5dce35eaULL, -1140}, {0x9a6bb0aa55653b2dULL, -1113}, {0xe61acf033d1a45dfULL, -1087},
+    {0xab70fe17c79ac6caULL, -1060}, {0xff77b1fcbebcdc4fULL, -1034}, {0xbe5691ef416bd60cULL, -1007},
+    {0x8dd01fad907ffc3cULL, -980}, {0xd3515c2831559a83ULL, -954}, {0x9d71ac8fada6c9b5ULL, -927},
+    {0xea9c227723ee8bcbULL, -901}, {0xaecc49914078536dULL, -874}, {0x823c12795db6ce57ULL, -847},
+    {0xc21094364dfb5637ULL, -821}, {0x9096ea6f3848984fULL, -794}, {0xd77485cb25823ac7ULL, -768},
+    {0xa086cfcd97bf97f4ULL, -741}, {0xef340a98172aace5ULL, -715}, {0xb23867fb2a35b28eULL, -688},
+    {0x84c8d4dfd2c63f3bULL, -661}, {0xc5dd44271ad3cdbaULL, -635}, {0x936b9fcebb25c996ULL, -608},
+    {0xdbac6c247d62a584ULL, -582}, {0xa3ab66580d5fdaf6ULL, -555}, {0xf3e2f893dec3f126ULL, -529},
+    {0xb5b5ada8aaff80b8ULL, -502}, {0x87625f056c7c4a8bULL, -475}, {0xc9bcff6034c13053ULL, -449},
+    {0x964e858c91ba2655ULL, -422}, {0xdff9772470297ebdULL, -396}, {0xa6dfbd9fb8e5b88fULL, -369},
+    {0xf8a95fcf88747d94ULL, -343}, {0xb94470938fa89bcfULL, -316}, {0x8a08f0f8bf0f156bULL, -289},
+    {0xcdb02555653131b6ULL, -263}, {0x993fe2c6d07b7facULL, -236}, {0xe45c10c42a2b3b06ULL, -210},
+    {0xaa242499697392d3ULL, -183}, {0xfd87b5f28300ca0eULL, -157}, {0xbce5086492111aebULL, -130},
+    {0x8cbccc096f5088ccULL, -103}, {0xd1b71758e219652cULL, -77}, {0x9c40000000000000ULL, -50},
+    {0xe8d4a51000000000ULL, -24}, {0xad78ebc5ac620000ULL, 3}, {0x813f3978f8940984ULL, 30},
+    {0xc097ce7bc90715b3ULL, 56}, {0x8f7e32ce7bea5c70ULL, 83}, {0xd5d238a4abe98068ULL, 109},
+    {0x9f4f2726179a2245ULL, 136}, {0xed63a231d4c4fb27ULL, 162}, {0xb0de65388cc8ada8ULL, 189},
+    {0x83c7088e1aab65dbULL, 216}, {0xc45d1df942711d9aULL, 242}, {0x924d692ca61be758ULL, 269},
+    {0xda01ee641a708deaULL, 295}, {0xa26da3999aef774aULL, 322}, {0xf209787bb47d6b85ULL, 348},
+    {0xb454e4a179dd1877ULL, 375}, {0x865b86925b9bc5c2ULL, 402}, {0xc83553c5c8965d3dULL, 428},
+    {0x952ab45cfa97a0b3ULL, 455}, {0xde469fbd99a05fe3ULL, 481}, {0xa59bc234db398c25ULL, 508},
+    {0xf6c69a72a3989f5cULL, 534}, {0xb7dcbf5354e9beceULL, 561}, {0x88fcf317f22241e2ULL, 588},
+    {0xcc20ce9bd35c78a5ULL, 614}, {0x98165af37b2153dfULL, 641}, {0xe2a0b5dc971f303aULL, 667},
+    {0xa8d9d1535ce3b396ULL, 694}, {0xfb9b7cd9a4a7443cULL, 720}, {0xbb764c4ca7a44410ULL, 747},
+    {0x8bab8eefb6409c1aULL, 774}, {0xd01fef10a657842cULL, 800}, {0x9b10a4e5e9913129ULL, 827},
+    {0xe7109bfba19c0c9dULL, 853}, {0xac2820d9623bf429ULL, 880}, {0x80444b5e7aa7cf85ULL, 907},
+    {0xbf21e44003acdd2dULL, 933}, {0x8e679c2f5e44ff8fULL, 960}, {0xd433179d9c8cb841ULL, 986},
+    {0x9e19db92b4e31ba9ULL, 1013}, {0xeb96bf6ebadf77d9ULL, 1039}, {0xaf87023b9bf0ee6bULL, 1066},
+};
+
+/// Powers of ten that fit in 64 bits
+static const uint64_t __aclib_pow10s[] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+/// Multiply two DiyFps, rounding the product's lower 64 bits away
+ACLIBDEF __Aclib_DiyFp __aclib_diyfp_mul(__Aclib_DiyFp a, __Aclib_DiyFp b)
+{
+    uint64_t a_hi = a.f >> 32, a_lo = a.f & 0xFFFFFFFF;
+    uint64_t b_hi = b.f >> 32, b_lo = b.f & 0xFFFFFFFF;
+    uint64_t hi_hi = a_hi * b_hi, lo_hi = a_lo * b_hi, hi_lo = a_hi * b_lo, lo_lo = a_lo * b_lo;
+
+    uint64_t mid = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + (lo_hi & 0xFFFFFFFF) + (1ULL << 31);
+    return (__Aclib_DiyFp){
+        .f = hi_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid >> 32),
+        .e = a.e + b.e + 64,
+    };
+}
+
+/// Shift a DiyFp's significand up until its top bit is set
+ACLIBDEF __Aclib_DiyFp __aclib_diyfp_normalize(__Aclib_DiyFp x)
+{
+    int shift = __builtin_clzll(x.f);
+    return (__Aclib_DiyFp){.f = x.f << shift, .e = x.e - shift};
+}
+
+/// Move the last digit of the digits down, while that brings them closer to the exact value and
+/// keeps them within the rounding interval. Every distance here is only known to within a unit,
+/// so returns false when the digits might not be the closest, or might be outside the interval
+ACLIBDEF bool __aclib_grisu_round_weed(char* digits, size_t len, uint64_t dist, uint64_t delta,
+                                       uint64_t rest, uint64_t ten_kappa, uint64_t unit)
+{
+    uint64_t small_dist = dist - unit;
+    uint64_t big_dist = dist + unit;
+    while (rest < small_dist && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < small_dist || small_dist - rest >= rest + ten_kappa - small_dist))
+    {
+        digits[len - 1]--;
+        rest += ten_kappa;
+    }
+
+    // Moving the digit down once more could be closer to the exact value if it were up to a unit
+    // further away
+    if (rest < big_dist && delta - rest >= ten_kappa &&
+        (rest + ten_kappa < big_dist || big_dist - rest > rest + ten_kappa - big_dist))
+    {
+        return false;
+    }
+
+    // The digits have to be at least a unit inside the rounding interval on both sides
+    return 2 * unit <= rest && rest <= delta - 4 * unit;
+}
+
+/// Write the shortest digits of a positive finite double, and return how many were written.
+/// The double is then digits * 10^exp10. Returns 0 when the digits can't be found precisely
+ACLIBDEF size_t __aclib_grisu3(double value, char* digits, int* exp10)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t biased_e = (bits >> 52) & 0x7FF;
+    uint64_t significand = bits & ((1ULL << 52) - 1);
+
+    // Subnormal doubles have no hidden bit, and the same exponent as the smallest normal ones
+    __Aclib_DiyFp v = {.f = significand, .e = -1074};
+    if (biased_e != 0)
+        v = (__Aclib_DiyFp){.f = significand | (1ULL << 52), .e = (int)biased_e - 1075};
+
+    // The boundaries halfway to the neighbouring doubles. The lower one is closer when the
+    // significand is a power of two, since the exponent below has a finer spacing
+    __Aclib_DiyFp upper = {.f = (v.f << 1) + 1, .e = v.e - 1};
+    upper = __aclib_diyfp_normalize(upper);
+    __Aclib_DiyFp lower = v.f == (1ULL << 52) ? (__Aclib_DiyFp){.f = (v.f << 2) - 1, .e = v.e - 2}
+                                               : (__Aclib_DiyFp){.f = (v.f << 1) - 1, .e = v.e - 1};
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    // Pick the cached power of ten that scales the upper boundary's exponent into [-60, -32]
+    double k_estimate = (-61 - upper.e) * 0.30102999566398114 + 347;
+    int k = (int)k_estimate;
+    if (k_estimate - k > 0.0)
+        k++;
+    size_t index = (size_t)(k >> 3) + 1;
+    __Aclib_DiyFp cached = __aclib_cached_pow10s[index];
+    *exp10 = -(-348 + (int)index * 8);
+
+    __Aclib_DiyFp w = __aclib_diyfp_mul(__aclib_diyfp_normalize(v), cached);
+    __Aclib_DiyFp w_upper = __aclib_diyfp_mul(upper, cached);
+    __Aclib_DiyFp w_lower = __aclib_diyfp_mul(lower, cached);
+
+    // The scaled values are each off by up to a unit, so generate digits of the upper boundary
+    // until they are within the interval widened by a unit on both sides, first from its integer
+    // part and then from its fraction. Whether they are really within it is checked when rounding
+    uint64_t unit = 1;
+    uint64_t too_high = w_upper.f + unit;
+    uint64_t delta = too_high - (w_lower.f - unit);
+    uint64_t dist = too_high - w.f;
+    int shift = -w_upper.e;
+    uint64_t one = 1ULL << shift;
+    uint32_t integral = (uint32_t)(too_high >> shift);
+    uint64_t fraction = too_high & (one - 1);
+
+    size_t len = 0;
+    int kappa = (int)__aclib_count_digits(integral);
+    while (kappa > 0)
+    {
+        uint32_t pow10 = (uint32_t)__aclib_pow10s[kappa - 1];
+        uint32_t digit = integral / pow10;
+        integral %= pow10;
+        if (digit != 0 || len != 0)
+            digits[len++] = (char)('0' + digit);
+        kappa--;
+
+        uint64_t rest = ((uint64_t)integral << shift) + fraction;
+        if (rest < delta)
+        {
+            *exp10 += kappa;
+            uint64_t ten_kappa = __aclib_pow10s[kappa] << shift;
+            return __aclib_grisu_round_weed(digits, len, dist, delta, rest, ten_kappa, unit) ? len
+                                                                                             : 0;
+        }
+    }
+
+    for (;;)
+    {
+        fraction *= 10;
+        delta *= 10;
+        unit *= 10;
+        char digit = (char)(fraction >> shift);
+        if (digit != 0 || len != 0)
+            digits[len++] = (char)('0' + digit);
+        fraction &= one - 1;
+        kappa--;
+
+        if (fraction < delta)
+        {
+            *exp10 += kappa;
+            return __aclib_grisu_round_weed(digits, len, dist * unit, delta, fraction, one, unit)
+                       ? len
+                       : 0;
+        }
+    }
+}
+
+/// Write the shortest digits of a positive finite double like `__aclib_grisu3()` does, but exactly
+/// with big integers, so it works for every double
+ACLIBDEF size_t __aclib_shortest_digits_exact(double value, char* digits, int* exp10)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int biased_e = (int)((bits >> 52) & 0x7FF);
+    uint64_t f = bits & ((1ULL << 52) - 1);
+    int e = -1074;
+    if (biased_e != 0)
+    {
+        f |= 1ULL << 52;
+        e = biased_e - 1075;
+    }
+
+    // The double is r / s, and the boundaries halfway to its neighbours are (r - m_minus) / s and
+    // (r + m_plus) / s. Those are in the rounding interval when the significand is even, since
+    // ties parse to the even double
+    bool lower_is_closer = f == (1ULL << 52) && biased_e > 1;
+    bool even = (f & 1) == 0;
+    __Aclib_BigInt r = __aclib_bigint_from_u64(f);
+    __Aclib_BigInt s = __aclib_bigint_from_u64(1);
+    __Aclib_BigInt m_plus = __aclib_bigint_from_u64(1);
+    __Aclib_BigInt m_minus = __aclib_bigint_from_u64(1);
+    __aclib_bigint_shift_left(&r, lower_is_closer ? 2 : 1);
+    __aclib_bigint_shift_left(&s, lower_is_closer ? 2 : 1);
+    __aclib_bigint_shift_left(&m_plus, lower_is_closer ? 1 : 0);
+    if (e >= 0)
+    {
+        __aclib_bigint_shift_left(&r, e);
+        __aclib_bigint_shift_left(&m_plus, e);
+        __aclib_bigint_shift_left(&m_minus, e);
+    }
+    else
+    {
+        __aclib_bigint_shift_left(&s, -e);
+    }
+
+    // Scale by 10^k so that the upper boundary is just below one, with k estimated from the
+    // highest bit and then corrected
+    int highest_bit = e + 63 - __builtin_clzll(f);
+    double k_estimate = highest_bit * 0.30102999566398114 - 1e-10;
+    int k = (int)k_estimate;
+    if (k_estimate - k > 0.0)
+        k++;
+    if (k >= 0)
+    {
+        __aclib_bigint_mul_pow5(&s, k);
+        __aclib_bigint_shift_left(&s, k);
+    }
+    else
+    {
+        __aclib_bigint_mul_pow5(&r, -k);
+        __aclib_bigint_shift_left(&r, -k);
+        __aclib_bigint_mul_pow5(&m_plus, -k);
+        __aclib_bigint_shift_left(&m_plus, -k);
+        __aclib_bigint_mul_pow5(&m_minus, -k);
+        __aclib_bigint_shift_left(&m_minus, -k);
+    }
+
+    int cmp = __aclib_bigint_cmp_sum(&r, &m_plus, &s);
+    if (cmp > 0 || (cmp == 0 && even))
+    {
+        __aclib_bigint_mul_add(&s, 10, 0);
+        k++;
+    }
+
+    // Shift everything until the top limb of s has at least 28 bits, so that dividing the top limbs
+    // of r by it is at most one below the next digit
+    int top_shift = __builtin_clz(s.limbs[s.len - 1]) - 4;
+    if (top_shift > 0)
+    {
+        __aclib_bigint_shift_left(&r, top_shift);
+        __aclib_bigint_shift_left(&s, top_shift);
+        __aclib_bigint_shift_left(&m_plus, top_shift);
+        __aclib_bigint_shift_left(&m_minus, top_shift);
+    }
+
+    // Generate digits until the rest of the number is within one of the boundaries, and then round
+    // the last digit to whichever side is closer
+    size_t len = 0;
+    for (;;)
+    {
+        __aclib_bigint_mul_add(&r, 10, 0);
+        __aclib_bigint_mul_add(&m_plus, 10, 0);
+        __aclib_bigint_mul_add(&m_minus, 10, 0);
+
+        uint64_t r_top = r.len > s.len ? (uint64_t)r.limbs[s.len] << 32 : 0;
+        if (r.len >= s.len)
+            r_top |= r.limbs[s.len - 1];
+        char digit = (char)(r_top / ((uint64_t)s.limbs[s.len - 1] + 1));
+        __aclib_bigint_sub_mul(&r, &s, (uint32_t)digit);
+        while (__aclib_bigint_cmp(&r, &s) >= 0)
+        {
+            __aclib_bigint_sub_mul(&r, &s, 1);
+            digit++;
+        }
+
+        cmp = __aclib_bigint_cmp(&r, &m_minus);
+        bool low_ok = cmp < 0 || (cmp == 0 && even);
+        cmp = __aclib_bigint_cmp_sum(&r, &m_plus, &s);
+        bool high_ok = cmp > 0 || (cmp == 0 && even);
+
+        if (low_ok && high_ok)
+        {
+            // Both are in the interval, so compare 2 * r with s, with ties going to the even digit
+            cmp = __aclib_bigint_cmp_sum(&r, &r, &s);
+            digit += cmp > 0 || (cmp == 0 && (digit & 1));
+        }
+        else if (high_ok)
+        {
+            digit++;
+        }
+
+        digits[len++] = (char)('0' + digit);
+        if (low_ok || high_ok)
+            break;
+    }
+
+    *exp10 = k - (int)len;
+    return len;
+}
+
+ACLIBDEF void ac_str_append_f64(Ac_String* str, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bool negative = bits >> 63;
+    bool finite = ((bits >> 52) & 0x7FF) != 0x7FF;
+
+    if (!finite)
+    {
+        bool nan = (bits & ((1ULL << 52) - 1)) != 0;
+        ac_str_append(str, nan ? "nan" : negative ? "-inf" : "inf");
+        return;
+    }
+
+    // The longest output is e.g. "-0.0000012345678901234567", or "-1.2345678901234567e-308"
+    ac_str_ensure_cap(str, str->len + 32);
+    char* out = str->chars + str->len;
+    if (negative)
+        *out++ = '-';
+
+    if ((bits << 1) == 0)
+    {
+        *out++ = '0';
+        str->len = out - str->chars;
+        str->chars[str->len] = '\0';
+        return;
+    }
+
+    int exp10;
+    int len = (int)__aclib_grisu3(negative ? -value : value, out, &exp10);
+    if (len == 0)
+        len = (int)__aclib_shortest_digits_exact(negative ? -value : value, out, &exp10);
+
+    // The double is 0.digits * 10^point. Write it like e.g. JavaScript does, without an exponent
+    // from 1e-6 up to 1e21
+    int point = len + exp10;
+    if (exp10 >= 0 && point <= 21)
+    {
+        // e.g. 1234e7 -> 12340000000
+        memset(out + len, '0', exp10);
+        out += point;
+    }
+    else if (point > 0 && point <= 21)
+    {
+        // e.g. 1234e-2 -> 12.34
+        memmove(out + point + 1, out + point, len - point);
+        out[point] = '.';
+        out += len + 1;
+    }
+    else if (point > -6 && point <= 0)
+    {
+        // e.g. 1234e-6 -> 0.001234
+        int zeros = -point;
+        memmove(out + 2 + zeros, out, len);
+        out[0] = '0';
+        out[1] = '.';
+        memset(out + 2, '0', zeros);
+        out += 2 + zeros + len;
+    }
+    else
+    {
+        // e.g. 1234e30 -> 1.234e+33
+        if (len > 1)
+        {
+            memmove(out + 2, out + 1, len - 1);
+            out[1] = '.';
+            out += len + 1;
+        }
+        else
+        {
+            out += 1;
+        }
+
+        int exp = point - 1;
+        *out++ = 'e';
+        *out++ = exp < 0 ? '-' : '+';
+        uint64_t exp_magnitude = exp < 0 ? -exp : exp;
+        size_t exp_digits = __aclib_count_digits(exp_magnitude);
+        __aclib_write_digits(out + exp_digits, exp_magnitude);
+        out += exp_digits;
+    }
+
+    str->len = out - str->chars;
+    str->chars[str->len] = '\0';
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/// Checks if all 8 chars in a word are digits
+#define __aclib_swar_is_8_digits(word)                                                         \
+    ((((word) & 0xF0F0F0F0F0F0F0F0ULL) |                                                       \
+      ((((word) + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==                    \
+     0x3333333333333333ULL)
+
+/// Parse the 8 digits in a word, with the first digit in the lowest byte
+ACLIBDEF uint64_t __aclib_swar_parse_8_digits(uint64_t word)
+{
+    // Combine neighbouring digits into pairs, then pairs into 4 digits, and those into all 8
+    word -= 0x3030303030303030ULL;
+    word = word * 10 + (word >> 8);
+    word = ((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+            ((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >>
+           32;
+    return (uint32_t)word;
+}
+#endif
+
+/// Parse the digits at chars[*i] into an integer, moving i past them.
+/// Returns EINVAL if there are no digits, ERANGE if they don't fit, and 0 otherwise
+ACLIBDEF int __aclib_parse_magnitude(const char* chars, size_t len, size_t* i, uint64_t* value)
+{
+    size_t start = *i;
+    uint64_t magnitude = 0;
+
+    while (*i < len && chars[*i] == '0')
+        (*i)++;
+
+#ifdef __aclib_swar_is_8_digits
+    // Up to 19 digits always fit, so eight at a time can't overflow until then
+    size_t significant = *i;
+    while (*i + 8 <= len && *i + 8 - significant <= 19)
+    {
+        uint64_t word;
+        memcpy(&word, chars + *i, sizeof(word));
+        if (!__aclib_swar_is_8_digits(word))
+            break;
+        magnitude = magnitude * 100000000 + __aclib_swar_parse_8_digits(word);
+        *i += 8;
+    }
+#endif
+
+    for (; *i < len && ac_ascii_is_numeric(chars[*i]); (*i)++)
+    {
+        if (__builtin_mul_overflow(magnitude, 10, &magnitude) ||
+            __builtin_add_overflow(magnitude, (uint64_t)(chars[*i] - '0'), &magnitude))
+            return ERANGE;
+    }
+
+    *value = magnitude;
+    return *i == start ? EINVAL : 0;
+}
+
+ACLIBDEF Ac_ParsedI64Res ac_str_parse_i64(Ac_StrSlice slice)
+{
+    size_t i = 0;
+    bool negative = i < slice.len && slice.chars[i] == '-';
+    if (i < slice.len && (slice.chars[i] == '-' || slice.chars[i] == '+'))
+        i++;
+
+    uint64_t magnitude;
+    int err = __aclib_parse_magnitude(slice.chars, slice.len, &i, &magnitude);
+    if (err != 0)
+        return (Ac_ParsedI64Res)ac_res_err(err);
+
+    // The magnitude of INT64_MIN is one more than INT64_MAX
+    if (magnitude > (uint64_t)INT64_MAX + negative)
+        return (Ac_ParsedI64Res)ac_res_err(ERANGE);
+
+    int64_t value = (int64_t)magnitude;
+    if (negative)
+        value = magnitude == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -value;
+    return (Ac_ParsedI64Res)ac_res_ok(((Ac_ParsedI64){.value = value, .consumed = i}));
+}
+
+ACLIBDEF Ac_ParsedU64Res ac_str_parse_u64(Ac_StrSlice slice)
+{
+    size_t i = 0;
+    if (i < slice.len && slice.chars[i] == '+')
+        i++;
+
+    uint64_t value;
+    int err = __aclib_parse_magnitude(slice.chars, slice.len, &i, &value);
+    if (err != 0)
+        return (Ac_ParsedU64Res)ac_res_err(err);
+
+    return (Ac_ParsedU64Res)ac_res_ok(((Ac_ParsedU64){.value = value, .consumed = i}));
+}
+
+// Doubles are parsed with the Eisel-Lemire algorithm (Lemire, "Number Parsing at a Gigabyte per
+// Second"). It multiplies the decimal significand by a 128-bit approximation of the power of ten,
+// which is exact enough to round correctly from the top bits of the product.
+
+/// The powers of ten that doubles hold exactly
+static const double __aclib_exact_pow10s[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/// The smallest and largest powers of ten, that don't always round to zero or infinity
+#define __ACLIB_POW5_MIN -342
+#define __ACLIB_POW5_MAX 308
+
+/// The 128-bit normalized and truncated powers of five from 5^-342 to 5^308, as high and low halves
+static const uint64_t __aclib_pow5s_128[] = {
+    0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL, 0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+    0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL, 0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+    0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL, 0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+    0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL, 0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+    0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL, 0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+    0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL, 0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+    0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL, 0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+    0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL, 0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+    0x84a57695fe98746dULL, 0x014bb630f7604b57ULL, 0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+    0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL, 0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+    0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL, 0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+    0xfd00b897478238d0ULL, 0x8920b098955522b4ULL, 0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+    0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL, 0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+    0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL, 0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+    0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL, 0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+    0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL, 0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+    0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL, 0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+    0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL, 0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+    0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL, 0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+    0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL, 0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+    0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL, 0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+    0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL, 0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+    0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL, 0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+    0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL, 0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+    0xa37fce126597973cULL, 0xe50ff107bab528a0ULL, 0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+    0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL, 0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+    0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL, 0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+    0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL, 0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+    0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL, 0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+    0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL, 0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+    0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL, 0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+    0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL, 0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+    0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL, 0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+    0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL, 0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+    0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL, 0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+    0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL, 0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+    0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL, 0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+    0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL, 0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+    0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL, 0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+    0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL, 0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+    0xc987434744ac874eULL, 0xa327ffb266b56220ULL, 0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+    0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL, 0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+    0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL, 0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+    0xc0314325637a1939ULL, 0xfa911155fefb5308ULL, 0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+    0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL, 0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+    0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL, 0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+    0xb749faed14125d36ULL, 0xcef980ec671f667bULL, 0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+    0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL, 0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+    0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL, 0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+    0xaecc49914078536dULL, 0x58fae9f773886e18ULL, 0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+    0x888f99797a5e012dULL, 0x6d8406c952429603ULL, 0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+    0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL, 0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+    0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL, 0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+    0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL, 0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+    0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL, 0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+    0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL, 0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+    0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL, 0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+    0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL, 0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+    0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL, 0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+    0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL, 0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+    0xb913179899f68584ULL, 0x28e2557b59846e3fULL, 0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+    0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL, 0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+    0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL, 0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+    0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL, 0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+    0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL, 0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+    0xd77485cb25823ac7ULL, 0x7d633293366b828bULL, 0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+    0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL, 0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+    0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL, 0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+    0xcd795be870516656ULL, 0x67902e276c921f8bULL, 0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+    0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL, 0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+    0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL, 0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+    0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL, 0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+    0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL, 0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+    0xef340a98172aace4ULL, 0x86fb897116c87c34ULL, 0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+    0xbae0a846d2195712ULL, 0x8974836059cca109ULL, 0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+    0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL, 0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+    0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL, 0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+    0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL, 0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+    0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL, 0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+    0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL, 0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+    0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL, 0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+    0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL, 0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+    0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL, 0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+    0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL, 0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+    0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL, 0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+    0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL, 0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+    0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL, 0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+    0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL, 0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+    0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL, 0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+    0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL, 0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+    0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL, 0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+    0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL, 0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+    0x8c974f7383725573ULL, 0x1e414218c73a13fbULL, 0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+    0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL, 0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+    0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL, 0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+    0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL, 0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+    0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL, 0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+    0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL, 0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+    0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL, 0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+    0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL, 0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+    0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL, 0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+    0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL, 0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+    0xbe89523386091465ULL, 0xf6bbb397f1135823ULL, 0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+    0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL, 0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+    0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL, 0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+    0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL, 0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+    0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL, 0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+    0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL, 0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+    0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL, 0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+    0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL, 0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+    0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL, 0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+    0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL, 0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+    0x811ccc668829b887ULL, 0x0806357d5a3f525fULL, 0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+    0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL, 0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+    0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL, 0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+    0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL, 0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+    0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL, 0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+    0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL, 0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+    0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL, 0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+    0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL, 0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+    0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL, 0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+    0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL, 0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+    0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL, 0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+    0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL, 0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+    0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL, 0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+    0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL, 0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+    0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL, 0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+    0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL, 0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+    0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL, 0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+    0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL, 0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+    0xc24452da229b021bULL, 0xfbe85badce996168ULL, 0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+    0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL, 0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+    0xed246723473e3813ULL, 0x290123e9aab23b68ULL, 0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+    0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL, 0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+    0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL, 0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+    0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL, 0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+    0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL, 0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+    0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL, 0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+    0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL, 0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, 0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, 0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+    0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, 0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, 0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, 0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, 0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, 0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, 0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+    0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, 0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, 0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, 0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, 0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, 0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, 0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+    0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, 0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, 0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+    0xc612062576589ddaULL, 0x95364afe032a819eULL, 0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, 0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL, 0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL, 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, 0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL, 0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL, 0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, 0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL, 0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL, 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, 0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL, 0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL, 0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL, 0xa000000000000000ULL, 0x0000000000000000ULL,
+    0xc800000000000000ULL, 0x0000000000000000ULL, 0xfa00000000000000ULL, 0x0000000000000000ULL,
+    0x9c40000000000000ULL, 0x0000000000000000ULL, 0xc350000000000000ULL, 0x0000000000000000ULL,
+    0xf424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xbebc200000000000ULL, 0x0000000000000000ULL, 0xee6b280000000000ULL, 0x0000000000000000ULL,
+    0x9502f90000000000ULL, 0x0000000000000000ULL, 0xba43b74000000000ULL, 0x0000000000000000ULL,
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL, 0x9184e72a00000000ULL, 0x0000000000000000ULL,
+    0xb5e620f480000000ULL, 0x0000000000000000ULL, 0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, 0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL, 0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL, 0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+    0x878678326eac9000ULL, 0x0000000000000000ULL, 0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL, 0x84595161401484a0ULL, 0x0000000000000000ULL,
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, 0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+    0x813f3978f8940984ULL, 0x4000000000000000ULL, 0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, 0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, 0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, 0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, 0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL, 0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+    0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL, 0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+    0xb7abc627050305adULL, 0xf14a3d9e40000000ULL, 0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+    0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL, 0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+    0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL, 0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+    0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL, 0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+    0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL, 0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+    0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL, 0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+    0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL, 0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+    0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL, 0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+    0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL, 0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+    0x9f4f2726179a2245ULL, 0x01d762422c946590ULL, 0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+    0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL, 0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+    0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL, 0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+    0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL, 0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+    0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL, 0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+    0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL, 0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+    0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL, 0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+    0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL, 0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+    0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL, 0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+    0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL, 0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+    0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL, 0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+    0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL, 0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+    0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL, 0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+    0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL, 0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+    0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL, 0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+    0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL, 0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+    0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL, 0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+    0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL, 0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+    0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL, 0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+    0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL, 0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+    0x924d692ca61be758ULL, 0x593c2626705f9c56ULL, 0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+    0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL, 0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+    0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL, 0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+    0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL, 0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+    0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL, 0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+    0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL, 0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+    0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL, 0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+    0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL, 0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+    0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL, 0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+    0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL, 0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+    0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL, 0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+    0x9ae757596946075fULL, 0x3375788de9b06958ULL, 0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+    0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL, 0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+    0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL, 0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+    0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL, 0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+    0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL, 0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+    0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL, 0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+    0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL, 0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+    0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL, 0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+    0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL, 0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+    0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL, 0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+    0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL, 0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+    0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL, 0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+    0x802221226be55a64ULL, 0xc2494954da2c9789ULL, 0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+    0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL, 0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+    0x9c69a97284b578d7ULL, 0xff2a760414536efbULL, 0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+    0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL, 0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+    0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL, 0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+    0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL, 0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+    0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL, 0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+    0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL, 0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+    0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL, 0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+    0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL, 0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+    0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL, 0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+    0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL, 0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+    0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL, 0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+    0xa59bc234db398c25ULL, 0x43fab9837e699095ULL, 0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+    0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL, 0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+    0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL, 0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+    0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL, 0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+    0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL, 0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+    0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL, 0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+    0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL, 0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+    0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL, 0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+    0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL, 0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+    0x8fa475791a569d10ULL, 0xf96e017d694487bcULL, 0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+    0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL, 0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+    0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL, 0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+    0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL, 0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+    0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL, 0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+    0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL, 0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+    0x82a45b450226b39cULL, 0xecc0024661173473ULL, 0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+    0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL, 0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+    0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL, 0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+    0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL, 0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+    0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL, 0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+    0x98165af37b2153deULL, 0xc3727a337a8b704aULL, 0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+    0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL, 0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+    0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL, 0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+    0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL, 0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+    0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL, 0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+    0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL, 0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+    0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL, 0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+    0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL, 0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+    0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL, 0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+    0x83ea2b892091e44dULL, 0x934aed0aab460432ULL, 0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+    0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL, 0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+    0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL, 0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+    0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL, 0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+    0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL, 0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+    0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL, 0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+    0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL, 0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+    0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL, 0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+    0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL, 0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+    0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL, 0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+    0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL, 0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+    0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL, 0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+    0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL, 0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+    0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL, 0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+    0x8533285c936b35deULL, 0xd53a88958f87275fULL, 0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+    0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL, 0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+    0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL, 0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+    0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL, 0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+    0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL, 0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+    0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL, 0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+    0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL, 0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+    0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL, 0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+    0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL, 0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+    0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL, 0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+    0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL, 0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+    0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL, 0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+    0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL, 0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+    0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL, 0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+    0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL, 0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+    0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL, 0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+    0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL, 0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+    0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL, 0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+    0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL, 0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+    0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL, 0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+    0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL, 0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+    0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL, 0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+    0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL, 0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+    0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL, 0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+    0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL, 0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+    0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL,
+};
+
+/// Multiply two 64-bit integers into a 128-bit product
+ACLIBDEF uint64_t __aclib_mul_128(uint64_t a, uint64_t b, uint64_t* high)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#else
+    uint64_t a_hi = a >> 32, a_lo = a & 0xFFFFFFFF;
+    uint64_t b_hi = b >> 32, b_lo = b & 0xFFFFFFFF;
+    uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi;
+    uint64_t mid = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    *high = a_hi * b_hi + (hi_lo >> 32) + (mid >> 32);
+    return (mid << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+/// Get the bits of the double closest to mantissa * 10^exp10, for a non-zero mantissa
+ACLIBDEF uint64_t __aclib_eisel_lemire(uint64_t mantissa, int64_t exp10)
+{
+    if (exp10 < __ACLIB_POW5_MIN)
+        return 0;
+    if (exp10 > __ACLIB_POW5_MAX)
+        return 0x7FFULL << 52;
+
+    int lz = __builtin_clzll(mantissa);
+    mantissa <<= lz;
+
+    // Only the top 55 bits of the product matter. When the bits below those are all ones, a carry
+    // from the truncated low half of the power could still reach them, so add that in
+    const uint64_t* pow5 = __aclib_pow5s_128 + 2 * (exp10 - __ACLIB_POW5_MIN);
+    uint64_t high;
+    uint64_t low = __aclib_mul_128(mantissa, pow5[0], &high);
+    if ((high & 0x1FF) == 0x1FF)
+    {
+        uint64_t carry_high;
+        __aclib_mul_128(mantissa, pow5[1], &carry_high);
+        low += carry_high;
+        if (low < carry_high)
+            high++;
+    }
+
+    int upper_bit = (int)(high >> 63);
+    int shift = upper_bit + 64 - 52 - 3;
+    uint64_t bits = high >> shift;
+    // floor(log2(10^exp10)) + 63, plus the bias of the double's exponent
+    int power2 = (int)((((152170 + 65536) * exp10) >> 16) + 63) + upper_bit - lz + 1023;
+
+    if (power2 <= 0)
+    {
+        // A subnormal double, so shift the bits into place and round them
+        if (-power2 + 1 >= 64)
+            return 0;
+        bits >>= -power2 + 1;
+        bits += bits & 1;
+        bits >>= 1;
+        power2 = bits < (1ULL << 52) ? 0 : 1;
+        return ((uint64_t)power2 << 52) | (bits & ((1ULL << 52) - 1));
+    }
+
+    // The product is exactly halfway between two doubles, so round it down to the even one
+    if (low <= 1 && exp10 >= -4 && exp10 <= 23 && (bits & 3) == 1 && (bits << shift) == high)
+        bits &= ~1ULL;
+
+    bits += bits & 1;
+    bits >>= 1;
+    if (bits >= (2ULL << 52))
+    {
+        bits = 1ULL << 52;
+        power2++;
+    }
+
+    if (power2 >= 0x7FF)
+        return 0x7FFULL << 52;
+    return ((uint64_t)power2 << 52) | (bits & ((1ULL << 52) - 1));
+}
+
+/// A decimal significand, with the digits that don't fit in 64 bits dropped
+typedef struct __Aclib_Decimal
+{
+    uint64_t mantissa;
+    /// The digits in the mantissa, not counting leading zeros
+    int digits;
+    /// The digits that didn't fit
+    int dropped;
+    /// Whether any of the dropped digits weren't zero
+    bool inexact;
+} __Aclib_Decimal;
+
+/// Add the digits at chars[i] to a decimal, eight at a time where they fit, and return the index
+/// after them
+ACLIBDEF size_t __aclib_parse_decimal_digits(const char* chars, size_t len, size_t i,
+                                             __Aclib_Decimal* decimal)
+{
+    for (;;)
+    {
+#ifdef __aclib_swar_is_8_digits
+        if (decimal->digits > 0 && decimal->digits + 8 <= 19 && i + 8 <= len)
+        {
+            uint64_t word;
+            memcpy(&word, chars + i, sizeof(word));
+            if (__aclib_swar_is_8_digits(word))
+            {
+                decimal->mantissa *= 100000000;
+                decimal->mantissa += __aclib_swar_parse_8_digits(word);
+                decimal->digits += 8;
+                i += 8;
+                continue;
+            }
+        }
+#endif
+        if (i >= len || !ac_ascii_is_numeric(chars[i]))
+            return i;
+
+        uint64_t digit = chars[i] - '0';
+        if (decimal->digits < 19)
+        {
+            decimal->mantissa = decimal->mantissa * 10 + digit;
+            decimal->digits += decimal->mantissa != 0;
+        }
+        else
+        {
+            decimal->dropped++;
+            decimal->inexact |= digit != 0;
+        }
+        i++;
+    }
+}
+
+/// Round the decimal number in chars, without its sign and exponent, times 10^exp10, when it's
+/// known to be between the double with the given bits and the next one up. All of its digits are
+/// compared with the halfway point between those doubles, so this is exact, but slow
+ACLIBDEF uint64_t __aclib_round_decimal_exact(const char* chars, size_t len, int64_t exp10,
+                                              uint64_t bits)
+{
+    // Halfway points between doubles have at most 767 significant digits, so any digits after
+    // those only matter when they aren't all zeros
+    __Aclib_BigInt digits = {0};
+    int kept = 0;
+    bool truncated = false;
+    bool after_point = false;
+    uint32_t chunk = 0, chunk_pow10 = 1;
+    for (size_t i = 0; i < len; i++)
+    {
+        if (chars[i] == '.')
+        {
+            after_point = true;
+            continue;
+        }
+
+        uint32_t digit = chars[i] - '0';
+        if (kept == 0 && digit == 0)
+        {
+            exp10 -= after_point;
+        }
+        else if (kept < 768)
+        {
+            chunk = chunk * 10 + digit;
+            chunk_pow10 *= 10;
+            kept++;
+            exp10 -= after_point;
+            if (chunk_pow10 == 1000000000)
+            {
+                __aclib_bigint_mul_add(&digits, chunk_pow10, chunk);
+                chunk = 0;
+                chunk_pow10 = 1;
+            }
+        }
+        else
+        {
+            truncated |= digit != 0;
+            exp10 += !after_point;
+        }
+    }
+    __aclib_bigint_mul_add(&digits, chunk_pow10, chunk);
+
+    // The halfway point is (2 * mantissa + 1) * 2^(exp2 - 1)
+    uint64_t mantissa = bits & ((1ULL << 52) - 1);
+    int64_t exp2 = (int64_t)(bits >> 52);
+    if (exp2 == 0)
+        exp2 = 1;
+    else
+        mantissa |= 1ULL << 52;
+    exp2 -= 1075 + 1;
+
+    __Aclib_BigInt halfway = __aclib_bigint_from_u64(2 * mantissa + 1);
+
+    // Compare digits * 5^exp10 * 2^exp10 with halfway * 2^exp2, as integers
+    if (exp10 > 0)
+        __aclib_bigint_mul_pow5(&digits, exp10);
+    else
+        __aclib_bigint_mul_pow5(&halfway, -exp10);
+    if (exp2 > exp10)
+        __aclib_bigint_shift_left(&halfway, exp2 - exp10);
+    else
+        __aclib_bigint_shift_left(&digits, exp10 - exp2);
+
+    // Exactly halfway rounds to the even double
+    int cmp = __aclib_bigint_cmp(&digits, &halfway);
+    if (cmp > 0 || (cmp == 0 && (truncated || (bits & 1))))
+        return bits + 1;
+    return bits;
+}
+
+/// Checks if a slice starts with a lowercase word, ignoring case
+ACLIBDEF bool __aclib_starts_with_word(const char* chars, size_t len, const char* word)
+{
+    size_t word_len = strlen(word);
+    if (len < word_len)
+        return false;
+
+    for (size_t i = 0; i < word_len; i++)
+    {
+        if (ac_ascii_to_lowercase(chars[i]) != word[i])
+            return false;
+    }
+    return true;
+}
+
+ACLIBDEF Ac_ParsedF64Res ac_str_parse_f64(Ac_StrSlice slice)
+{
+    const char* chars = slice.chars;
+    size_t len = slice.len;
+    size_t i = 0;
+
+    bool negative = i < len && chars[i] == '-';
+    if (i < len && (chars[i] == '-' || chars[i] == '+'))
+        i++;
+
+    double value = 0.0;
+    if (__aclib_starts_with_word(chars + i, len - i, "inf"))
+    {
+        value = __builtin_inf();
+        i += __aclib_starts_with_word(chars + i, len - i, "infinity") ? 8 : 3;
+        return (Ac_ParsedF64Res)ac_res_ok(((Ac_ParsedF64){
+            .value = negative ? -value : value,
+            .consumed = i,
+        }));
+    }
+    if (__aclib_starts_with_word(chars + i, len - i, "nan"))
+    {
+        value = __builtin_nan("");
+        return (Ac_ParsedF64Res)ac_res_ok(((Ac_ParsedF64){
+            .value = negative ? -value : value,
+            .consumed = i + 3,
+        }));
+    }
+
+    // The significand, with the dropped integer digits and the kept fraction digits moving the
+    // decimal point
+    __Aclib_Decimal decimal = {0};
+    size_t start = i;
+    i = __aclib_parse_decimal_digits(chars, len, i, &decimal);
+    int64_t exp10 = decimal.dropped;
+    bool has_digits = i > start;
+
+    if (i < len && chars[i] == '.')
+    {
+        size_t fraction_start = ++i;
+        int dropped = decimal.dropped;
+        i = __aclib_parse_decimal_digits(chars, len, i, &decimal);
+        exp10 -= (int64_t)(i - fraction_start) - (decimal.dropped - dropped);
+        has_digits |= i > fraction_start;
+    }
+
+    if (!has_digits)
+        return (Ac_ParsedF64Res)ac_res_err(EINVAL);
+
+    size_t digits_end = i;
+    int64_t explicit_exp10 = 0;
+
+    // The exponent is only part of the number if it has digits, like with strtod
+    if (i < len && (chars[i] == 'e' || chars[i] == 'E'))
+    {
+        size_t exp_start = i + 1;
+        bool exp_negative = exp_start < len && chars[exp_start] == '-';
+        if (exp_start < len && (chars[exp_start] == '-' || chars[exp_start] == '+'))
+            exp_start++;
+
+        int64_t exp = 0;
+        size_t j = exp_start;
+        for (; j < len && ac_ascii_is_numeric(chars[j]); j++)
+        {
+            // Anything this large is already zero or infinity
+            if (exp < 100000)
+                exp = exp * 10 + (chars[j] - '0');
+        }
+
+        if (j > exp_start)
+        {
+            explicit_exp10 = exp_negative ? -exp : exp;
+            exp10 += explicit_exp10;
+            i = j;
+        }
+    }
+
+    if (decimal.mantissa == 0)
+    {
+        value = 0.0;
+    }
+    else if (!decimal.inexact && decimal.mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+    {
+        // Both the mantissa and the power of ten are exact doubles, so a single rounding of their
+        // product or quotient is correct
+        value = (double)decimal.mantissa;
+        value = exp10 < 0 ? value / __aclib_exact_pow10s[-exp10]
+                          : value * __aclib_exact_pow10s[exp10];
+    }
+    else
+    {
+        uint64_t bits = __aclib_eisel_lemire(decimal.mantissa, exp10);
+
+        // With dropped digits the number is between mantissa and mantissa + 1, so it's only known
+        // when both of those round to the same double. Otherwise compare all of the digits with
+        // the halfway point between the two doubles
+        if (decimal.inexact && __aclib_eisel_lemire(decimal.mantissa + 1, exp10) != bits)
+        {
+            bits = __aclib_round_decimal_exact(chars + start, digits_end - start, explicit_exp10,
+                                               bits);
+        }
+        memcpy(&value, &bits, sizeof(value));
+    }
+
+    if (negative)
+        value = -value;
+    if (__builtin_isinf(value))
+        return (Ac_ParsedF64Res)ac_res_err(ERANGE);
+
+    return (Ac_ParsedF64Res)ac_res_ok(((Ac_ParsedF64){.value = value, .consumed = i}));
+}
+
+#ifdef __ACLIB_AVX2
+// UTF-8 is validated with the lookup algorithm from Keiser and Lemire, "Validating UTF-8 In Less
+// Than One Instruction Per Byte". Every pair of bytes looks up the errors it could be part of by
+// the high and low nibble of the first byte and the high nibble of the second, and is an error if
+// all three lookups agree on one. The third and fourth bytes of longer sequences are then checked
+// separately.
+#define __ACLIB_UTF8_TOO_SHORT (1 << 0)
+#define __ACLIB_UTF8_TOO_LONG (1 << 1)
+#define __ACLIB_UTF8_OVERLONG_3 (1 << 2)
+#define __ACLIB_UTF8_TOO_LARGE (1 << 3)
+#define __ACLIB_UTF8_SURROGATE (1 << 4)
+#define __ACLIB_UTF8_OVERLONG_2 (1 << 5)
+#define __ACLIB_UTF8_TOO_LARGE_1000 (1 << 6)
+#define __ACLIB_UTF8_OVERLONG_4 (1 << 6)
+#define __ACLIB_UTF8_TWO_CONTS (1 << 7)
+#define __ACLIB_UTF8_CARRY                                                                     \
+    (__ACLIB_UTF8_TOO_SHORT | __ACLIB_UTF8_TOO_LONG | __ACLIB_UTF8_TWO_CONTS)
+
+/// The errors a pair of bytes could be, by the high nibble of the first byte
+static const uint8_t __aclib_utf8_byte_1_high[16] = {
+    // 0_______, an ascii char
+    __ACLIB_UTF8_TOO_LONG,
+    __ACLIB_UTF8_TOO_LONG,
+    __ACLIB_UTF8_TOO_LONG,
+    __ACLIB_UTF8_TOO_LONG,
+    __ACLIB_UTF8_TOO_LONG,
+    __ACLIB_UTF8_TOO_LONG,
+    __ACLIB_UTF8_TOO_LONG,
+    __ACLIB_UTF8_TOO_LONG,
+    // 10______, a continuation
+    __ACLIB_UTF8_TWO_CONTS,
+    __ACLIB_UTF8_TWO_CONTS,
+    __ACLIB_UTF8_TWO_CONTS,
+    __ACLIB_UTF8_TWO_CONTS,
+    // 110_____, the start of a 2 byte sequence
+    __ACLIB_UTF8_TOO_SHORT | __ACLIB_UTF8_OVERLONG_2,
+    __ACLIB_UTF8_TOO_SHORT,
+    // 1110____, the start of a 3 byte sequence
+    __ACLIB_UTF8_TOO_SHORT | __ACLIB_UTF8_OVERLONG_3 | __ACLIB_UTF8_SURROGATE,
+    // 1111____, the start of a 4 byte sequence
+    __ACLIB_UTF8_TOO_SHORT | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000 |
+        __ACLIB_UTF8_OVERLONG_4,
+};
+
+/// The errors a pair of bytes could be, by the low nibble of the first byte
+static const uint8_t __aclib_utf8_byte_1_low[16] = {
+    // ____0000
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_OVERLONG_3 | __ACLIB_UTF8_OVERLONG_2 |
+        __ACLIB_UTF8_OVERLONG_4,
+    // ____0001
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_OVERLONG_2,
+    // ____001_
+    __ACLIB_UTF8_CARRY,
+    __ACLIB_UTF8_CARRY,
+    // ____0100
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE,
+    // ____0101 through ____1100
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    // ____1101
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000 |
+        __ACLIB_UTF8_SURROGATE,
+    // ____111_
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+    __ACLIB_UTF8_CARRY | __ACLIB_UTF8_TOO_LARGE | __ACLIB_UTF8_TOO_LARGE_1000,
+};
+
+/// The errors a pair of bytes could be, by the high nibble of the second byte
+static const uint8_t __aclib_utf8_byte_2_high[16] = {
+    // 0_______, an ascii char
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    // 1000____
+    __ACLIB_UTF8_TOO_LONG | __ACLIB_UTF8_OVERLONG_2 | __ACLIB_UTF8_TWO_CONTS |
+        __ACLIB_UTF8_OVERLONG_3 | __ACLIB_UTF8_TOO_LARGE_1000 | __ACLIB_UTF8_OVERLONG_4,
+    // 1001____
+    __ACLIB_UTF8_TOO_LONG | __ACLIB_UTF8_OVERLONG_2 | __ACLIB_UTF8_TWO_CONTS |
+        __ACLIB_UTF8_OVERLONG_3 | __ACLIB_UTF8_TOO_LARGE,
+    // 101_____
+    __ACLIB_UTF8_TOO_LONG | __ACLIB_UTF8_OVERLONG_2 | __ACLIB_UTF8_TWO_CONTS |
+        __ACLIB_UTF8_SURROGATE | __ACLIB_UTF8_TOO_LARGE,
+    __ACLIB_UTF8_TOO_LONG | __ACLIB_UTF8_OVERLONG_2 | __ACLIB_UTF8_TWO_CONTS |
+        __ACLIB_UTF8_SURROGATE | __ACLIB_UTF8_TOO_LARGE,
+    // 11______, the start of a sequence
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+    __ACLIB_UTF8_TOO_SHORT,
+};
+
+__attribute__((target("ssse3"))) ACLIBDEF bool __aclib_ssse3_utf8_validate(const char* chars,
+                                                                           size_t len)
+{
+    // The bytes at the end of a block that start a sequence that doesn't fit in it
+    __m128i max_complete = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                         (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    __m128i errors = _mm_setzero_si128();
+    __m128i prev_block = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+    __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i byte_1_high_table = _mm_loadu_si128((const __m128i*)__aclib_utf8_byte_1_high);
+    __m128i byte_1_low_table = _mm_loadu_si128((const __m128i*)__aclib_utf8_byte_1_low);
+    __m128i byte_2_high_table = _mm_loadu_si128((const __m128i*)__aclib_utf8_byte_2_high);
+
+    for (size_t i = 0; i < len; i += 16)
+    {
+        __m128i block;
+        if (i + 16 <= len)
+        {
+            block = _mm_loadu_si128((const __m128i*)(chars + i));
+        }
+        else
+        {
+            // Pad the tail with ascii, which ends any sequence left incomplete
+            char tail[16] = {0};
+            memcpy(tail, chars + i, len - i);
+            block = _mm_loadu_si128((const __m128i*)tail);
+        }
+
+        if (_mm_movemask_epi8(block) == 0)
+        {
+            errors = _mm_or_si128(errors, prev_incomplete);
+        }
+        else
+        {
+            __m128i prev1 = _mm_alignr_epi8(block, prev_block, 15);
+            __m128i byte_1_high = _mm_shuffle_epi8(
+                byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+            __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, nibble));
+            __m128i byte_2_high = _mm_shuffle_epi8(
+                byte_2_high_table, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+            __m128i pair_errors =
+                _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+            // Two continuations in a row are only valid as the third or fourth byte of a
+            // sequence, i.e. two bytes after a 111_____ byte, or three bytes after a 1111____ byte
+            __m128i prev2 = _mm_alignr_epi8(block, prev_block, 14);
+            __m128i prev3 = _mm_alignr_epi8(block, prev_block, 13);
+            __m128i is_third = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)));
+            __m128i is_fourth = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)));
+            __m128i must_be_cont =
+                _mm_and_si128(_mm_or_si128(is_third, is_fourth), _mm_set1_epi8((char)0x80));
+
+            errors = _mm_or_si128(errors, _mm_xor_si128(must_be_cont, pair_errors));
+            prev_incomplete = _mm_subs_epu8(block, max_complete);
+        }
+        prev_block = block;
+    }
+
+    errors = _mm_or_si128(errors, prev_incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) == 0xFFFF;
+}
+
+__attribute__((target("avx2"))) ACLIBDEF bool __aclib_avx2_utf8_validate(const char* chars,
+                                                                         size_t len)
+{
+    __m256i max_complete = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    __m256i errors = _mm256_setzero_si256();
+    __m256i prev_block = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i byte_1_high_table =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)__aclib_utf8_byte_1_high));
+    __m256i byte_1_low_table =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)__aclib_utf8_byte_1_low));
+    __m256i byte_2_high_table =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)__aclib_utf8_byte_2_high));
+
+    for (size_t i = 0; i < len; i += 32)
+    {
+        __m256i block;
+        if (i + 32 <= len)
+        {
+            block = _mm256_loadu_si256((const __m256i*)(chars + i));
+        }
+        else
+        {
+            char tail[32] = {0};
+            memcpy(tail, chars + i, len - i);
+            block = _mm256_loadu_si256((const __m256i*)tail);
+        }
+
+        if (_mm256_movemask_epi8(block) == 0)
+        {
+            errors = _mm256_or_si256(errors, prev_incomplete);
+        }
+        else
+        {
+            // alignr works within each 128-bit lane, so line the previous bytes up across the
+            // lanes first
+            __m256i prev_lanes = _mm256_permute2x128_si256(prev_block, block, 0x21);
+            __m256i prev1 = _mm256_alignr_epi8(block, prev_lanes, 15);
+            __m256i byte_1_high = _mm256_shuffle_epi8(
+                byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+            __m256i byte_1_low =
+                _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, nibble));
+            __m256i byte_2_high = _mm256_shuffle_epi8(
+                byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+            __m256i pair_errors =
+                _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+            __m256i prev2 = _mm256_alignr_epi8(block, prev_lanes, 14);
+            __m256i prev3 = _mm256_alignr_epi8(block, prev_lanes, 13);
+            __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+            __m256i is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+            __m256i must_be_cont = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth),
+                                                    _mm256_set1_epi8((char)0x80));
+
+            errors = _mm256_or_si256(errors, _mm256_xor_si256(must_be_cont, pair_errors));
+            prev_incomplete = _mm256_subs_epu8(block, max_complete);
+        }
+        prev_block = block;
+    }
+
+    errors = _mm256_or_si256(errors, prev_incomplete);
+    return _mm256_testz_si256(errors, errors);
+}
+#endif
+
+ACLIBDEF bool ac_str_utf8_validate(Ac_StrSlice slice)
+{
+#ifdef __ACLIB_AVX2
+    if (slice.len >= 64 && __aclib_has_avx2())
+        return __aclib_avx2_utf8_validate(slice.chars, slice.len);
+    if (slice.len >= 16 && __aclib_has_ssse3())
+        return __aclib_ssse3_utf8_validate(slice.chars, slice.len);
+#endif
+
+    const uint8_t* bytes = (const uint8_t*)slice.chars;
+    size_t len = slice.len;
+    size_t i = 0;
+    while (i < len)
+    {
+        // Skip ascii a word at a time
+        if (i + sizeof(uint64_t) <= len)
+        {
+            uint64_t word;
+            memcpy(&word, bytes + i, sizeof(word));
+            if ((word & __ACLIB_SWAR_HIGHS) == 0)
+            {
+                i += sizeof(uint64_t);
+                continue;
+            }
+        }
+
+        uint8_t lead = bytes[i];
+        if (lead < 0x80)
+        {
+            i++;
+            continue;
+        }
+
+        // The number of continuations, and the range of the first one, which rules out overlong
+        // sequences, surrogates and code points past U+10FFFF
+        size_t conts;
+        uint8_t min = 0x80, max = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            conts = 1;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            conts = 2;
+            min = lead == 0xE0 ? 0xA0 : min;
+            max = lead == 0xED ? 0x9F : max;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            conts = 3;
+            min = lead == 0xF0 ? 0x90 : min;
+            max = lead == 0xF4 ? 0x8F : max;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (len - i - 1 < conts || bytes[i + 1] < min || bytes[i + 1] > max)
+            return false;
+        for (size_t j = 2; j <= conts; j++)
+        {
+            if ((bytes[i + j] & 0xC0) != 0x80)
+                return false;
+        }
+        i += conts + 1;
+    }
+    return true;
+}
+
+ACLIBDEF size_t ac_str_utf8_count(Ac_StrSlice slice)
+{
+    // Every byte that isn't a continuation, i.e. 10______, starts a code point
+    size_t conts = 0;
+    size_t i = 0;
+
+#ifdef __ACLIB_SSE2
+    __m128i max_cont = _mm_set1_epi8((char)0xC0);
+    for (; i + 16 <= slice.len; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(slice.chars + i));
+        conts += __builtin_popcount(_mm_movemask_epi8(_mm_cmplt_epi8(block, max_cont)));
+    }
+#endif
+
+    for (; i < slice.len; i++)
+        conts += (slice.chars[i] & 0xC0) == 0x80;
+    return slice.len - conts;
+}
+
+/// Move an index back to the start of the code point it is in
+ACLIBDEF size_t __aclib_utf8_floor_boundary(Ac_StrSlice slice, size_t idx)
+{
+    while (idx > 0 && idx < slice.len && (slice.chars[idx] & 0xC0) == 0x80)
+        idx--;
+    return idx;
+}
+
+ACLIBDEF Ac_StrSlice ac_str_utf8_slice_range(Ac_StrSlice slice, size_t start, size_t end)
+{
+    if (start >= slice.len || end > slice.len || start >= end)
+        return (Ac_StrSlice){0};
+
+    start = __aclib_utf8_floor_boundary(slice, start);
+    end = __aclib_utf8_floor_boundary(slice, end);
+    if (start >= end)
+        return (Ac_StrSlice){0};
+
+    return (Ac_StrSlice){
+        .chars = slice.chars + start,
+        .len = end - start,
+    };
+}
+
+ACLIBDEF char ac_str_pop(Ac_String* str)
+{
+    ACLIB_ASSERT_FN(str->len >= 1 &&
+                    "String failed to pop, expected length of >= 1, but got length of 0");
+    str->len -= 1;
+    char popped = str->chars[str->len];
+    str->chars[str->len] = '\0';
+    return popped;
+}
+
+ACLIBDEF Ac_CharOpt ac_str_pop_opt(Ac_String* str)
+{
+    if (str->len == 0)
+        return (Ac_CharOpt)ac_opt_none();
+
+    return (Ac_CharOpt)ac_opt_some(ac_str_pop(str));
+}
+
+ACLIBDEF char ac_str_shift(Ac_String* str)
+{
+    ACLIB_ASSERT_FN(str->len >= 1 &&
+                    "String failed to shift, expected length of >= 1, but got length of 0");
+
+    char shifted = str->chars[0];
+
+    memmove(str->chars, str->chars + 1, (str->len - 1) * sizeof(char));
+    str->len -= 1;
+    str->chars[str->len] = '\0';
+
+    return shifted;
+}
+
+ACLIBDEF Ac_CharOpt ac_str_shift_opt(Ac_String* str)
+{
+    if (str->len == 0)
+        return (Ac_CharOpt)ac_opt_none();
+
+    return (Ac_CharOpt)ac_opt_some(ac_str_shift(str));
+}
+
+ACLIBDEF char* ac_str_clone_chars(Ac_String str)
+{
+    char* buffer = (char*)ac_allocator_alloc(NULL, (str.len + 1) * sizeof(char));
+
+    if (buffer == NULL)
+    {
+        ac_log(ACLIB_ERR, "Failed to clone string chars\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(buffer, str.chars, str.len * sizeof(char));
+    buffer[str.len] = '\0';
+
+    return buffer;
+}
+
+ACLIBDEF Ac_StrSlice ac_str_drain(Ac_String* str)
+{
+    Ac_StrSlice slice = ac_str_slice_from(str->chars);
+
+    *str = (Ac_String){0};
+
+    return slice;
+}
+
+ACLIBDEF Ac_StrSlice ac_str_drain_range(Ac_String* str, size_t start, size_t end)
+{
+    Ac_StrSlice slice = ac_str_slice_range(*str, start, end);
+    slice = ac_str_slice_clone(slice);
+
+    ac_str_remove_range(str, start, end);
+
+    return slice;
+}
+
+ACLIBDEF void ac_str_remove(Ac_String* str, size_t idx)
+{
+    if (idx >= str->len)
+        return;
+
+    ac_str_remove_range(str, idx, idx + 1);
+}
+
+ACLIBDEF void ac_str_remove_range(Ac_String* str, size_t start, size_t end)
+{
+    if (start >= str->len || end > str->len || start >= end)
+        return;
+
+    if (end == str->len)
+    {
+        str->len = start;
+        str->chars[str->len] = '\0';
+        return;
+    }
+
+    memmove(str->chars + start, str->chars + end, (str->len - end) * sizeof(char));
+    str->len -= (end - start);
+    str->chars[str->len] = '\0';
+}
+
+ACLIBDEF void ac_str_empty(Ac_String* str)
+{
+    str->len = 0;
+    if (str->chars)
+        str->chars[0] = '\0';
+}
+
+ACLIBDEF void ac_str_free(Ac_String* str)
+{
+    if (str->chars == NULL)
+        return;
+
+    ac_allocator_free(str->allocator, str->chars);
+    str->chars = (char*)0;
+    str->len = 0;
+    str->cap = 0;
+}
+
+/// Grow a string to fit atleast new_cap chars with a growth policy
+ACLIBDEF void __aclib_str_grow(Ac_String* str, size_t new_cap, Ac_GrowthFn growth_fn)
+{
+    // The buffer always has room for a '\0' after the capacity
+    size_t buf_cap = str->chars ? str->cap + 1 : 0;
+    bool was_empty = str->chars == NULL;
+
+    str->chars = (char*)__aclib_grow(str->chars, &buf_cap, &str->allocator, sizeof(char),
+                                     new_cap + 1, growth_fn);
+    str->cap = buf_cap - 1;
+
+    if (was_empty)
+        str->chars[0] = '\0';
+    str->chars[str->cap] = '\0';
+}
+
+ACLIBDEF void ac_str_ensure_cap(Ac_String* str, size_t new_cap)
+{
+    if (str->chars == NULL || str->cap < new_cap)
+        __aclib_str_grow(str, new_cap, ACLIB_STR_GROWTH_FN);
+}
+
+ACLIBDEF void ac_str_reserve_exact(Ac_String* str, size_t new_cap)
+{
+    if (str->chars == NULL || str->cap < new_cap)
+        __aclib_str_grow(str, new_cap, ac_growth_exact);
+}
+
+ACLIBDEF void ac_str_shrink_to_fit(Ac_String* str)
+{
+    if (str->chars == NULL)
+        return;
+
+    size_t buf_cap = str->cap + 1;
+    str->chars = (char*)__aclib_shrink(str->chars, &buf_cap, str->allocator, sizeof(char),
+                                       str->len + 1);
+    str->cap = buf_cap - 1;
+}
+
+
+/// The size of the chunks files are read in, when their size isn't known up front
+#define __ACLIB_READ_CHUNK_SIZE (64 * 1024)
+ACLIBDEF size_t ac_str_read_file(Ac_String* buffer, FILE* file)
+{
+    size_t bytes_read = 0;
+
+    // If it is a regular file, the rest of it can be read in one go. Large freads are passed
+    // straight to read(2), while still respecting what the FILE has already buffered
+    struct stat st;
+    int fd = fileno(file);
+    long pos = fd >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) ? ftell(file) : -1;
+    if (pos >= 0 && st.st_size > pos)
+    {
+        size_t remaining = (size_t)(st.st_size - pos);
+        ac_str_reserve_exact(buffer, buffer->len + remaining);
+
+        bytes_read = fread(buffer->chars + buffer->len, 1, remaining, file);
+        buffer->len += bytes_read;
+        buffer->chars[buffer->len] = '\0';
+
+        // Only fall back to chunked reads, if the file grew after the fstat
+        int ch = fgetc(file);
+        if (ch == EOF)
+            return bytes_read;
+
+        ac_str_push(buffer, (char)ch);
+        bytes_read++;
+    }
+
+    // Pipes, sockets, and other streams of unknown size are read in chunks
+    for (;;)
+    {
+        ac_str_ensure_cap(buffer, buffer->len + __ACLIB_READ_CHUNK_SIZE);
+
+        size_t chunk_len = fread(buffer->chars + buffer->len, 1, buffer->cap - buffer->len, file);
+        buffer->len += chunk_len;
+        bytes_read += chunk_len;
+
+        if (chunk_len == 0)
+            break;
+    }
+
+    buffer->chars[buffer->len] = '\0';
+    return bytes_read;
+}
+
+ACLIBDEF size_t ac_str_read_lines(Ac_StrVec* linebuffer, FILE* file)
+{
+    size_t bytes_read = 0;
+    // Holds the start of a line that was cut off at the end of a chunk
+    Ac_String partial = {.allocator = linebuffer->allocator};
+
+    char* chunk = ac_allocator_alloc(linebuffer->allocator, __ACLIB_READ_CHUNK_SIZE);
+    if (chunk == NULL)
+    {
+        ac_str_free(&partial);
+        return 0;
+    }
+
+    size_t chunk_len;
+    while ((chunk_len = fread(chunk, 1, __ACLIB_READ_CHUNK_SIZE, file)) > 0)
+    {
+        bytes_read += chunk_len;
+
+        size_t start = 0;
+        size_t end;
+        while ((end = start + __aclib_scan_byte(chunk + start, chunk_len - start, '\n')) <
+               chunk_len)
+        {
+            Ac_StrSlice line = {.chars = chunk + start, .len = end - start};
+            if (partial.len > 0)
+            {
+                ac_str_append_slice(&partial, line);
+                line = partial.slice;
+            }
+
+            ac_vec_push(linebuffer, ac_str_slice_clone_in(linebuffer->allocator, line));
+            ac_str_empty(&partial);
+            start = end + 1;
+        }
+
+        ac_str_append_slice(&partial, (Ac_StrSlice){.chars = chunk + start,
+                                                    .len = chunk_len - start});
+    }
+
+    if (partial.len > 0)
+        ac_vec_push(linebuffer, ac_str_slice_clone_in(linebuffer->allocator, partial.slice));
+
+    ac_str_free(&partial);
+    ac_allocator_free(linebuffer->allocator, chunk);
+    return bytes_read;
+}
+#undef __ACLIB_READ_CHUNK_SIZE
+
+ACLIBDEF Ac_StrLines ac_str_read_lines_buffered(FILE* file)
+{
+    Ac_StrLines lines = {0};
+    ac_str_read_file(&lines.buffer, file);
+    ac_str_split_lines_into(&lines.lines, lines.buffer.slice);
+
+    // Replace the '\n' after every line, so the lines can be used as cstrs
+    AC_VEC_FOREACH(Ac_StrSlice, lines.lines, line)
+    {
+        line->chars[line->len] = '\0';
+    }
+
+    return lines;
+}
+
+ACLIBDEF void ac_str_lines_free(Ac_StrLines* lines)
+{
+    ac_str_free(&lines->buffer);
+    ac_vec_free(lines->lines);
+}
+
+ACLIBDEF void ac_str_split_lines_into(Ac_StrVec* lines, Ac_StrSlice slice)
+{
+    size_t start = 0;
+    size_t end;
+
+    while (start < slice.len &&
+           (end = start + __aclib_scan_byte(slice.chars + start, slice.len - start, '\n')) <
+               slice.len)
+    {
+        ac_vec_push(lines, __aclib_str_sub(slice, start, end));
+        start = end + 1;
+    }
+
+    if (start < slice.len)
+        ac_vec_push(lines, __aclib_str_sub(slice, start, slice.len));
+}
+
+ACLIBDEF Ac_LineReader ac_line_reader_from_fd(int fd)
+{
+    return (Ac_LineReader){.fd = fd};
+}
+
+ACLIBDEF Ac_LineReader ac_line_reader_from_file(FILE* file)
+{
+    return (Ac_LineReader){.fd = -1, .file = file};
+}
+
+/// Read as many bytes as fit into the spare capacity of a line reader's buffer. Returns -1 and sets
+/// errno if the read failed
+ACLIBDEF ssize_t __aclib_line_reader_fill(Ac_LineReader* reader)
+{
+    Ac_String* buffer = &reader->buffer;
+    size_t spare = buffer->cap - buffer->len;
+
+    if (reader->file != NULL)
+    {
+        errno = 0;
+        size_t bytes_read = fread(buffer->chars + buffer->len, 1, spare, reader->file);
+        if (bytes_read == 0 && ferror(reader->file))
+        {
+            if (errno == 0)
+                errno = EIO;
+            // Clear the error, so the next call tries to read again
+            int err = errno;
+            clearerr(reader->file);
+            errno = err;
+            return -1;
+        }
+        return (ssize_t)bytes_read;
+    }
+
+    ssize_t bytes_read;
+    do
+    {
+        bytes_read = read(reader->fd, buffer->chars + buffer->len, spare);
+    } while (bytes_read < 0 && errno == EINTR);
+
+    return bytes_read;
+}
+
+ACLIBDEF Ac_StrSliceOpt ac_line_reader_next(Ac_LineReader* reader)
 {
-    size_t size = strlen(chs);
-    ac_str_ensure_cap(str, str->len + size);
+    Ac_String* buffer = &reader->buffer;
+    if (buffer->chars == NULL)
+        ac_str_reserve_exact(buffer, ACLIB_LINE_READER_BUF_SIZE);
+    reader->error = 0;
 
-    for (size_t i = 0; i < size; i++)
-        str->chars[str->len + i] = chs[i];
+    for (;;)
+    {
+        size_t end = reader->scanned +
+                     __aclib_scan_byte(buffer->chars + reader->scanned,
+                                       buffer->len - reader->scanned, '\n');
+        if (end < buffer->len)
+        {
+            Ac_StrSlice line = {.chars = buffer->chars + reader->pos, .len = end - reader->pos};
+            line.chars[line.len] = '\0';
+            reader->pos = end + 1;
+            reader->scanned = end + 1;
+            return (Ac_StrSliceOpt)ac_opt_some(line);
+        }
+        reader->scanned = buffer->len;
 
-    str->chars[str->len + size] = '\0';
-    str->len += size;
+        if (reader->eof)
+        {
+            if (reader->pos == buffer->len)
+                return (Ac_StrSliceOpt)ac_opt_none();
+
+            Ac_StrSlice line = {.chars = buffer->chars + reader->pos,
+                                .len = buffer->len - reader->pos};
+            reader->pos = buffer->len;
+            return (Ac_StrSliceOpt)ac_opt_some(line);
+        }
+
+        // Move the start of the current line to the front, so it is only copied when it straddles
+        // the end of the buffer. Then make room for more, if the line fills the whole buffer
+        if (reader->pos > 0)
+        {
+            memmove(buffer->chars, buffer->chars + reader->pos, buffer->len - reader->pos);
+            buffer->len -= reader->pos;
+            reader->scanned -= reader->pos;
+            reader->pos = 0;
+        }
+        if (buffer->len == buffer->cap)
+            ac_str_ensure_cap(buffer, buffer->cap * 2);
+
+        ssize_t bytes_read = __aclib_line_reader_fill(reader);
+        // Keep the partial line in the buffer, so it can be finished by a later call
+        if (bytes_read < 0)
+        {
+            reader->error = errno;
+            return (Ac_StrSliceOpt)ac_opt_none();
+        }
+
+        buffer->len += (size_t)bytes_read;
+        buffer->chars[buffer->len] = '\0';
+
+        if (bytes_read == 0)
+            reader->eof = true;
+    }
 }
 
-ACLIBDEF void ac_str_appendf(Ac_String* str, const char* fmt, ...)
+ACLIBDEF void ac_line_reader_free(Ac_LineReader* reader)
 {
-    va_list args;
-    va_start(args, fmt);
-    size_t needed = vsnprintf(NULL, 0, fmt, args) + 1;
-    va_end(args);
+    ac_str_free(&reader->buffer);
+    reader->pos = 0;
+    reader->scanned = 0;
+    reader->eof = false;
+    reader->error = 0;
+}
 
-    ac_str_ensure_cap(str, str->len + needed);
+ACLIBDEF Ac_StrSliceRes ac_str_map_file(const char* path, int advice)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return (Ac_StrSliceRes)ac_res_err(errno);
 
-    char* dest = str->chars + str->len;
-    va_start(args, fmt);
-    vsprintf(dest, fmt, args);
-    va_end(args);
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        int err = errno;
+        close(fd);
+        return (Ac_StrSliceRes)ac_res_err(err);
+    }
+
+    // Other files report a size of 0 or a size that doesn't match their contents
+    if (!S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return (Ac_StrSliceRes)ac_res_err(EINVAL);
+    }
+
+    // An empty file can't be mapped. Pseudo files like /proc entries are regular files that
+    // report a size of 0 too, so check that there really is nothing to read
+    if (st.st_size == 0)
+    {
+        char byte;
+        ssize_t bytes_read = read(fd, &byte, 1);
+        close(fd);
+        if (bytes_read != 0)
+            return (Ac_StrSliceRes)ac_res_err(EINVAL);
+
+        return (Ac_StrSliceRes)ac_res_ok(((Ac_StrSlice){.chars = "", .len = 0}));
+    }
+
+    size_t len = (size_t)st.st_size;
+    void* chars = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    // The mapping stays valid after the file is closed
+    close(fd);
+
+    if (chars == MAP_FAILED)
+        return (Ac_StrSliceRes)ac_res_err(err);
+
+    // The hints are only hints, so failing to apply them is fine
+    if (advice & AC_MAP_SEQUENTIAL)
+        madvise(chars, len, MADV_SEQUENTIAL);
+    if (advice & AC_MAP_RANDOM)
+        madvise(chars, len, MADV_RANDOM);
+    if (advice & AC_MAP_WILLNEED)
+        madvise(chars, len, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    if (advice & AC_MAP_HUGEPAGE)
+        madvise(chars, len, MADV_HUGEPAGE);
+#endif
 
-    // sprintf automatically adds '\0', so take account for it
-    str->len += needed - 1;
+    return (Ac_StrSliceRes)ac_res_ok(((Ac_StrSlice){.chars = chars, .len = len}));
 }
 
-ACLIBDEF void ac_str_prepend(Ac_String* str, char* chs)
+ACLIBDEF void ac_str_unmap_file(Ac_StrSlice* slice)
 {
-    size_t size = strlen(chs);
-    ac_str_ensure_cap(str, str->len + size);
+    if (slice->len > 0)
+        munmap(slice->chars, slice->len);
 
-    memcpy(str->chars + size, str->chars, str->len * sizeof(char));
-    memcpy(str->chars, chs, size * sizeof(char));
+    slice->chars = NULL;
+    slice->len = 0;
+}
 
-    str->chars[str->len + size] = '\0';
-    str->len += size;
+ACLIBDEF void ac_str_trim_front(Ac_String* str)
+{
+    if (str->len == 0)
+        return;
+
+    size_t end = __aclib_scan_non_ws(str->chars, str->len);
+    ac_str_remove_range(str, 0, end);
 }
 
-ACLIBDEF void ac_str_prependf(Ac_String* str, const char* fmt, ...)
+ACLIBDEF void ac_str_trim_back(Ac_String* str)
 {
-    va_list args;
-    va_start(args, fmt);
-    size_t needed = vsnprintf(NULL, 0, fmt, args) + 1;
-    va_end(args);
+    if (str->len == 0)
+        return;
+
+    size_t start = __aclib_rscan_non_ws(str->chars, str->len);
+    ac_str_remove_range(str, start, str->len);
+}
 
-    ac_str_ensure_cap(str, str->len + needed);
+ACLIBDEF void ac_str_trim(Ac_String* str)
+{
+    ac_str_trim_back(str);
+    ac_str_trim_front(str);
+}
 
-    memcpy(str->chars + needed - 1, str->chars, str->len * sizeof(char));
+ACLIBDEF Ac_StrSlice ac_str_trimmed_front(Ac_StrSlice slice)
+{
+    if (slice.len == 0)
+        return (Ac_StrSlice){0};
 
-    Ac_StrSlice format_buf = ac_str_slice_with_len(needed - 1);
-    va_start(args, fmt);
-    vsprintf(format_buf.chars, fmt, args);
-    va_end(args);
+    size_t end = __aclib_scan_non_ws(slice.chars, slice.len);
+    return (Ac_StrSlice){.chars = slice.chars + end, .len = slice.len - end};
+}
 
-    memcpy(str->chars, format_buf.chars, format_buf.len * sizeof(char));
+ACLIBDEF Ac_StrSlice ac_str_trimmed_back(Ac_StrSlice slice)
+{
+    if (slice.len == 0)
+        return (Ac_StrSlice){0};
 
-    ac_str_slice_free(&format_buf);
+    size_t start = __aclib_rscan_non_ws(slice.chars, slice.len);
+    return (Ac_StrSlice){.chars = slice.chars, .len = start};
+}
 
-    // sprintf automatically adds '\0', so take account for it
-    str->len += needed - 1;
+ACLIBDEF Ac_StrSlice ac_str_trimmed(Ac_StrSlice slice)
+{
+    Ac_StrSlice trimmed_front = ac_str_trimmed_front(slice);
+    return ac_str_trimmed_back(trimmed_front);
 }
 
-ACLIBDEF char ac_str_pop(Ac_String* str)
+ACLIBDEF Ac_StrSlice ac_str_trimmed_by(Ac_StrSlice slice, const Ac_ByteSet* set)
 {
-    ACLIB_ASSERT_FN(str->len >= 1 &&
-                    "String failed to pop, expected length of >= 1, but got length of 0");
-    str->len -= 1;
-    char popped = str->chars[str->len];
-    str->chars[str->len] = '\0';
-    return popped;
+    size_t start = __aclib_byteset_scan(set, slice.chars, slice.len, true);
+    size_t end = start + __aclib_byteset_rscan(set, slice.chars + start, slice.len - start, true);
+    return __aclib_str_sub(slice, start, end);
 }
 
-ACLIBDEF Ac_CharOpt ac_str_pop_opt(Ac_String* str)
+/// Replace every borrowed part in a vector with an owned clone
+ACLIBDEF void __aclib_str_clone_parts(Ac_StrVec* parts, const Ac_Allocator* allocator)
 {
-    if (str->len == 0)
-        return (Ac_CharOpt)ac_opt_none();
+    AC_VEC_FOREACH(Ac_StrSlice, *parts, part)
+    {
+        *part = ac_str_slice_clone_in(allocator, *part);
+    }
+}
 
-    return (Ac_CharOpt)ac_opt_some(ac_str_pop(str));
+ACLIBDEF void ac_str_split_by_into(Ac_StrVec* parts, Ac_StrSlice slice, char delim)
+{
+    size_t start = 0;
+    size_t end;
+
+    while ((end = start + __aclib_scan_byte(slice.chars + start, slice.len - start, delim)) <
+           slice.len)
+    {
+        ac_vec_push(parts, __aclib_str_sub(slice, start, end));
+        start = end + 1;
+    }
+
+    ac_vec_push(parts, __aclib_str_sub(slice, start, slice.len));
 }
 
-ACLIBDEF char ac_str_shift(Ac_String* str)
+ACLIBDEF void ac_str_split_by_many_into(Ac_StrVec* parts, Ac_StrSlice slice, char* delims)
 {
-    ACLIB_ASSERT_FN(str->len >= 1 &&
-                    "String failed to shift, expected length of >= 1, but got length of 0");
+    Ac_ByteSet set = ac_byteset_from(delims);
+    ac_str_split_by_set_into(parts, slice, &set);
+}
 
-    char shifted = str->chars[0];
+ACLIBDEF void ac_str_split_by_set_into(Ac_StrVec* parts, Ac_StrSlice slice, const Ac_ByteSet* set)
+{
+    size_t start = 0;
+    size_t end;
 
-    memcpy(str->chars, str->chars + 1, (str->len - 1) * sizeof(char));
-    str->len -= 1;
-    str->chars[str->len] = '\0';
+    while ((end = start + __aclib_byteset_scan(set, slice.chars + start, slice.len - start,
+                                               false)) < slice.len)
+    {
+        ac_vec_push(parts, __aclib_str_sub(slice, start, end));
+        start = end + 1;
+    }
 
-    return shifted;
+    ac_vec_push(parts, __aclib_str_sub(slice, start, slice.len));
 }
 
-ACLIBDEF Ac_CharOpt ac_str_shift_opt(Ac_String* str)
+ACLIBDEF void ac_str_split_by_once_into(Ac_StrVec* parts, Ac_StrSlice slice, char delim)
 {
-    if (str->len == 0)
-        return (Ac_CharOpt)ac_opt_none();
+    size_t end = __aclib_scan_byte(slice.chars, slice.len, delim);
+
+    if (end == slice.len)
+    {
+        ac_vec_push(parts, slice);
+        return;
+    }
+
+    ac_vec_push(parts, __aclib_str_sub(slice, 0, end));
+    ac_vec_push(parts, __aclib_str_sub(slice, end + 1, slice.len));
+}
+
+ACLIBDEF void ac_str_split_at_into(Ac_StrVec* parts, Ac_StrSlice slice, size_t idx)
+{
+    if (idx >= slice.len)
+    {
+        ac_vec_push(parts, slice);
+        return;
+    }
+
+    ac_vec_push(parts, __aclib_str_sub(slice, 0, idx));
+    ac_vec_push(parts, __aclib_str_sub(slice, idx, slice.len));
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_by_borrowed(Ac_StrSlice slice, char delim)
+{
+    Ac_StrVec parts = {0};
+    ac_str_split_by_into(&parts, slice, delim);
+    return parts;
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_by_many_borrowed(Ac_StrSlice slice, char* delims)
+{
+    Ac_StrVec parts = {0};
+    ac_str_split_by_many_into(&parts, slice, delims);
+    return parts;
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_by_once_borrowed(Ac_StrSlice slice, char delim)
+{
+    Ac_StrVec parts = {0};
+    ac_str_split_by_once_into(&parts, slice, delim);
+    return parts;
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_at_borrowed(Ac_StrSlice slice, size_t idx)
+{
+    Ac_StrVec parts = {0};
+    ac_str_split_at_into(&parts, slice, idx);
+    return parts;
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_by_set_borrowed(Ac_StrSlice slice, const Ac_ByteSet* set)
+{
+    Ac_StrVec parts = {0};
+    ac_str_split_by_set_into(&parts, slice, set);
+    return parts;
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_by(Ac_String str, char delim)
+{
+    Ac_StrVec parts = {.allocator = str.allocator};
+    ac_str_split_by_into(&parts, str.slice, delim);
+    __aclib_str_clone_parts(&parts, str.allocator);
+    return parts;
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_by_many(Ac_String str, char* delims)
+{
+    Ac_StrVec parts = {.allocator = str.allocator};
+    ac_str_split_by_many_into(&parts, str.slice, delims);
+    __aclib_str_clone_parts(&parts, str.allocator);
+    return parts;
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_by_once(Ac_String str, char delim)
+{
+    Ac_StrVec parts = {.allocator = str.allocator};
+    ac_str_split_by_once_into(&parts, str.slice, delim);
+    __aclib_str_clone_parts(&parts, str.allocator);
+    return parts;
+}
+
+ACLIBDEF Ac_StrVec ac_str_split_at(Ac_String str, size_t idx)
+{
+    Ac_StrVec parts = {.allocator = str.allocator};
+    ac_str_split_at_into(&parts, str.slice, idx);
+    __aclib_str_clone_parts(&parts, str.allocator);
+    return parts;
+}
+
+ACLIBDEF void ac_str_parts_free(Ac_StrVec* parts)
+{
+    for (size_t i = 0; i < parts->len; i++)
+        ac_str_slice_free_in(parts->allocator, &parts->items[i]);
+    ac_vec_free(*parts);
+}
+
+ACLIBDEF Ac_StrSplitIter ac_str_split_iter(Ac_StrSlice slice, char delim)
+{
+    return (Ac_StrSplitIter){
+        .rest = slice,
+        .kind = AC_SPLIT_CHAR,
+        .delim = delim,
+        .splits_left = SIZE_MAX,
+    };
+}
+
+ACLIBDEF Ac_StrSplitIter ac_str_split_iter_many(Ac_StrSlice slice, char* delims)
+{
+    Ac_ByteSet set = ac_byteset_from(delims);
+    return ac_str_split_iter_set(slice, &set);
+}
+
+ACLIBDEF Ac_StrSplitIter ac_str_split_iter_set(Ac_StrSlice slice, const Ac_ByteSet* set)
+{
+    return (Ac_StrSplitIter){
+        .rest = slice,
+        .kind = AC_SPLIT_SET,
+        .set = *set,
+        .splits_left = SIZE_MAX,
+    };
+}
+
+ACLIBDEF Ac_StrSplitIter ac_str_split_iter_substr(Ac_StrSlice slice, Ac_StrSlice needle)
+{
+    return (Ac_StrSplitIter){
+        .rest = slice,
+        .kind = AC_SPLIT_SUBSTR,
+        .needle = needle,
+        .splits_left = SIZE_MAX,
+    };
+}
+
+ACLIBDEF Ac_StrSliceOpt ac_str_split_iter_next(Ac_StrSplitIter* iter)
+{
+    if (iter->done)
+        return (Ac_StrSliceOpt)ac_opt_none();
+
+    Ac_StrSlice rest = iter->rest;
+    size_t end = rest.len;
+    size_t delim_len = 1;
+
+    if (iter->splits_left > 0)
+    {
+        switch (iter->kind)
+        {
+        case AC_SPLIT_CHAR:
+            end = __aclib_scan_byte(rest.chars, rest.len, iter->delim);
+            break;
+        case AC_SPLIT_SET:
+            end = __aclib_byteset_scan(&iter->set, rest.chars, rest.len, false);
+            break;
+        case AC_SPLIT_SUBSTR:
+        {
+            delim_len = iter->needle.len;
+            if (delim_len == 0)
+                break;
+
+            Ac_SizeOpt found = ac_str_find(rest, iter->needle);
+            if (found.tag == AC_OPT_SOME)
+                end = found.some;
+            break;
+        }
+        }
+    }
+
+    if (end == rest.len)
+    {
+        iter->done = true;
+        return (Ac_StrSliceOpt)ac_opt_some(rest);
+    }
+
+    if (iter->splits_left != SIZE_MAX)
+        iter->splits_left--;
+
+    iter->rest = __aclib_str_sub(rest, end + delim_len, rest.len);
+    return (Ac_StrSliceOpt)ac_opt_some(__aclib_str_sub(rest, 0, end));
+}
+
+ACLIBDEF Ac_StrNeedle ac_str_needle(Ac_StrSlice needle)
+{
+    Ac_StrNeedle compiled = {.needle = needle};
+    __aclib_two_way_factorize(needle.chars, needle.len, false, &compiled.crit, &compiled.period,
+                              &compiled.periodic);
+    __aclib_two_way_factorize(needle.chars, needle.len, true, &compiled.rev_crit,
+                              &compiled.rev_period, &compiled.rev_periodic);
+    return compiled;
+}
+
+ACLIBDEF Ac_SizeOpt ac_str_needle_find(const Ac_StrNeedle* needle, Ac_StrSlice haystack)
+{
+    size_t needle_len = needle->needle.len;
+    if (needle_len > haystack.len)
+        return (Ac_SizeOpt)ac_opt_none();
+    if (needle_len == 0)
+        return (Ac_SizeOpt)ac_opt_some(0);
+
+    size_t idx;
+    if (needle_len == 1)
+    {
+        idx = __aclib_scan_byte(haystack.chars, haystack.len, needle->needle.chars[0]);
+        if (idx == haystack.len)
+            idx = SIZE_MAX;
+    }
+#ifdef __ACLIB_SSE2
+    else if (!__aclib_uses_two_way(needle_len))
+    {
+        idx = __aclib_filter_find(haystack.chars, haystack.len, needle->needle.chars, needle_len);
+    }
+#endif
+    else
+    {
+        idx = __aclib_two_way(haystack.chars, haystack.len, needle->needle.chars, needle_len,
+                              needle->crit, needle->period, needle->periodic, false);
+    }
+
+    return idx == SIZE_MAX ? (Ac_SizeOpt)ac_opt_none() : (Ac_SizeOpt)ac_opt_some(idx);
+}
+
+ACLIBDEF Ac_SizeOpt ac_str_needle_rfind(const Ac_StrNeedle* needle, Ac_StrSlice haystack)
+{
+    size_t needle_len = needle->needle.len;
+    if (needle_len > haystack.len)
+        return (Ac_SizeOpt)ac_opt_none();
+    if (needle_len == 0)
+        return (Ac_SizeOpt)ac_opt_some(haystack.len);
+
+#ifdef __ACLIB_SSE2
+    if (!__aclib_uses_two_way(needle_len))
+    {
+        size_t idx =
+            __aclib_filter_rfind(haystack.chars, haystack.len, needle->needle.chars, needle_len);
+        return idx == SIZE_MAX ? (Ac_SizeOpt)ac_opt_none() : (Ac_SizeOpt)ac_opt_some(idx);
+    }
+#endif
+
+    // The reversed search gives the index of the match's end, counted from the back
+    size_t rev_idx = __aclib_two_way(haystack.chars, haystack.len, needle->needle.chars,
+                                     needle_len, needle->rev_crit, needle->rev_period,
+                                     needle->rev_periodic, true);
+    if (rev_idx == SIZE_MAX)
+        return (Ac_SizeOpt)ac_opt_none();
+    return (Ac_SizeOpt)ac_opt_some(haystack.len - rev_idx - needle_len);
+}
+
+ACLIBDEF void ac_str_needle_find_all_into(Ac_SizeVec* matches, const Ac_StrNeedle* needle,
+                                          Ac_StrSlice haystack)
+{
+    // An empty needle would match at every index without moving forward
+    if (needle->needle.len == 0)
+        return;
+
+    size_t start = 0;
+    for (;;)
+    {
+        Ac_StrSlice rest = __aclib_str_sub(haystack, start, haystack.len);
+        Ac_SizeOpt found = ac_str_needle_find(needle, rest);
+        if (found.tag == AC_OPT_NONE)
+            break;
+
+        ac_vec_push(matches, start + found.some);
+        start += found.some + needle->needle.len;
+    }
+}
+
+ACLIBDEF Ac_SizeOpt ac_str_find(Ac_StrSlice haystack, Ac_StrSlice needle)
+{
+    Ac_StrNeedle compiled = {.needle = needle};
+    if (__aclib_uses_two_way(needle.len) && needle.len <= haystack.len)
+        compiled = ac_str_needle(needle);
+    return ac_str_needle_find(&compiled, haystack);
+}
+
+ACLIBDEF Ac_SizeOpt ac_str_rfind(Ac_StrSlice haystack, Ac_StrSlice needle)
+{
+    Ac_StrNeedle compiled = {.needle = needle};
+    if (__aclib_uses_two_way(needle.len) && needle.len <= haystack.len)
+        compiled = ac_str_needle(needle);
+    return ac_str_needle_rfind(&compiled, haystack);
+}
 
-    return (Ac_CharOpt)ac_opt_some(ac_str_shift(str));
+ACLIBDEF Ac_SizeVec ac_str_find_all(Ac_StrSlice haystack, Ac_StrSlice needle)
+{
+    Ac_SizeVec matches = {0};
+    Ac_StrNeedle compiled = ac_str_needle(needle);
+    ac_str_needle_find_all_into(&matches, &compiled, haystack);
+    return matches;
 }
 
-ACLIBDEF char* ac_str_clone_chars(Ac_String str)
+ACLIBDEF Ac_MultiMatcher ac_multi_matcher_from(Ac_StrVec patterns, bool ignore_case)
 {
-    char* buffer = (char*)malloc((str.len + 1) * sizeof(char));
+    Ac_MultiMatcher matcher = {.ignore_case = ignore_case};
 
-    if (buffer == NULL)
+    // Only the bytes in the patterns need their own column in the transition table. Every other
+    // byte always leads to the same state as the others
+    size_t class_count = 1;
+    for (size_t i = 0; i < patterns.len; i++)
     {
-        ac_log(ACLIB_ERR, "Failed to clone string chars\n");
-        exit(EXIT_FAILURE);
+        for (size_t j = 0; j < patterns.items[i].len; j++)
+        {
+            uint8_t ch = (uint8_t)patterns.items[i].chars[j];
+            if (ignore_case)
+                ch = (uint8_t)ac_ascii_to_lowercase((char)ch);
+            if (matcher.classes[ch] == 0)
+                matcher.classes[ch] = (uint16_t)class_count++;
+        }
     }
+    if (ignore_case)
+    {
+        for (int ch = 'A'; ch <= 'Z'; ch++)
+            matcher.classes[ch] = matcher.classes[ch - 'A' + 'a'];
+    }
+    matcher.class_count = class_count;
 
-    memcpy(buffer, str.chars, str.len * sizeof(char));
-    buffer[str.len] = '\0';
+    // Build the trie in the transition table. Until a state's row is finished below, a 0 means
+    // that there's no edge, as no edge in the trie leads back to the root
+    ac_vec_ensure_cap(&matcher.transitions, class_count);
+    memset(matcher.transitions.items, 0, class_count * sizeof(uint32_t));
+    matcher.transitions.len = class_count;
+    ac_vec_push(&matcher.outputs, UINT32_MAX);
 
-    return buffer;
-}
+    for (size_t i = 0; i < patterns.len; i++)
+    {
+        Ac_StrSlice pattern = patterns.items[i];
+        ac_vec_push(&matcher.pattern_lens, pattern.len);
+        if (pattern.len == 0)
+            continue;
 
-ACLIBDEF Ac_StrSlice ac_str_drain(Ac_String* str)
-{
-    Ac_StrSlice slice = ac_str_slice_from(str->chars);
+        uint32_t state = 0;
+        for (size_t j = 0; j < pattern.len; j++)
+        {
+            size_t edge = state * class_count + matcher.classes[(uint8_t)pattern.chars[j]];
+            if (matcher.transitions.items[edge] == 0)
+            {
+                size_t end = matcher.transitions.len;
+                ac_vec_ensure_cap(&matcher.transitions, end + class_count);
+                memset(matcher.transitions.items + end, 0, class_count * sizeof(uint32_t));
+                matcher.transitions.len += class_count;
+                matcher.transitions.items[edge] = (uint32_t)matcher.outputs.len;
+                ac_vec_push(&matcher.outputs, UINT32_MAX);
+            }
+            state = matcher.transitions.items[edge];
+        }
 
-    *str = (Ac_String){0};
+        if (matcher.outputs.items[state] == UINT32_MAX)
+            matcher.outputs.items[state] = (uint32_t)i;
+    }
 
-    return slice;
-}
+    size_t state_count = matcher.outputs.len;
+    Ac_VecDef(uint32_t) fail = {0};
+    Ac_VecDef(uint32_t) queue = {0};
+    ac_vec_reserve_exact(&fail, state_count);
+    ac_vec_reserve_exact(&queue, state_count);
+    ac_vec_reserve_exact(&matcher.output_links, state_count);
+    ac_vec_reserve_exact(&matcher.next_outputs, state_count);
+    fail.len = state_count;
+    matcher.output_links.len = state_count;
+    matcher.next_outputs.len = state_count;
+
+    fail.items[0] = 0;
+    matcher.output_links.items[0] = UINT32_MAX;
+    queue.items[queue.len++] = 0;
+
+    // Visit the states breadth first, so the failure state of a state is always finished before
+    // it. A missing edge is replaced by the failure state's edge, which turns the trie into a DFA
+    // that never has to follow a failure link while searching
+    for (size_t head = 0; head < queue.len; head++)
+    {
+        uint32_t state = queue.items[head];
+        uint32_t* row = matcher.transitions.items + state * class_count;
+        const uint32_t* fail_row = matcher.transitions.items + fail.items[state] * class_count;
 
-ACLIBDEF Ac_StrSlice ac_str_drain_range(Ac_String* str, size_t start, size_t end)
-{
-    Ac_StrSlice slice = ac_str_slice_range(*str, start, end);
-    slice = ac_str_slice_clone(slice);
+        for (size_t cls = 0; cls < class_count; cls++)
+        {
+            uint32_t next = row[cls];
+            uint32_t next_fail = state == 0 ? 0 : fail_row[cls];
+            if (next == 0)
+            {
+                row[cls] = next_fail;
+                continue;
+            }
 
-    ac_str_remove_range(str, start, end);
+            fail.items[next] = next_fail;
+            matcher.output_links.items[next] = matcher.outputs.items[next] != UINT32_MAX
+                                                   ? next
+                                                   : matcher.output_links.items[next_fail];
+            queue.items[queue.len++] = next;
+        }
+    }
 
-    return slice;
+    // The failure links are only needed to chain every pattern ending in a state together
+    for (size_t state = 0; state < state_count; state++)
+        matcher.next_outputs.items[state] = matcher.output_links.items[fail.items[state]];
+
+    ac_vec_free(fail);
+    ac_vec_free(queue);
+    return matcher;
 }
 
-ACLIBDEF void ac_str_remove(Ac_String* str, size_t idx)
+ACLIBDEF bool ac_multi_matcher_is_match(const Ac_MultiMatcher* matcher, Ac_StrSlice haystack)
 {
-    if (idx >= str->len)
-        return;
+    const uint32_t* transitions = matcher->transitions.items;
+    const uint32_t* output_links = matcher->output_links.items;
+    size_t class_count = matcher->class_count;
 
-    ac_str_remove_range(str, idx, idx + 1);
+    uint32_t state = 0;
+    for (size_t i = 0; i < haystack.len; i++)
+    {
+        state = transitions[state * class_count + matcher->classes[(uint8_t)haystack.chars[i]]];
+        if (output_links[state] != UINT32_MAX)
+            return true;
+    }
+    return false;
 }
 
-ACLIBDEF void ac_str_remove_range(Ac_String* str, size_t start, size_t end)
+ACLIBDEF void ac_multi_matcher_find_all_into(Ac_MultiMatchVec* matches,
+                                             const Ac_MultiMatcher* matcher, Ac_StrSlice haystack)
 {
-    if (start >= str->len || end > str->len || start >= end)
-        return;
+    const uint32_t* transitions = matcher->transitions.items;
+    const uint32_t* output_links = matcher->output_links.items;
+    size_t class_count = matcher->class_count;
 
-    if (end == str->len)
+    uint32_t state = 0;
+    for (size_t i = 0; i < haystack.len; i++)
     {
-        str->len = start;
-        str->chars[str->len] = '\0';
-        return;
-    }
+        state = transitions[state * class_count + matcher->classes[(uint8_t)haystack.chars[i]]];
 
-    memmove(str->chars + start, str->chars + end, (str->len - end) * sizeof(char));
-    str->len -= (end - start);
-    str->chars[str->len] = '\0';
+        for (uint32_t out = output_links[state]; out != UINT32_MAX;
+             out = matcher->next_outputs.items[out])
+        {
+            uint32_t pattern = matcher->outputs.items[out];
+            size_t len = matcher->pattern_lens.items[pattern];
+            Ac_MultiMatch match = {.pattern = pattern, .start = i + 1 - len, .len = len};
+            ac_vec_push(matches, match);
+        }
+    }
 }
 
-ACLIBDEF void ac_str_empty(Ac_String* str)
+ACLIBDEF Ac_MultiMatchVec ac_multi_matcher_find_all(const Ac_MultiMatcher* matcher,
+                                                    Ac_StrSlice haystack)
 {
-    str->len = 0;
-    if (str->chars)
-        str->chars[0] = '\0';
+    Ac_MultiMatchVec matches = {0};
+    ac_multi_matcher_find_all_into(&matches, matcher, haystack);
+    return matches;
 }
 
-ACLIBDEF void ac_str_free(Ac_String* str)
+ACLIBDEF void ac_multi_matcher_free(Ac_MultiMatcher* matcher)
 {
-    if (str->chars == NULL)
-        return;
+    ac_vec_free(matcher->transitions);
+    ac_vec_free(matcher->output_links);
+    ac_vec_free(matcher->next_outputs);
+    ac_vec_free(matcher->outputs);
+    ac_vec_free(matcher->pattern_lens);
+    matcher->class_count = 0;
+}
 
-    free(str->chars);
-    str->chars = (char*)0;
-    str->len = 0;
-    str->cap = 0;
+ACLIBDEF void ac_str_interner_init(Ac_StrInterner* interner)
+{
+    *interner = (Ac_StrInterner){0};
+    pthread_rwlock_init(&interner->lock, NULL);
 }
 
-ACLIBDEF void ac_str_ensure_cap(Ac_String* str, size_t new_cap)
+ACLIBDEF Ac_InternedStr ac_str_interner_intern(Ac_StrInterner* interner, Ac_StrSlice slice)
 {
-    if (str->cap < new_cap + 1)
-    {
-        // + 1 for the '\0'
-        str->chars = (char*)ACLIB_REALLOC_FN(str->chars, ((new_cap * ACLIB_VEC_GROWTH_RATE) + 1) *
-                                                             sizeof(char));
-        str->cap = new_cap;
+    Ac_InternedStrOpt found = ac_str_interner_find(interner, slice);
+    if (found.tag == AC_OPT_SOME)
+        return found.some;
 
-        if (str->chars == NULL)
-        {
-            ac_log(ACLIB_ERR, "Failed to reallocate string\n");
-            exit(EXIT_FAILURE);
-        }
+    pthread_rwlock_wrlock(&interner->lock);
 
-        str->chars[str->cap] = '\0';
+    // Another thread may have interned the string between the lookup and taking the lock
+    Ac_InternedStr interned;
+    __typeof__(interner->ids.entries) entry = ac_map_find(&interner->ids, slice);
+    if (entry != NULL)
+    {
+        interned = (Ac_InternedStr){.id = entry->value, .str = entry->key};
+    }
+    else
+    {
+        ACLIB_ASSERT_FN(interner->strings.len < UINT32_MAX && "Interner ran out of ids");
+        interned.id = (uint32_t)interner->strings.len;
+        interned.str = ac_arena_str_slice_clone(&interner->arena, slice);
+        ac_vec_push(&interner->strings, interned.str);
+        ac_map_insert(&interner->ids, interned.str, interned.id);
     }
-}
 
+    pthread_rwlock_unlock(&interner->lock);
+    return interned;
+}
 
-#define INTERNAC_BUF_SIZE 256
-ACLIBDEF size_t ac_str_read_file(Ac_String* buffer, FILE* file)
+ACLIBDEF Ac_InternedStrOpt ac_str_interner_find(Ac_StrInterner* interner, Ac_StrSlice slice)
 {
-    size_t bytes_read = 0;
-    char char_buf[INTERNAC_BUF_SIZE];
-    while (fgets(char_buf, INTERNAC_BUF_SIZE, file))
+    pthread_rwlock_rdlock(&interner->lock);
+
+    Ac_InternedStrOpt found = ac_opt_none();
+    __typeof__(interner->ids.entries) entry = ac_map_find(&interner->ids, slice);
+    if (entry != NULL)
     {
-        bytes_read += strlen(char_buf);
-        ac_str_append(buffer, char_buf);
+        Ac_InternedStr interned = {.id = entry->value, .str = entry->key};
+        found = (Ac_InternedStrOpt)ac_opt_some(interned);
     }
 
-    return bytes_read;
+    pthread_rwlock_unlock(&interner->lock);
+    return found;
 }
 
-ACLIBDEF size_t ac_str_read_lines(Ac_StrVec* linebuffer, FILE* file)
+ACLIBDEF Ac_StrSlice ac_str_interner_get(Ac_StrInterner* interner, uint32_t id)
 {
-    size_t bytes_read = 0;
+    pthread_rwlock_rdlock(&interner->lock);
+    ACLIB_ASSERT_FN(id < interner->strings.len && "Interned string id out of range");
+    Ac_StrSlice str = interner->strings.items[id];
+    pthread_rwlock_unlock(&interner->lock);
+    return str;
+}
 
-    char char_buf[INTERNAC_BUF_SIZE];
-    while (fgets(char_buf, INTERNAC_BUF_SIZE, file))
-    {
-        bytes_read += strlen(char_buf);
+ACLIBDEF void ac_str_interner_free(Ac_StrInterner* interner)
+{
+    ac_map_free(&interner->ids);
+    ac_vec_free(interner->strings);
+    ac_arena_free(&interner->arena);
+    pthread_rwlock_destroy(&interner->lock);
+}
 
-        Ac_String line = ac_str_from(char_buf);
-        size_t old_size = strlen(char_buf);
-        while (char_buf[strlen(char_buf) - 1] != '\n')
-        {
-            fgets(char_buf, INTERNAC_BUF_SIZE, file);
-            if (strlen(char_buf) == old_size)
-                break;
-            ac_str_append(&line, char_buf);
-        }
+/* END OF STRING IMPLEMENTATION */
 
-        // pop the '\n'
-        if (line.chars[line.len - 1] == '\n')
-            ac_str_pop(&line);
 
-        ac_vec_push(linebuffer, ac_str_owned_slice(line));
-        ac_str_free(&line);
-    }
 
-    return bytes_read;
-}
-#undef INTERNAC_BUF_SIZE
+/*                               *
+ *  SMALL STRING IMPLEMENTATION  *
+ *                               */
 
-ACLIBDEF void ac_str_trim_front(Ac_String* str)
-{
-    if (str->len == 0)
-        return;
+/// The size of the header in front of a heap small string's chars. It holds the allocator the
+/// chars were allocated with
+#define __ACLIB_SSO_HEADER sizeof(const Ac_Allocator*)
 
-    size_t end = 0;
-    while (end < str->len && ac_ascii_is_whitespace(str->chars[end]))
-        end++;
+/// Get the allocator a small string on the heap was allocated with
+#define __aclib_sso_allocator(str) (((const Ac_Allocator**)(str)->heap.chars)[-1])
 
-    ac_str_remove_range(str, 0, end);
+/// Set the length of a small string, and terminate it with a '\0'
+ACLIBDEF void __aclib_sso_set_len(Ac_SsoString* str, size_t len)
+{
+    if (ac_sso_is_inline(str))
+    {
+        str->small.len = (unsigned char)len;
+        str->small.chars[len] = '\0';
+    }
+    else
+    {
+        str->heap.len = len;
+        str->heap.chars[len] = '\0';
+    }
 }
 
-ACLIBDEF void ac_str_trim_back(Ac_String* str)
+ACLIBDEF Ac_SsoString ac_sso_from(char* chs)
 {
-    if (str->len == 0)
-        return;
-
-    size_t start = str->len;
-    while (start > 0 && ac_ascii_is_whitespace(str->chars[start - 1]))
-        start--;
-
-    ac_str_remove_range(str, start, str->len);
+    return ac_sso_from_slice(ac_str_slice_from(chs));
 }
 
-ACLIBDEF void ac_str_trim(Ac_String* str)
+ACLIBDEF Ac_SsoString ac_sso_from_slice(Ac_StrSlice slice)
 {
-    ac_str_trim_back(str);
-    ac_str_trim_front(str);
+    Ac_SsoString str = {0};
+    ac_sso_append_slice(&str, slice);
+    return str;
 }
 
-ACLIBDEF Ac_StrSlice ac_str_trimmed_front(Ac_StrSlice slice)
+ACLIBDEF void ac_sso_push(Ac_SsoString* str, char ch)
 {
-    if (slice.len == 0)
-        return (Ac_StrSlice){0};
+    size_t len = ac_sso_len(str);
+    ac_sso_ensure_cap(str, len + 1);
 
-    size_t end = 0;
-    while (end < slice.len && ac_ascii_is_whitespace(slice.chars[end]))
-        end++;
+    ac_sso_chars(str)[len] = ch;
+    __aclib_sso_set_len(str, len + 1);
+}
 
-    return (Ac_StrSlice){.chars = slice.chars + end, .len = slice.len - end};
+ACLIBDEF void ac_sso_append(Ac_SsoString* str, char* chs)
+{
+    ac_sso_append_slice(str, ac_str_slice_from(chs));
 }
 
-ACLIBDEF Ac_StrSlice ac_str_trimmed_back(Ac_StrSlice slice)
+ACLIBDEF void ac_sso_append_slice(Ac_SsoString* str, Ac_StrSlice slice)
 {
-    if (slice.len == 0)
-        return (Ac_StrSlice){0};
+    size_t len = ac_sso_len(str);
+    ac_sso_ensure_cap(str, len + slice.len);
+
+    memcpy(ac_sso_chars(str) + len, slice.chars, slice.len * sizeof(char));
+    __aclib_sso_set_len(str, len + slice.len);
+}
 
-    size_t start = slice.len;
-    while (start > 0 && ac_ascii_is_whitespace(slice.chars[start - 1]))
-        start--;
+ACLIBDEF char ac_sso_pop(Ac_SsoString* str)
+{
+    size_t len = ac_sso_len(str);
+    ACLIB_ASSERT_FN(len >= 1 &&
+                    "String failed to pop, expected length of >= 1, but got length of 0");
 
-    return (Ac_StrSlice){.chars = slice.chars, .len = start};
+    char popped = ac_sso_chars(str)[len - 1];
+    __aclib_sso_set_len(str, len - 1);
+    return popped;
 }
 
-ACLIBDEF Ac_StrSlice ac_str_trimmed(Ac_StrSlice slice)
+ACLIBDEF void ac_sso_empty(Ac_SsoString* str)
 {
-    Ac_StrSlice trimmed_front = ac_str_trimmed_front(slice);
-    return ac_str_trimmed_back(trimmed_front);
+    __aclib_sso_set_len(str, 0);
 }
 
-ACLIBDEF Ac_StrVec ac_str_split_by(Ac_String str, char delim)
+ACLIBDEF void ac_sso_ensure_cap(Ac_SsoString* str, size_t new_cap)
 {
-    size_t start = 0;
-    size_t end = 0;
+    if (new_cap <= ac_sso_cap(str))
+        return;
 
-    Ac_StrVec parts = {0};
+    // The buffer holds the header, the chars and the '\0'
+    size_t needed = __ACLIB_SSO_HEADER + new_cap + 1;
 
-    while (end <= str.len)
+    if (ac_sso_is_inline(str))
     {
-        if (str.chars[end] == delim)
-        {
-            Ac_StrSlice slice = ac_str_slice_range(str, start, end);
-            slice = ac_str_slice_clone(slice);
-
-            ac_vec_push(&parts, slice);
-            end++;
-            start = end;
-        }
-        end++;
+        const Ac_Allocator* allocator = ac_allocator_current();
+        size_t buf_cap = 0;
+        size_t len = str->small.len;
+        char* buffer = (char*)__aclib_grow(NULL, &buf_cap, &allocator, sizeof(char), needed,
+                                           ACLIB_STR_GROWTH_FN);
+        memcpy(buffer, &allocator, __ACLIB_SSO_HEADER);
+        memcpy(buffer + __ACLIB_SSO_HEADER, str->small.chars, (len + 1) * sizeof(char));
+
+        str->heap.chars = buffer + __ACLIB_SSO_HEADER;
+        str->heap.len = len;
+        str->heap.cap = __ACLIB_SSO_HEAP_CAP(buf_cap - __ACLIB_SSO_HEADER - 1);
+        return;
     }
 
-    Ac_StrSlice slice = ac_str_slice_range(str, start, str.len);
-    slice = ac_str_slice_clone(slice);
-
-    ac_vec_push(&parts, slice);
+    const Ac_Allocator* allocator = __aclib_sso_allocator(str);
+    size_t buf_cap = __ACLIB_SSO_HEADER + __ACLIB_SSO_CAP_OF(str->heap.cap) + 1;
+    char* buffer = (char*)__aclib_grow(str->heap.chars - __ACLIB_SSO_HEADER, &buf_cap, &allocator,
+                                       sizeof(char), needed, ACLIB_STR_GROWTH_FN);
 
-    return parts;
+    str->heap.chars = buffer + __ACLIB_SSO_HEADER;
+    str->heap.cap = __ACLIB_SSO_HEAP_CAP(buf_cap - __ACLIB_SSO_HEADER - 1);
 }
 
-/// Split a string by a set of delimeters
-ACLIBDEF Ac_StrVec ac_str_split_by_many(Ac_String str, char* delims)
+ACLIBDEF void ac_sso_free(Ac_SsoString* str)
 {
-    size_t start = 0;
-    size_t end = 0;
+    if (!ac_sso_is_inline(str))
+        ac_allocator_free(__aclib_sso_allocator(str), str->heap.chars - __ACLIB_SSO_HEADER);
 
-    Ac_StrVec parts = {0};
+    *str = (Ac_SsoString){0};
+}
 
-    while (end < str.len)
-    {
-        bool is_delim = false;
-        for (size_t i = 0; i < strlen(delims); i++)
-        {
-            if (str.chars[end] == delims[i])
-            {
-                is_delim = true;
-                break;
-            }
-        }
+/* END OF SMALL STRING IMPLEMENTATION */
 
-        if (is_delim)
-        {
-            Ac_StrSlice slice = ac_str_slice_range(str, start, end);
-            slice = ac_str_slice_clone(slice);
 
-            ac_vec_push(&parts, slice);
-            end++;
-            start = end;
-        }
-        end++;
-    }
 
-    Ac_StrSlice slice = ac_str_slice_range(str, start, str.len);
-    slice = ac_str_slice_clone(slice);
+/*                        *
+ *  ASCII IMPLEMENTATION  *
+ *                        */
 
-    ac_vec_push(&parts, slice);
+#ifdef __ACLIB_SSE2
+/// Get 0xFF for the bytes in a block that are in the range [lo, hi], and 0 for the others
+#define __aclib_sse2_in_range(block, lo, hi)                                                   \
+    _mm_cmpeq_epi8(_mm_min_epu8(_mm_sub_epi8((block), _mm_set1_epi8(lo)),                      \
+                                _mm_set1_epi8((char)((hi) - (lo)))),                           \
+                   _mm_sub_epi8((block), _mm_set1_epi8(lo)))
 
-    return parts;
-}
+/// Get 0xFF for the alphabetic bytes in a block. Setting the 0x20 bit maps 'A'-'Z' onto 'a'-'z',
+/// and no other byte onto them
+#define __aclib_sse2_alphabetic(block)                                                         \
+    __aclib_sse2_in_range(_mm_or_si128((block), _mm_set1_epi8(0x20)), 'a', 'z')
 
-/// Split a string by a delimeter once
-ACLIBDEF Ac_StrVec ac_str_split_by_once(Ac_String str, char delim)
+/// Get a mask of the bytes in a block that are in the letter or digit classes
+ACLIBDEF int __aclib_sse2_ascii_mask(uint8_t classes, __m128i block)
 {
-    size_t end = 0;
+    switch (classes)
+    {
+    case __ACLIB_ASCII_LETTERS:
+        return _mm_movemask_epi8(__aclib_sse2_alphabetic(block));
+    case __ACLIB_ASCII_DIGIT:
+        return _mm_movemask_epi8(__aclib_sse2_in_range(block, '0', '9'));
+    default:
+        return _mm_movemask_epi8(_mm_or_si128(__aclib_sse2_alphabetic(block),
+                                              __aclib_sse2_in_range(block, '0', '9')));
+    }
+}
+#endif
 
-    Ac_StrVec parts = {0};
+/// Find the index of the first char that is in none of the letter or digit classes, or len if all
+/// of them are
+ACLIBDEF size_t __aclib_ascii_scan_not(const char* chars, size_t len, uint8_t classes)
+{
+    size_t i = 0;
 
-    while (end < str.len)
+#ifdef __ACLIB_SSE2
+    for (; i + 16 <= len; i += 16)
     {
-        if (str.chars[end] == delim)
-        {
-            Ac_StrSlice slice = ac_str_slice_range(str, 0, end);
-            slice = ac_str_slice_clone(slice);
-
-            ac_vec_push(&parts, slice);
-            break;
-        }
-        end++;
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + i));
+        int mask = ~__aclib_sse2_ascii_mask(classes, block) & 0xFFFF;
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
     }
 
-    Ac_StrSlice rest = ac_str_slice_range(str, end + 1, str.len);
-    rest = ac_str_slice_clone(rest);
-    ac_vec_push(&parts, rest);
+    // Scan the tail with a block overlapping the chars that are already scanned
+    if (i < len && len >= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + len - 16));
+        int mask = (~__aclib_sse2_ascii_mask(classes, block) & 0xFFFF) >> (16 - (len - i));
+        return mask != 0 ? i + __builtin_ctz(mask) : len;
+    }
+#endif
 
-    return parts;
+    while (i < len && (__aclib_ascii_classes[(uint8_t)chars[i]] & classes) != 0)
+        i++;
+    return i;
 }
 
-/// Split a string at an index
-ACLIBDEF Ac_StrVec ac_str_split_at(Ac_String str, size_t idx)
+/// Copy len chars from src to dst, with the case of every ascii letter flipped to upper or lower.
+/// src and dst may be the same, but must not overlap otherwise
+ACLIBDEF void __aclib_ascii_convert_case(char* dst, const char* src, size_t len, bool upper)
 {
-    Ac_StrVec parts = {0};
+    size_t i = 0;
 
-    if (idx >= str.len)
+#ifdef __ACLIB_SSE2
+    char first = upper ? 'a' : 'A';
+    __m128i flip_bit = _mm_set1_epi8(0x20);
+    for (; i + 16 <= len; i += 16)
     {
-        ac_vec_push(&parts, ac_str_owned_slice(str));
-        return parts;
+        __m128i block = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i flip = _mm_and_si128(__aclib_sse2_in_range(block, first, first + 25), flip_bit);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(block, flip));
     }
 
-    Ac_StrSlice first_part = ac_str_slice_range(str, 0, idx);
-    first_part = ac_str_slice_clone(first_part);
-    ac_vec_push(&parts, first_part);
-
-    Ac_StrSlice second_part = ac_str_slice_range(str, idx, str.len);
-    second_part = ac_str_slice_clone(second_part);
-    ac_vec_push(&parts, second_part);
+    // Converting is idempotent, so the tail can be converted with a block overlapping the chars
+    // that are already converted
+    if (i < len && len >= 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(src + len - 16));
+        __m128i flip = _mm_and_si128(__aclib_sse2_in_range(block, first, first + 25), flip_bit);
+        _mm_storeu_si128((__m128i*)(dst + len - 16), _mm_xor_si128(block, flip));
+        return;
+    }
+#else
+    // Find the letters to flip in each byte's low 7 bits, where adding to a byte can't carry into
+    // the next one, and skip the bytes that aren't ascii
+    uint64_t below = __ACLIB_SWAR_ONES * (uint64_t)(upper ? 0x80 - 'a' : 0x80 - 'A');
+    uint64_t above = __ACLIB_SWAR_ONES * (uint64_t)(upper ? 0x7F - 'z' : 0x7F - 'Z');
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, src + i, sizeof(word));
+        uint64_t low_bits = word & ~__ACLIB_SWAR_HIGHS;
+        uint64_t letters = ((low_bits + below) ^ (low_bits + above)) & ~word & __ACLIB_SWAR_HIGHS;
+        word ^= letters >> 2;
+        memcpy(dst + i, &word, sizeof(word));
+    }
+#endif
 
-    return parts;
+    for (; i < len; i++)
+        dst[i] = upper ? ac_ascii_to_uppercase(src[i]) : ac_ascii_to_lowercase(src[i]);
 }
 
-/* END OF STRING IMPLEMENTATION */
-
-
+ACLIBDEF void ac_ascii_make_uppercase(Ac_StrSlice slice)
+{
+    __aclib_ascii_convert_case(slice.chars, slice.chars, slice.len, true);
+}
 
-/*                        *
- *  ASCII IMPLEMENTATION  *
- *                        */
+ACLIBDEF void ac_ascii_make_lowercase(Ac_StrSlice slice)
+{
+    __aclib_ascii_convert_case(slice.chars, slice.chars, slice.len, false);
+}
 
-char ac_ascii_is_alphabetic(char ch)
+ACLIBDEF Ac_String ac_ascii_uppercased(Ac_StrSlice slice)
 {
-    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+    Ac_String str = ac_str_with_capacity(slice.len);
+    __aclib_ascii_convert_case(str.chars, slice.chars, slice.len, true);
+    str.len = slice.len;
+    return str;
 }
 
-bool ac_ascii_is_numeric(char ch)
+ACLIBDEF Ac_String ac_ascii_lowercased(Ac_StrSlice slice)
 {
-    return ch >= '0' && ch <= '9';
+    Ac_String str = ac_str_with_capacity(slice.len);
+    __aclib_ascii_convert_case(str.chars, slice.chars, slice.len, false);
+    str.len = slice.len;
+    return str;
 }
 
-bool ac_ascii_is_alphanumeric(char ch)
+ACLIBDEF bool ac_ascii_all_alphabetic(Ac_StrSlice slice)
 {
-    return ac_ascii_is_alphabetic(ch) || ac_ascii_is_numeric(ch);
+    return __aclib_ascii_scan_not(slice.chars, slice.len, __ACLIB_ASCII_LETTERS) == slice.len;
 }
 
-bool ac_ascii_is_whitespace(char ch)
+ACLIBDEF bool ac_ascii_all_numeric(Ac_StrSlice slice)
 {
-    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' || ch == '\f';
+    return __aclib_ascii_scan_not(slice.chars, slice.len, __ACLIB_ASCII_DIGIT) == slice.len;
 }
 
-bool ac_ascii_is_uppercase(char ch)
+ACLIBDEF bool ac_ascii_all_alphanumeric(Ac_StrSlice slice)
 {
-    return ch >= 'A' && ch <= 'Z';
+    return __aclib_ascii_scan_not(slice.chars, slice.len,
+                                  __ACLIB_ASCII_LETTERS | __ACLIB_ASCII_DIGIT) == slice.len;
 }
 
-bool ac_ascii_is_lowercase(char ch)
+ACLIBDEF bool ac_ascii_all_whitespace(Ac_StrSlice slice)
 {
-    return ch >= 'a' && ch <= 'z';
+    return __aclib_scan_non_ws(slice.chars, slice.len) == slice.len;
 }
 
-char ac_ascii_to_uppercase(char ch)
+ACLIBDEF size_t ac_ascii_find_non_alphabetic(Ac_StrSlice slice)
 {
-    if (!ac_ascii_is_alphabetic(ch))
-        return ch;
+    return __aclib_ascii_scan_not(slice.chars, slice.len, __ACLIB_ASCII_LETTERS);
+}
 
-    // e.g. convert 1000010 (B) to 1100010 (b)
-    return ch & ~0x20;
+ACLIBDEF size_t ac_ascii_find_non_numeric(Ac_StrSlice slice)
+{
+    return __aclib_ascii_scan_not(slice.chars, slice.len, __ACLIB_ASCII_DIGIT);
 }
 
-char ac_ascii_to_lowercase(char ch)
+ACLIBDEF size_t ac_ascii_find_non_alphanumeric(Ac_StrSlice slice)
 {
-    if (!ac_ascii_is_alphabetic(ch))
-        return ch;
+    return __aclib_ascii_scan_not(slice.chars, slice.len,
+                                  __ACLIB_ASCII_LETTERS | __ACLIB_ASCII_DIGIT);
+}
 
-    // e.g. convert 1000010 (B) to 1100010 (b)
-    return ch | 0x20;
+ACLIBDEF size_t ac_ascii_find_non_whitespace(Ac_StrSlice slice)
+{
+    return __aclib_scan_non_ws(slice.chars, slice.len);
 }
 
 /* END OF ASCII IMPLEMENTATION */
@@ -1581,6 +7893,7 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 #define OptTag Ac_OptTag
 #define OptDef Ac_OptDef
 #define CharOpt Ac_CharOpt
+#define SizeOpt Ac_SizeOpt
 #define opt_some ac_opt_some
 #define opt_unwrap ac_opt_unwrap
 #define opt_unwrap_or ac_opt_unwrap_or
@@ -1589,6 +7902,46 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 
 /* END OF RESULT STRIP PREFIX */
 
+/*                          *
+ *  ALLOCATOR STRIP PREFIX  *
+ *                          */
+
+#define Allocator Ac_Allocator
+
+#define allocator_current ac_allocator_current
+#define allocator_alloc ac_allocator_alloc
+#define allocator_realloc ac_allocator_realloc
+#define allocator_free ac_allocator_free
+#define allocator_usable_size ac_allocator_usable_size
+
+/* END OF ALLOCATOR STRIP PREFIX */
+
+
+
+/*                      *
+ *  ARENA STRIP PREFIX  *
+ *                      */
+
+#define ARENA_ALIGN AC_ARENA_ALIGN
+
+#define ArenaChunk Ac_ArenaChunk
+#define Arena Ac_Arena
+#define ArenaMark Ac_ArenaMark
+
+#define arena_alloc ac_arena_alloc
+#define arena_alloc_aligned ac_arena_alloc_aligned
+#define arena_calloc ac_arena_calloc
+#define arena_realloc ac_arena_realloc
+#define arena_mark ac_arena_mark
+#define arena_reset_to ac_arena_reset_to
+#define arena_reset ac_arena_reset
+#define arena_free ac_arena_free
+#define arena_allocator ac_arena_allocator
+
+/* END OF ARENA STRIP PREFIX */
+
+
+
 /*                      *
  *  VECTOR STRIP PREFIX  *
  *                      */
@@ -1611,11 +7964,84 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 #define vec_empty ac_vec_empty
 #define vec_free ac_vec_free
 #define vec_ensure_cap ac_vec_ensure_cap
+#define vec_reserve_exact ac_vec_reserve_exact
+#define vec_shrink_to_fit ac_vec_shrink_to_fit
+
+#define GrowthFn Ac_GrowthFn
+#define growth_geometric ac_growth_geometric
+#define growth_pow2 ac_growth_pow2
+#define growth_exact ac_growth_exact
 
 /* END OF VECTOR STRIP PREFIX */
 
 
 
+/*                             *
+ *  SMALL VECTOR STRIP PREFIX  *
+ *                             */
+
+#define SmallVecDef Ac_SmallVecDef
+
+#define smallvec_is_inline ac_smallvec_is_inline
+
+/* END OF SMALL VECTOR STRIP PREFIX */
+
+
+
+/*                      *
+ *  DEQUE STRIP PREFIX  *
+ *                      */
+
+#define DequeDef Ac_DequeDef
+
+#define deque_at ac_deque_at
+#define deque_front ac_deque_front
+#define deque_back ac_deque_back
+#define deque_push_back ac_deque_push_back
+#define deque_push_front ac_deque_push_front
+#define deque_pop_back ac_deque_pop_back
+#define deque_pop_front ac_deque_pop_front
+#define deque_pop_back_opt ac_deque_pop_back_opt
+#define deque_pop_front_opt ac_deque_pop_front_opt
+#define deque_front_slice ac_deque_front_slice
+#define deque_back_slice ac_deque_back_slice
+#define deque_empty ac_deque_empty
+#define deque_free ac_deque_free
+#define deque_ensure_cap ac_deque_ensure_cap
+
+/* END OF DEQUE STRIP PREFIX */
+
+
+
+/*                    *
+ *  MAP STRIP PREFIX  *
+ *                    */
+
+#define MapHashFn Ac_MapHashFn
+#define MapEqlFn Ac_MapEqlFn
+#define MapCore Ac_MapCore
+#define MapDef Ac_MapDef
+
+#define map_with ac_map_with
+#define map_insert ac_map_insert
+#define map_get ac_map_get
+#define map_find ac_map_find
+#define map_contains ac_map_contains
+#define map_remove ac_map_remove
+#define map_reserve ac_map_reserve
+#define map_rehash ac_map_rehash
+#define map_empty ac_map_empty
+#define map_free ac_map_free
+#define MAP_FOREACH AC_MAP_FOREACH
+#define map_hash_bytes ac_map_hash_bytes
+#define map_eql_bytes ac_map_eql_bytes
+#define map_hash_str ac_map_hash_str
+#define map_eql_str ac_map_eql_str
+
+/* END OF MAP STRIP PREFIX */
+
+
+
 /*                      *
  *  SLICE STRIP PREFIX  *
  *                      */
@@ -1639,6 +8065,29 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 #define String Ac_String
 #define StrSlice Ac_StrSlice
 #define StrVec Ac_StrVec
+#define StrLines Ac_StrLines
+#define SizeVec Ac_SizeVec
+#define StrNeedle Ac_StrNeedle
+#define StrHasher Ac_StrHasher
+#define LineReader Ac_LineReader
+#define StrSliceOpt Ac_StrSliceOpt
+#define StrSliceRes Ac_StrSliceRes
+#define ParsedI64 Ac_ParsedI64
+#define ParsedU64 Ac_ParsedU64
+#define ParsedF64 Ac_ParsedF64
+#define ParsedI64Res Ac_ParsedI64Res
+#define ParsedU64Res Ac_ParsedU64Res
+#define ParsedF64Res Ac_ParsedF64Res
+#define MapAdvice Ac_MapAdvice
+#define StrSplitKind Ac_StrSplitKind
+#define ByteSet Ac_ByteSet
+#define StrSplitIter Ac_StrSplitIter
+#define MultiMatch Ac_MultiMatch
+#define MultiMatchVec Ac_MultiMatchVec
+#define MultiMatcher Ac_MultiMatcher
+#define InternedStr Ac_InternedStr
+#define InternedStrOpt Ac_InternedStrOpt
+#define StrInterner Ac_StrInterner
 
 #define str_slice_with_len ac_str_slice_with_len
 #define str_slice_from ac_str_slice_from
@@ -1646,15 +8095,33 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 #define str_slice_clone ac_str_slice_clone
 #define str_slice_range ac_str_slice_range
 #define str_slice_free ac_str_slice_free
+#define arena_str_slice_with_len ac_arena_str_slice_with_len
+#define arena_str_slice_clone ac_arena_str_slice_clone
+#define str_slice_clone_in ac_str_slice_clone_in
+#define str_slice_free_in ac_str_slice_free_in
 
 #define str_with_capacity ac_str_with_capacity
 #define str_from ac_str_from
 #define str_push ac_str_push
 #define str_unshift ac_str_unshift
 #define str_append ac_str_append
+#define str_append_slice ac_str_append_slice
 #define str_appendf ac_str_appendf
 #define str_prepend ac_str_prepend
 #define str_prependf ac_str_prependf
+#define str_append_i64 ac_str_append_i64
+#define str_append_u64 ac_str_append_u64
+#define str_append_u64_hex ac_str_append_u64_hex
+#define str_append_f64 ac_str_append_f64
+#define str_append_i64_padded ac_str_append_i64_padded
+#define str_append_u64_padded ac_str_append_u64_padded
+#define str_append_u64_hex_padded ac_str_append_u64_hex_padded
+#define str_parse_i64 ac_str_parse_i64
+#define str_parse_u64 ac_str_parse_u64
+#define str_parse_f64 ac_str_parse_f64
+#define str_utf8_validate ac_str_utf8_validate
+#define str_utf8_count ac_str_utf8_count
+#define str_utf8_slice_range ac_str_utf8_slice_range
 #define str_pop ac_str_pop
 #define str_pop_opt ac_str_pop_opt
 #define str_shift ac_str_shift
@@ -1667,6 +8134,8 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 #define str_empty ac_str_empty
 #define str_free ac_str_free
 #define str_ensure_cap ac_str_ensure_cap
+#define str_reserve_exact ac_str_reserve_exact
+#define str_shrink_to_fit ac_str_shrink_to_fit
 #define str_trim_front ac_str_trim_front
 #define str_trim_back ac_str_trim_back
 #define str_trim ac_str_trim
@@ -1674,8 +8143,66 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 #define str_split_by_once ac_str_split_by_once
 #define str_split_by_many ac_str_split_by_many
 #define str_split_at ac_str_split_at
+#define str_parts_free ac_str_parts_free
+#define str_split_by_borrowed ac_str_split_by_borrowed
+#define str_split_by_many_borrowed ac_str_split_by_many_borrowed
+#define str_split_by_once_borrowed ac_str_split_by_once_borrowed
+#define str_split_at_borrowed ac_str_split_at_borrowed
+#define str_split_by_into ac_str_split_by_into
+#define str_split_by_many_into ac_str_split_by_many_into
+#define str_split_by_once_into ac_str_split_by_once_into
+#define str_split_at_into ac_str_split_at_into
+#define str_split_iter ac_str_split_iter
+#define str_split_iter_many ac_str_split_iter_many
+#define str_split_iter_set ac_str_split_iter_set
+#define str_split_by_set_borrowed ac_str_split_by_set_borrowed
+#define str_split_by_set_into ac_str_split_by_set_into
+#define str_trimmed_by ac_str_trimmed_by
+#define str_find ac_str_find
+#define str_rfind ac_str_rfind
+#define str_find_all ac_str_find_all
+#define str_needle ac_str_needle
+#define str_needle_find ac_str_needle_find
+#define str_needle_rfind ac_str_needle_rfind
+#define str_needle_find_all_into ac_str_needle_find_all_into
+#define str_hash ac_str_hash
+#define str_hash_bytes ac_str_hash_bytes
+#define str_hasher ac_str_hasher
+#define str_hasher_update ac_str_hasher_update
+#define str_hasher_finish ac_str_hasher_finish
+#define byteset_from ac_byteset_from
+#define byteset_from_slice ac_byteset_from_slice
+#define byteset_add ac_byteset_add
+#define byteset_add_range ac_byteset_add_range
+#define byteset_invert ac_byteset_invert
+#define byteset_contains ac_byteset_contains
+#define byteset_find ac_byteset_find
+#define byteset_find_not ac_byteset_find_not
+#define byteset_classify ac_byteset_classify
+#define str_split_iter_substr ac_str_split_iter_substr
+#define str_split_iter_limit ac_str_split_iter_limit
+#define str_split_iter_next ac_str_split_iter_next
 #define str_read_file ac_str_read_file
 #define str_read_lines ac_str_read_lines
+#define str_read_lines_buffered ac_str_read_lines_buffered
+#define str_lines_free ac_str_lines_free
+#define str_split_lines_into ac_str_split_lines_into
+#define line_reader_from_fd ac_line_reader_from_fd
+#define line_reader_from_file ac_line_reader_from_file
+#define line_reader_next ac_line_reader_next
+#define line_reader_free ac_line_reader_free
+#define str_map_file ac_str_map_file
+#define str_unmap_file ac_str_unmap_file
+#define multi_matcher_from ac_multi_matcher_from
+#define multi_matcher_is_match ac_multi_matcher_is_match
+#define multi_matcher_find_all ac_multi_matcher_find_all
+#define multi_matcher_find_all_into ac_multi_matcher_find_all_into
+#define multi_matcher_free ac_multi_matcher_free
+#define str_interner_init ac_str_interner_init
+#define str_interner_intern ac_str_interner_intern
+#define str_interner_find ac_str_interner_find
+#define str_interner_get ac_str_interner_get
+#define str_interner_free ac_str_interner_free
 
 #define str_trimmed_front ac_str_trimmed_front
 #define str_trimmed_back ac_str_trimmed_back
@@ -1685,6 +8212,34 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 
 
 
+/*                             *
+ *  SMALL STRING STRIP PREFIX  *
+ *                             */
+
+#define SSO_CAP AC_SSO_CAP
+#define SSO_ARG AC_SSO_ARG
+
+#define SsoString Ac_SsoString
+
+#define sso_is_inline ac_sso_is_inline
+#define sso_chars ac_sso_chars
+#define sso_len ac_sso_len
+#define sso_cap ac_sso_cap
+#define sso_slice ac_sso_slice
+#define sso_from ac_sso_from
+#define sso_from_slice ac_sso_from_slice
+#define sso_push ac_sso_push
+#define sso_append ac_sso_append
+#define sso_append_slice ac_sso_append_slice
+#define sso_pop ac_sso_pop
+#define sso_empty ac_sso_empty
+#define sso_ensure_cap ac_sso_ensure_cap
+#define sso_free ac_sso_free
+
+/* END OF SMALL STRING STRIP PREFIX */
+
+
+
 /*                      *
  *  ASCII STRIP PREFIX  *
  *                      */
@@ -1697,6 +8252,18 @@ ACLIBDEF void __aclib_default_log_fn(Ac_LogLevel loglvl, const char* fmt, ...)
 #define ascii_is_lowercase ac_ascii_is_lowercase
 #define ascii_to_uppercase ac_ascii_to_uppercase
 #define ascii_to_lowercase ac_ascii_to_lowercase
+#define ascii_make_uppercase ac_ascii_make_uppercase
+#define ascii_make_lowercase ac_ascii_make_lowercase
+#define ascii_uppercased ac_ascii_uppercased
+#define ascii_lowercased ac_ascii_lowercased
+#define ascii_all_alphabetic ac_ascii_all_alphabetic
+#define ascii_all_numeric ac_ascii_all_numeric
+#define ascii_all_alphanumeric ac_ascii_all_alphanumeric
+#define ascii_all_whitespace ac_ascii_all_whitespace
+#define ascii_find_non_alphabetic ac_ascii_find_non_alphabetic
+#define ascii_find_non_numeric ac_ascii_find_non_numeric
+#define ascii_find_non_alphanumeric ac_ascii_find_non_alphanumeric
+#define ascii_find_non_whitespace ac_ascii_find_non_whitespace
 
 /* END OF ASCII STRIP PREFIX */
 
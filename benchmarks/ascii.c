@@ -0,0 +1,129 @@
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "bench.h"
+
+// The out of line definitions the inline, table driven ones replaced. noinline keeps them behind a
+// call, like they were when they lived in the implementation section
+__attribute__((noinline)) char extern_is_alphabetic(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+}
+
+__attribute__((noinline)) bool extern_is_numeric(char ch)
+{
+    return ch >= '0' && ch <= '9';
+}
+
+__attribute__((noinline)) bool extern_is_alphanumeric(char ch)
+{
+    return extern_is_alphabetic(ch) || extern_is_numeric(ch);
+}
+
+__attribute__((noinline)) bool extern_is_whitespace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' || ch == '\f';
+}
+
+__attribute__((noinline)) char extern_to_lowercase(char ch)
+{
+    if (!extern_is_alphabetic(ch))
+        return ch;
+    return ch | 0x20;
+}
+
+#define TEXT_LEN ((size_t)1 << 20)
+
+char* header = "Content-Type: text/html; charset=utf-8\r\n"
+               "X-Request-Id: 4f1c9a2e-77b0-4d3a-9e61-0c2b5d8f13a7\r\n"
+               "Cache-Control: max-age=3600, must-revalidate\r\n\r\n";
+
+void report(const char* name, double extern_secs, double inline_secs)
+{
+    printf("%-24s %12.2f %12.2f\n", name, TEXT_LEN / extern_secs / 1e9,
+           TEXT_LEN / inline_secs / 1e9);
+}
+
+// Run the same per char loops over 1 MiB of header-like text, once calling the out of line
+// definitions, and once the inline ones
+int main(void)
+{
+    char* text = malloc(TEXT_LEN);
+    size_t header_len = strlen(header);
+    for (size_t i = 0; i < TEXT_LEN; i++)
+        text[i] = header[i % header_len];
+
+    printf("%-24s %12s %12s\n", "GB/s", "extern", "inline");
+
+    double extern_secs, inline_secs;
+    size_t count;
+
+    BENCH_RUN(extern_secs, 0.2, {
+        count = 0;
+        for (size_t i = 0; i < TEXT_LEN; i++)
+            count += extern_is_whitespace(text[i]);
+        BENCH_KEEP(count);
+    });
+    BENCH_RUN(inline_secs, 0.2, {
+        count = 0;
+        for (size_t i = 0; i < TEXT_LEN; i++)
+            count += ac_ascii_is_whitespace(text[i]);
+        BENCH_KEEP(count);
+    });
+    report("count whitespace", extern_secs, inline_secs);
+
+    BENCH_RUN(extern_secs, 0.2, {
+        count = 0;
+        for (size_t i = 0; i < TEXT_LEN; i++)
+            count += extern_is_alphanumeric(text[i]);
+        BENCH_KEEP(count);
+    });
+    BENCH_RUN(inline_secs, 0.2, {
+        count = 0;
+        for (size_t i = 0; i < TEXT_LEN; i++)
+            count += ac_ascii_is_alphanumeric(text[i]);
+        BENCH_KEEP(count);
+    });
+    report("count alphanumeric", extern_secs, inline_secs);
+
+    BENCH_RUN(extern_secs, 0.2, {
+        for (size_t i = 0; i < TEXT_LEN; i++)
+            text[i] = extern_to_lowercase(text[i]);
+        BENCH_KEEP(text);
+    });
+    BENCH_RUN(inline_secs, 0.2, {
+        for (size_t i = 0; i < TEXT_LEN; i++)
+            text[i] = ac_ascii_to_lowercase(text[i]);
+        BENCH_KEEP(text);
+    });
+    report("to_lowercase in place", extern_secs, inline_secs);
+
+    // Trim every line of the text, the way a scalar trim loop does
+    BENCH_RUN(extern_secs, 0.2, {
+        count = 0;
+        for (size_t i = 0; i < TEXT_LEN; i++)
+        {
+            while (i < TEXT_LEN && extern_is_whitespace(text[i]))
+                i++;
+            while (i < TEXT_LEN && text[i] != '\n')
+                i++;
+            count++;
+        }
+        BENCH_KEEP(count);
+    });
+    BENCH_RUN(inline_secs, 0.2, {
+        count = 0;
+        for (size_t i = 0; i < TEXT_LEN; i++)
+        {
+            while (i < TEXT_LEN && ac_ascii_is_whitespace(text[i]))
+                i++;
+            while (i < TEXT_LEN && text[i] != '\n')
+                i++;
+            count++;
+        }
+        BENCH_KEEP(count);
+    });
+    report("scalar trim loop", extern_secs, inline_secs);
+
+    free(text);
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include <stdio.h>
+#include <time.h>
+
+/// The current time in seconds, from a monotonic clock
+static inline double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/// Keep the compiler from optimizing away the computation of a value
+#define BENCH_KEEP(value) __asm__ volatile("" : : "g"(value) : "memory")
+
+/// Run a block until at least `min_secs` have passed, and store the seconds per run in `secs`
+#define BENCH_RUN(secs, min_secs, blck)            \
+    {                                              \
+        size_t __runs = 0;                         \
+        double __start = bench_now();              \
+        double __elapsed = 0;                      \
+        do                                         \
+        {                                          \
+            blck;                                  \
+            __runs++;                              \
+            __elapsed = bench_now() - __start;     \
+        } while (__elapsed < (min_secs));          \
+        (secs) = __elapsed / (double)__runs;       \
+    }
+
+#endif
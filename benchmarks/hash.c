@@ -0,0 +1,53 @@
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "bench.h"
+
+size_t sizes[] = {8, 16, 32, 64, 128, 256, 1024, 4096, 65536, 1 << 20};
+
+// Hash inputs from 8 B to 1 MiB, feeding every hash into the next seed, so the calls can't overlap
+// or be hoisted out of the loop. The streaming hasher is fed the same bytes in 4 KiB chunks
+int main(void)
+{
+    size_t max_len = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+    char* bytes = malloc(max_len);
+    for (size_t i = 0; i < max_len; i++)
+        bytes[i] = (char)(i * 131 + 7);
+
+    printf("%10s %12s %12s\n", "bytes", "hash GB/s", "hasher GB/s");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        size_t len = sizes[i];
+        size_t reps = (1 << 24) / len + 1;
+        uint64_t seed = 0;
+
+        double hash_secs;
+        BENCH_RUN(hash_secs, 0.2, {
+            for (size_t r = 0; r < reps; r++)
+                seed = ac_str_hash_bytes(bytes, len, seed);
+        });
+        BENCH_KEEP(seed);
+
+        double hasher_secs;
+        BENCH_RUN(hasher_secs, 0.2, {
+            for (size_t r = 0; r < reps; r++)
+            {
+                Ac_StrHasher hasher = ac_str_hasher(seed);
+                for (size_t start = 0; start < len; start += 4096)
+                {
+                    Ac_StrSlice chunk = {.chars = bytes + start};
+                    chunk.len = len - start < 4096 ? len - start : 4096;
+                    ac_str_hasher_update(&hasher, chunk);
+                }
+                seed = ac_str_hasher_finish(&hasher);
+            }
+        });
+        BENCH_KEEP(seed);
+
+        double total = (double)len * (double)reps;
+        printf("%10zu %12.2f %12.2f\n", len, total / hash_secs / 1e9, total / hasher_secs / 1e9);
+    }
+
+    free(bytes);
+    return 0;
+}
@@ -0,0 +1,57 @@
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "bench.h"
+
+typedef Ac_VecDef(int) IntVec;
+
+size_t realloc_count = 0;
+
+void* counting_alloc(void* ctx, size_t size)
+{
+    return malloc(size);
+}
+
+void* counting_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
+{
+    realloc_count++;
+    return realloc(ptr, new_size);
+}
+
+void counting_free(void* ctx, void* ptr)
+{
+    free(ptr);
+}
+
+const Ac_Allocator counting_allocator = {
+    .alloc = counting_alloc,
+    .realloc = counting_realloc,
+    .free = counting_free,
+};
+
+// Push N ints one at a time, and count the reallocations it takes. With geometric growth the count
+// goes up by a constant for every factor N grows by, instead of in proportion to N
+int main(void)
+{
+    printf("%10s %10s %12s\n", "pushes", "reallocs", "ns/push");
+
+    for (size_t n = 1000; n <= 100000000; n *= 10)
+    {
+        size_t reallocs = 0;
+        double secs;
+        BENCH_RUN(secs, 0.2, {
+            IntVec ivec = {.allocator = &counting_allocator};
+            realloc_count = 0;
+
+            for (size_t i = 0; i < n; i++)
+                ac_vec_push(&ivec, (int)i);
+            BENCH_KEEP(ivec.items[n - 1]);
+
+            reallocs = realloc_count;
+            ac_vec_free(ivec);
+        });
+
+        printf("%10zu %10zu %12.2f\n", n, reallocs, secs * 1e9 / (double)n);
+    }
+
+    return 0;
+}
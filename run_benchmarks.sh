@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+
+ret_code=0
+
+cc="${CC:-clang}"
+cc_flags="-O2 -Wall -Wpedantic -Wno-gnu-statement-expression -Wno-format-pedantic -Wno-gnu-compound-literal-initializer"
+[ "$cc" == "clang" ] || cc_flags="-O2"
+
+for file in ./benchmarks/*.c; do
+    if [ -f "$file" ]; then
+        $cc "$file" $cc_flags -o bench || { ret_code=1; continue; }
+        echo -e "\x1b[34m# Running $file\x1b[0m"
+
+        ./bench || ret_code=1
+        rm ./bench
+        echo ""
+    fi
+done
+
+exit $ret_code
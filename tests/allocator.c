@@ -0,0 +1,145 @@
+#include <stdio.h>
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "test.h"
+
+typedef Ac_VecDef(int) IntVec;
+
+typedef struct
+{
+    size_t allocs;
+    size_t reallocs;
+    size_t frees;
+} Counter;
+
+void* counting_alloc(void* ctx, size_t size)
+{
+    ((Counter*)ctx)->allocs++;
+    return malloc(size);
+}
+
+void* counting_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
+{
+    ((Counter*)ctx)->reallocs++;
+    return realloc(ptr, new_size);
+}
+
+void counting_free(void* ctx, void* ptr)
+{
+    ((Counter*)ctx)->frees++;
+    free(ptr);
+}
+
+Ac_Allocator counting_allocator(Counter* counter)
+{
+    return (Ac_Allocator){
+        .alloc = counting_alloc,
+        .realloc = counting_realloc,
+        .free = counting_free,
+        .ctx = counter,
+    };
+}
+
+int main(void)
+{
+    TEST_INIT;
+
+    TEST(default_allocator_is_current, {
+        ASSERT_EQ(&aclib_default_allocator, ac_allocator_current(), "%p");
+    });
+
+    TEST(vec_uses_own_allocator, {
+        Counter counter = {0};
+        Ac_Allocator allocator = counting_allocator(&counter);
+        IntVec ivec = {.allocator = &allocator};
+
+        for (int i = 0; i < 20; i++)
+            ac_vec_push(&ivec, i);
+        ASSERT_LT((size_t)0, counter.reallocs, "%zu");
+
+        ac_vec_free(ivec);
+        ASSERT_EQ((size_t)1, counter.frees, "%zu");
+    });
+
+    TEST(string_uses_own_allocator, {
+        Counter counter = {0};
+        Ac_Allocator allocator = counting_allocator(&counter);
+        Ac_String str = {.allocator = &allocator};
+
+        ac_str_append(&str, "foo bar");
+        ASSERT_LT((size_t)0, counter.reallocs, "%zu");
+
+        Ac_StrVec parts = ac_str_split_by(str, ' ');
+        ASSERT_EQ((const Ac_Allocator*)&allocator, parts.allocator, "%p");
+        ASSERT_EQ((size_t)2, counter.allocs, "%zu");
+
+        // The parts are freed with the string's allocator, not the thread's
+        ac_str_parts_free(&parts);
+        ac_str_free(&str);
+        ASSERT_EQ((size_t)4, counter.frees, "%zu");
+    });
+
+    TEST(thread_allocator, {
+        Counter counter = {0};
+        Ac_Allocator allocator = counting_allocator(&counter);
+        aclib_thread_allocator = &allocator;
+
+        IntVec ivec = {0};
+        ac_vec_push(&ivec, 1);
+        Ac_StrSlice clone = ac_str_slice_clone(ac_str_slice_from("foo"));
+
+        aclib_thread_allocator = NULL;
+
+        // The vector remembers the allocator it was grown with
+        ASSERT_EQ((const Ac_Allocator*)&allocator, ivec.allocator, "%p");
+        ac_vec_free(ivec);
+        ac_str_slice_free_in(&allocator, &clone);
+
+        ASSERT_EQ((size_t)1, counter.allocs, "%zu");
+        ASSERT_EQ((size_t)1, counter.reallocs, "%zu");
+        ASSERT_EQ((size_t)2, counter.frees, "%zu");
+    });
+
+    TEST(sso_string_keeps_allocator, {
+        Counter counter = {0};
+        Ac_Allocator allocator = counting_allocator(&counter);
+        aclib_thread_allocator = &allocator;
+
+        Ac_SsoString str = ac_sso_from("a string that is longer than the inline capacity");
+        ASSERT_EQ((size_t)1, counter.reallocs, "%zu");
+
+        aclib_thread_allocator = NULL;
+
+        // Growing and freeing go through the allocator the string moved to the heap with
+        for (size_t i = 0; i < 1000; i++)
+            ac_sso_push(&str, 'x');
+        ASSERT_LT((size_t)1, counter.reallocs, "%zu");
+        ASSERT_EQ((size_t)1048, ac_sso_len(&str), "%zu");
+
+        ac_sso_free(&str);
+        ASSERT_EQ((size_t)1, counter.frees, "%zu");
+    });
+
+    TEST(arena_backed_by_allocator, {
+        Counter counter = {0};
+        Ac_Allocator allocator = counting_allocator(&counter);
+        Ac_Arena arena = {.chunk_size = 64};
+        arena.allocator = &allocator;
+
+        ac_arena_alloc(&arena, 48);
+        ac_arena_alloc(&arena, 48);
+        ASSERT_EQ((size_t)2, counter.allocs, "%zu");
+
+        ac_arena_free(&arena);
+        ASSERT_EQ((size_t)2, counter.frees, "%zu");
+    });
+
+    TEST(free_null_is_noop, {
+        Counter counter = {0};
+        Ac_Allocator allocator = counting_allocator(&counter);
+        ac_allocator_free(&allocator, NULL);
+        ASSERT_EQ((size_t)0, counter.frees, "%zu");
+    });
+
+    TEST_END;
+}
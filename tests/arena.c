@@ -0,0 +1,188 @@
+#include <stdio.h>
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "test.h"
+
+typedef Ac_VecDef(int) IntVec;
+
+int main(void)
+{
+    TEST_INIT;
+
+    TEST(zero_init_alloc_and_free, {
+        Ac_Arena arena = {0};
+        ASSERT_EQ((Ac_ArenaChunk*)0, arena.first, "%p");
+
+        int* nums = ac_arena_alloc(&arena, 4 * sizeof(int));
+        ASSERT_NEQ((int*)0, nums, "%p");
+        ASSERT_NEQ((Ac_ArenaChunk*)0, arena.first, "%p");
+        size_t misalign = (uintptr_t)nums % AC_ARENA_ALIGN;
+        ASSERT_EQ((size_t)0, misalign, "%zu");
+
+        for (int i = 0; i < 4; i++)
+            nums[i] = i;
+        ASSERT_ARR_EQ(((int[]){0, 1, 2, 3}), nums, 4, "%d");
+
+        ac_arena_free(&arena);
+        ASSERT_EQ((Ac_ArenaChunk*)0, arena.first, "%p");
+        ASSERT_EQ((Ac_ArenaChunk*)0, arena.current, "%p");
+    });
+
+    TEST(alignment, {
+        Ac_Arena arena = {0};
+
+        ac_arena_alloc_aligned(&arena, 1, 1);
+        void* ptr = ac_arena_alloc_aligned(&arena, 8, 64);
+        size_t misalign = (uintptr_t)ptr % 64;
+        ASSERT_EQ((size_t)0, misalign, "%zu");
+
+        ac_arena_free(&arena);
+    });
+
+    TEST(calloc_is_zeroed, {
+        Ac_Arena arena = {0};
+
+        char* bytes = ac_arena_calloc(&arena, 100, sizeof(char));
+        for (size_t i = 0; i < 100; i++)
+            ASSERT_EQ(0, bytes[i], "%d");
+
+        // The size would wrap around to a tiny block
+        ASSERT_EQ((void*)0, ac_arena_calloc(&arena, SIZE_MAX / 4 + 2, 4), "%p");
+
+        ac_arena_free(&arena);
+    });
+
+    TEST(chains_chunks, {
+        Ac_Arena arena = {.chunk_size = 64};
+
+        ac_arena_alloc(&arena, 48);
+        ac_arena_alloc(&arena, 48);
+        ASSERT_NEQ(arena.first, arena.current, "%p");
+        ASSERT_EQ(arena.current, arena.first->next, "%p");
+
+        // Allocations bigger than a chunk get a chunk of their own
+        char* big = ac_arena_alloc(&arena, 1000);
+        memset(big, 'a', 1000);
+        ASSERT_GTE(arena.current->cap, (size_t)1000, "%zu");
+
+        ac_arena_free(&arena);
+    });
+
+    TEST(realloc_in_place, {
+        Ac_Arena arena = {0};
+
+        char* ptr = ac_arena_alloc(&arena, 8);
+        memcpy(ptr, "foobar", 7);
+        char* grown = ac_arena_realloc(&arena, ptr, 8, 32);
+        ASSERT_EQ(ptr, grown, "%p");
+        ASSERT_STR_EQ("foobar", grown);
+
+        ac_arena_alloc(&arena, 8);
+        char* moved = ac_arena_realloc(&arena, grown, 32, 64);
+        ASSERT_NEQ(grown, moved, "%p");
+        ASSERT_STR_EQ("foobar", moved);
+
+        ac_arena_free(&arena);
+    });
+
+    TEST(mark_and_reset_to, {
+        Ac_Arena arena = {.chunk_size = 64};
+
+        ac_arena_alloc(&arena, 16);
+        Ac_ArenaMark mark = ac_arena_mark(&arena);
+        void* after_mark = ac_arena_alloc(&arena, 16);
+        ac_arena_alloc(&arena, 48);
+        ac_arena_alloc(&arena, 48);
+
+        ac_arena_reset_to(&arena, mark);
+        ASSERT_EQ(arena.first, arena.current, "%p");
+        ASSERT_EQ(after_mark, ac_arena_alloc(&arena, 16), "%p");
+
+        ac_arena_free(&arena);
+    });
+
+    TEST(reset_reuses_chunks, {
+        Ac_Arena arena = {.chunk_size = 64};
+
+        void* first = ac_arena_alloc(&arena, 48);
+        ac_arena_alloc(&arena, 48);
+        Ac_ArenaChunk* second_chunk = arena.current;
+
+        ac_arena_reset(&arena);
+        ASSERT_EQ(first, ac_arena_alloc(&arena, 48), "%p");
+        ac_arena_alloc(&arena, 48);
+        ASSERT_EQ(second_chunk, arena.current, "%p");
+
+        ac_arena_free(&arena);
+    });
+
+    TEST(vec_in_arena, {
+        Ac_Arena arena = {0};
+        Ac_Allocator allocator = ac_arena_allocator(&arena);
+        IntVec ivec = {.allocator = &allocator};
+
+        for (int i = 0; i < 100; i++)
+            ac_vec_push(&ivec, i);
+
+        ASSERT_EQ((size_t)100, ivec.len, "%zu");
+        for (int i = 0; i < 100; i++)
+            ASSERT_EQ(i, ivec.items[i], "%d");
+
+        ac_vec_free(ivec);
+        ASSERT_EQ((int*)0, ivec.items, "%p");
+        ac_arena_free(&arena);
+    });
+
+    TEST(string_in_arena, {
+        Ac_Arena arena = {0};
+        Ac_Allocator allocator = ac_arena_allocator(&arena);
+        Ac_String str = {.allocator = &allocator};
+
+        ac_str_append(&str, "foo");
+        ac_str_push(&str, ' ');
+        ac_str_appendf(&str, "%d", 42);
+        ASSERT_STR_EQ("foo 42", str.chars);
+
+        ac_str_free(&str);
+        ac_arena_free(&arena);
+    });
+
+    TEST(split_in_arena, {
+        Ac_Arena arena = {0};
+        Ac_Allocator allocator = ac_arena_allocator(&arena);
+        Ac_String str = {.allocator = &allocator};
+        ac_str_append(&str, "foo,bar,baz");
+
+        Ac_ArenaMark mark = ac_arena_mark(&arena);
+        Ac_StrVec parts = ac_str_split_by(str, ',');
+
+        ASSERT_EQ((size_t)3, parts.len, "%zu");
+        ASSERT_EQ((const Ac_Allocator*)&allocator, parts.allocator, "%p");
+        ASSERT_STR_EQ("foo", parts.items[0].chars);
+        ASSERT_STR_EQ("bar", parts.items[1].chars);
+        ASSERT_STR_EQ("baz", parts.items[2].chars);
+
+        ac_arena_reset_to(&arena, mark);
+        ASSERT_STR_EQ("foo,bar,baz", str.chars);
+
+        ac_arena_free(&arena);
+    });
+
+    TEST(str_slice_clone_in_arena, {
+        Ac_Arena arena = {0};
+        Ac_StrSlice slice = ac_str_slice_from("foobar");
+
+        Ac_StrSlice clone = ac_arena_str_slice_clone(&arena, slice);
+        ASSERT_EQ((size_t)6, clone.len, "%zu");
+        ASSERT_STR_EQ("foobar", clone.chars);
+        ASSERT_NEQ(slice.chars, clone.chars, "%p");
+
+        Ac_StrSlice empty = ac_arena_str_slice_with_len(&arena, 4);
+        ASSERT_EQ((size_t)4, empty.len, "%zu");
+        ASSERT_STR_EQ("", empty.chars);
+
+        ac_arena_free(&arena);
+    });
+
+    TEST_END;
+}
@@ -125,6 +125,117 @@ int main(void)
         }
     });
 
+    TEST(every_char_classified, {
+        for (int i = 0; i < 256; i++)
+        {
+            char ch = (char)i;
+            bool upper = ch >= 'A' && ch <= 'Z';
+            bool lower = ch >= 'a' && ch <= 'z';
+            bool numeric = ch >= '0' && ch <= '9';
+            bool whitespace = ch == ' ' || (ch >= '\t' && ch <= '\r');
+
+            ASSERT_EQ(upper || lower, (bool)ac_ascii_is_alphabetic(ch), "%d");
+            ASSERT_EQ(numeric, ac_ascii_is_numeric(ch), "%d");
+            ASSERT_EQ(upper || lower || numeric, ac_ascii_is_alphanumeric(ch), "%d");
+            ASSERT_EQ(whitespace, ac_ascii_is_whitespace(ch), "%d");
+            ASSERT_EQ(upper, ac_ascii_is_uppercase(ch), "%d");
+            ASSERT_EQ(lower, ac_ascii_is_lowercase(ch), "%d");
+            ASSERT_EQ(lower ? ch - 0x20 : ch, ac_ascii_to_uppercase(ch), "%d");
+            ASSERT_EQ(upper ? ch + 0x20 : ch, ac_ascii_to_lowercase(ch), "%d");
+        }
+    });
+
+    // SLICES
+
+    TEST(slice_convert_case, {
+        char chars[] = "Content-Type: TEXT/html; charset=UTF-8";
+        Ac_StrSlice slice = ac_str_slice_from(chars);
+
+        Ac_String upper = ac_ascii_uppercased(slice);
+        ASSERT_STR_EQ("CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8", upper.chars);
+        ASSERT_EQ(slice.len, upper.len, "%zu");
+
+        ac_ascii_make_lowercase(upper.slice);
+        ASSERT_STR_EQ("content-type: text/html; charset=utf-8", upper.chars);
+
+        ac_ascii_make_uppercase(((Ac_StrSlice){.chars = chars, .len = 7}));
+        ASSERT_STR_EQ("CONTENT-Type: TEXT/html; charset=UTF-8", chars);
+
+        ac_str_free(&upper);
+    });
+
+    TEST(slice_convert_case_every_byte, {
+        // Every byte at every length and offset, so each one is hit by the vector and tail paths
+        char bytes[300];
+        char converted[300];
+        for (size_t i = 0; i < sizeof(bytes); i++)
+            bytes[i] = (char)(i * 7);
+
+        for (size_t len = 0; len <= 64; len++)
+        {
+            for (size_t start = 0; start + len <= sizeof(bytes); start += 37)
+            {
+                Ac_StrSlice slice = ((Ac_StrSlice){.chars = bytes + start, .len = len});
+                Ac_String lower = ac_ascii_lowercased(slice);
+                memcpy(converted, slice.chars, len);
+                ac_ascii_make_uppercase(((Ac_StrSlice){.chars = converted, .len = len}));
+
+                for (size_t i = 0; i < len; i++)
+                {
+                    ASSERT_EQ(ac_ascii_to_lowercase(slice.chars[i]), lower.chars[i], "%d");
+                    ASSERT_EQ(ac_ascii_to_uppercase(slice.chars[i]), converted[i], "%d");
+                }
+                ASSERT_EQ('\0', lower.chars[len], "%d");
+                ac_str_free(&lower);
+            }
+        }
+    });
+
+    TEST(slice_all_and_find_non, {
+        ASSERT(ac_ascii_all_numeric(ac_str_slice_from("0123456789012345678901234567890")));
+        ASSERT(!ac_ascii_all_numeric(ac_str_slice_from("01234567890123456789012345a7890")));
+        ASSERT(ac_ascii_all_alphabetic(ac_str_slice_from("abcdefghijklmnopqrstuvwxyzABCDEFGHIJ")));
+        ASSERT(!ac_ascii_all_alphabetic(ac_str_slice_from("abcdefghijklmnop@")));
+        ASSERT(!ac_ascii_all_alphanumeric(ac_str_slice_from("X-Request-Id")));
+        ASSERT(ac_ascii_all_alphanumeric(ac_str_slice_from("XRequestId0123456789")));
+        ASSERT(ac_ascii_all_whitespace(ac_str_slice_from(" \t\r\n\v\f                \n")));
+        ASSERT(ac_ascii_all_numeric(ac_str_slice_from("")));
+
+        Ac_StrSlice header = ac_str_slice_from("X-Request-Id");
+        Ac_StrSlice number = ac_str_slice_from("12345678901234567890.5");
+        Ac_StrSlice indented = ac_str_slice_from("                  x");
+        ASSERT_EQ((size_t)1, ac_ascii_find_non_alphanumeric(header), "%zu");
+        ASSERT_EQ((size_t)20, ac_ascii_find_non_numeric(number), "%zu");
+        ASSERT_EQ((size_t)3, ac_ascii_find_non_numeric(ac_str_slice_from("123")), "%zu");
+        ASSERT_EQ((size_t)18, ac_ascii_find_non_whitespace(indented), "%zu");
+    });
+
+    TEST(slice_find_non_every_position, {
+        // One char out of the class at every position, so it's found by the vector and tail paths
+        char chars[64];
+        for (size_t len = 1; len <= sizeof(chars); len++)
+        {
+            for (size_t at = 0; at < len; at++)
+            {
+                Ac_StrSlice slice = ((Ac_StrSlice){.chars = chars, .len = len});
+
+                memset(chars, '7', len);
+                chars[at] = '/';
+                ASSERT_EQ(at, ac_ascii_find_non_numeric(slice), "%zu");
+                chars[at] = ':';
+                ASSERT_EQ(at, ac_ascii_find_non_alphanumeric(slice), "%zu");
+                ASSERT(ac_ascii_all_alphanumeric(((Ac_StrSlice){.chars = chars, .len = at})));
+
+                memset(chars, 'z', len);
+                chars[at] = '`';
+                ASSERT_EQ(at, ac_ascii_find_non_alphabetic(slice), "%zu");
+                chars[at] = '[';
+                ASSERT_EQ(at, ac_ascii_find_non_alphabetic(slice), "%zu");
+                chars[at] = (char)0xC1;
+                ASSERT_EQ(at, ac_ascii_find_non_alphabetic(slice), "%zu");
+            }
+        }
+    });
 
     TEST_END;
 }
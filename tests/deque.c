@@ -0,0 +1,136 @@
+#include <stdio.h>
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "test.h"
+
+typedef Ac_DequeDef(int) IntDeque;
+typedef Ac_SliceDef(int) IntSlc;
+typedef Ac_OptDef(int) IntOpt;
+
+int main(void)
+{
+    TEST_INIT;
+
+    TEST(zero_init, {
+        IntDeque ideque = {0};
+
+        ASSERT_EQ((size_t)0, ideque.len, "%zu");
+        ASSERT_EQ((size_t)0, ideque.cap, "%zu");
+        ASSERT_EQ((int*)0, ideque.items, "%p");
+    });
+
+    TEST(push_back_pop_front, {
+        IntDeque ideque = {0};
+
+        for (int i = 0; i < 100; i++)
+            ac_deque_push_back(&ideque, i);
+
+        ASSERT_EQ((size_t)100, ideque.len, "%zu");
+        ASSERT_EQ((size_t)0, ideque.cap & (ideque.cap - 1), "%zu");
+
+        for (int i = 0; i < 100; i++)
+            ASSERT_EQ(i, ac_deque_pop_front(&ideque), "%d");
+
+        ASSERT_EQ((size_t)0, ideque.len, "%zu");
+        ac_deque_free(&ideque);
+    });
+
+    TEST(push_front_pop_back, {
+        IntDeque ideque = {0};
+
+        for (int i = 0; i < 100; i++)
+            ac_deque_push_front(&ideque, i);
+
+        ASSERT_EQ(99, ac_deque_front(ideque), "%d");
+        ASSERT_EQ(0, ac_deque_back(ideque), "%d");
+
+        for (int i = 0; i < 100; i++)
+            ASSERT_EQ(i, ac_deque_pop_back(&ideque), "%d");
+
+        ac_deque_free(&ideque);
+    });
+
+    TEST(indexed_access, {
+        IntDeque ideque = {0};
+
+        ac_deque_push_back(&ideque, 2);
+        ac_deque_push_back(&ideque, 3);
+        ac_deque_push_front(&ideque, 1);
+
+        ASSERT_EQ(1, ac_deque_at(ideque, 0), "%d");
+        ASSERT_EQ(2, ac_deque_at(ideque, 1), "%d");
+        ASSERT_EQ(3, ac_deque_at(ideque, 2), "%d");
+
+        ac_deque_at(ideque, 1) = 20;
+        ASSERT_EQ(20, ac_deque_at(ideque, 1), "%d");
+
+        ac_deque_free(&ideque);
+    });
+
+    TEST(grow_while_wrapped, {
+        IntDeque ideque = {0};
+
+        ac_deque_push_back(&ideque, 0);
+        size_t cap = ideque.cap;
+
+        // Make the elements wrap around the end of the buffer, then force a grow
+        for (int i = 1; i <= 3; i++)
+            ac_deque_push_front(&ideque, -i);
+        for (int i = 1; (size_t)i < cap - 3; i++)
+            ac_deque_push_back(&ideque, i);
+        ASSERT_EQ(cap, ideque.len, "%zu");
+
+        ac_deque_push_back(&ideque, 1000);
+        ASSERT_LT(cap, ideque.cap, "%zu");
+
+        ASSERT_EQ(-3, ac_deque_at(ideque, 0), "%d");
+        ASSERT_EQ(0, ac_deque_at(ideque, 3), "%d");
+        ASSERT_EQ(1000, ac_deque_back(ideque), "%d");
+        for (size_t i = 1; i < ideque.len; i++)
+            ASSERT_LT(ac_deque_at(ideque, i - 1), ac_deque_at(ideque, i), "%d");
+
+        ac_deque_free(&ideque);
+    });
+
+    TEST(front_and_back_slices, {
+        IntDeque ideque = {0};
+
+        ac_deque_push_back(&ideque, 3);
+        ac_deque_push_back(&ideque, 4);
+        ac_deque_push_front(&ideque, 2);
+        ac_deque_push_front(&ideque, 1);
+
+        IntSlc front = ac_deque_front_slice(IntSlc, ideque);
+        IntSlc back = ac_deque_back_slice(IntSlc, ideque);
+
+        ASSERT_EQ((size_t)2, front.len, "%zu");
+        ASSERT_ARR_EQ(((int[]){1, 2}), front.items, 2, "%d");
+        ASSERT_EQ((size_t)2, back.len, "%zu");
+        ASSERT_ARR_EQ(((int[]){3, 4}), back.items, 2, "%d");
+
+        (void)ac_deque_pop_front(&ideque);
+        (void)ac_deque_pop_front(&ideque);
+        front = ac_deque_front_slice(IntSlc, ideque);
+        back = ac_deque_back_slice(IntSlc, ideque);
+        ASSERT_EQ((size_t)2, front.len, "%zu");
+        ASSERT_EQ((size_t)0, back.len, "%zu");
+
+        ac_deque_free(&ideque);
+    });
+
+    TEST(pop_opt, {
+        IntDeque ideque = {0};
+        ac_deque_push_back(&ideque, 1);
+
+        IntOpt opt = ac_deque_pop_front_opt(IntOpt, &ideque);
+        ASSERT_EQ(AC_OPT_SOME, opt.tag, "%d");
+        ASSERT_EQ(1, opt.some, "%d");
+
+        opt = ac_deque_pop_back_opt(IntOpt, &ideque);
+        ASSERT_EQ(AC_OPT_NONE, opt.tag, "%d");
+
+        ac_deque_free(&ideque);
+    });
+
+    TEST_END;
+}
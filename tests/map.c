@@ -0,0 +1,235 @@
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "test.h"
+
+typedef Ac_MapDef(int, int) IntMap;
+typedef Ac_MapDef(Ac_StrSlice, size_t) StrMap;
+typedef Ac_OptDef(int) IntOpt;
+typedef Ac_OptDef(size_t) SizeOpt;
+
+// Hash every key to the same value, so every lookup has to probe past the other keys
+uint64_t colliding_hash(const void* key, size_t key_size)
+{
+    return 42;
+}
+
+uint64_t lowercase_hash(const void* key, size_t key_size)
+{
+    const Ac_StrSlice* slice = key;
+    uint64_t hash = 0;
+    for (size_t i = 0; i < slice->len; i++)
+        hash = hash * 31 + (uint8_t)ac_ascii_to_lowercase(slice->chars[i]);
+    return hash;
+}
+
+bool lowercase_eql(const void* a, const void* b, size_t key_size)
+{
+    const Ac_StrSlice* slice_a = a;
+    const Ac_StrSlice* slice_b = b;
+    if (slice_a->len != slice_b->len)
+        return false;
+
+    for (size_t i = 0; i < slice_a->len; i++)
+    {
+        if (ac_ascii_to_lowercase(slice_a->chars[i]) != ac_ascii_to_lowercase(slice_b->chars[i]))
+            return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    TEST_INIT;
+
+    TEST(zero_init, {
+        IntMap map = {0};
+
+        ASSERT_EQ((size_t)0, map.len, "%zu");
+        ASSERT_EQ((size_t)0, map.cap, "%zu");
+        ASSERT(!ac_map_contains(&map, 1));
+
+        IntOpt got = ac_map_get(IntOpt, &map, 1);
+        ASSERT_EQ(AC_OPT_NONE, got.tag, "%d");
+
+        ac_map_free(&map);
+    });
+
+    TEST(insert_get_replace, {
+        IntMap map = {0};
+
+        ac_map_insert(&map, 1, 10);
+        ac_map_insert(&map, 2, 20);
+        ASSERT_EQ((size_t)2, map.len, "%zu");
+        ASSERT_EQ((size_t)0, map.cap & (map.cap - 1), "%zu");
+
+        IntOpt got = ac_map_get(IntOpt, &map, 1);
+        ASSERT_EQ(AC_OPT_SOME, got.tag, "%d");
+        ASSERT_EQ(10, got.some, "%d");
+
+        ac_map_insert(&map, 1, 11);
+        ASSERT_EQ((size_t)2, map.len, "%zu");
+        got = ac_map_get(IntOpt, &map, 1);
+        ASSERT_EQ(11, got.some, "%d");
+
+        ac_map_find(&map, 2)->value += 1;
+        got = ac_map_get(IntOpt, &map, 2);
+        ASSERT_EQ(21, got.some, "%d");
+        ASSERT_EQ((void*)0, (void*)ac_map_find(&map, 3), "%p");
+
+        ac_map_free(&map);
+    });
+
+    TEST(insert_remove_many, {
+        IntMap map = {0};
+
+        for (int i = 0; i < 100000; i++)
+            ac_map_insert(&map, i, i * 2);
+        ASSERT_EQ((size_t)100000, map.len, "%zu");
+        ASSERT_LTE(map.len, map.cap - map.cap / 8, "%zu");
+
+        for (int i = 0; i < 100000; i += 2)
+        {
+            IntOpt removed = ac_map_remove(IntOpt, &map, i);
+            ASSERT_EQ(AC_OPT_SOME, removed.tag, "%d");
+            ASSERT_EQ(i * 2, removed.some, "%d");
+        }
+        ASSERT_EQ((size_t)50000, map.len, "%zu");
+
+        for (int i = 0; i < 100000; i++)
+        {
+            IntOpt got = ac_map_get(IntOpt, &map, i);
+            Ac_OptTag expected = i % 2 == 0 ? AC_OPT_NONE : AC_OPT_SOME;
+            ASSERT_EQ(expected, got.tag, "%d");
+            if (i % 2 != 0)
+            {
+                ASSERT_EQ(i * 2, got.some, "%d");
+            }
+        }
+
+        IntOpt removed = ac_map_remove(IntOpt, &map, 0);
+        ASSERT_EQ(AC_OPT_NONE, removed.tag, "%d");
+
+        ac_map_free(&map);
+    });
+
+    TEST(colliding_keys, {
+        IntMap map = ac_map_with(colliding_hash, NULL);
+
+        for (int i = 0; i < 200; i++)
+            ac_map_insert(&map, i, -i);
+        for (int i = 0; i < 200; i += 3)
+        {
+            IntOpt removed = ac_map_remove(IntOpt, &map, i);
+            ASSERT_EQ(-i, removed.some, "%d");
+        }
+
+        // Keys added after removals can reuse their slots, and still be found past the others
+        for (int i = 1000; i < 1050; i++)
+            ac_map_insert(&map, i, i);
+
+        for (int i = 0; i < 200; i++)
+        {
+            bool expected = i % 3 != 0;
+            ASSERT_EQ(expected, ac_map_contains(&map, i), "%d");
+        }
+        for (int i = 1000; i < 1050; i++)
+            ASSERT(ac_map_contains(&map, i));
+
+        ac_map_free(&map);
+    });
+
+    TEST(remove_without_tombstone, {
+        IntMap map = {0};
+
+        ac_map_insert(&map, 7, 7);
+        size_t growth_left = map.growth_left;
+
+        // A sparse map has empty slots around every entry, so removing it leaves an empty slot
+        ac_map_remove(IntOpt, &map, 7);
+        ASSERT_EQ(growth_left + 1, map.growth_left, "%zu");
+
+        ac_map_free(&map);
+    });
+
+    TEST(reserve_and_rehash, {
+        IntMap map = {0};
+
+        ac_map_reserve(&map, 1000);
+        size_t cap = map.cap;
+        ASSERT_LTE((size_t)1000, map.growth_left, "%zu");
+
+        for (int i = 0; i < 1000; i++)
+            ac_map_insert(&map, i, i);
+        ASSERT_EQ(cap, map.cap, "%zu");
+
+        for (int i = 10; i < 1000; i++)
+            ac_map_remove(IntOpt, &map, i);
+
+        ac_map_rehash(&map, 0);
+        ASSERT_EQ((size_t)16, map.cap, "%zu");
+        ASSERT_EQ((size_t)10, map.len, "%zu");
+        for (int i = 0; i < 10; i++)
+            ASSERT_EQ(i, ac_map_get(IntOpt, &map, i).some, "%d");
+
+        ac_map_empty(&map);
+        ASSERT_EQ((size_t)0, map.len, "%zu");
+        ASSERT(!ac_map_contains(&map, 1));
+
+        ac_map_free(&map);
+    });
+
+    TEST(foreach, {
+        IntMap map = {0};
+
+        for (int i = 1; i <= 100; i++)
+            ac_map_insert(&map, i, i);
+        ac_map_remove(IntOpt, &map, 50);
+
+        int sum = 0;
+        size_t count = 0;
+        AC_MAP_FOREACH(map, entry)
+        {
+            sum += entry->value;
+            count++;
+        }
+
+        ASSERT_EQ(5050 - 50, sum, "%d");
+        ASSERT_EQ((size_t)99, count, "%zu");
+
+        ac_map_free(&map);
+    });
+
+    TEST(str_keys, {
+        StrMap map = {0};
+        char key[] = "foo";
+
+        ac_map_insert(&map, ac_str_slice_from("foo"), 1);
+        ac_map_insert(&map, ac_str_slice_from("bar"), 2);
+        ac_map_insert(&map, ac_str_slice_from("foobar"), 3);
+
+        // Keys are compared by their contents, not their pointers
+        SizeOpt got = ac_map_get(SizeOpt, &map, ac_str_slice_from(key));
+        ASSERT_EQ(AC_OPT_SOME, got.tag, "%d");
+        ASSERT_EQ((size_t)1, got.some, "%zu");
+        ASSERT(!ac_map_contains(&map, ac_str_slice_from("fo")));
+
+        ac_map_free(&map);
+    });
+
+    TEST(custom_str_functions, {
+        StrMap map = ac_map_with(lowercase_hash, lowercase_eql);
+
+        ac_map_insert(&map, ac_str_slice_from("Hello"), 1);
+        ac_map_insert(&map, ac_str_slice_from("HELLO"), 2);
+
+        ASSERT_EQ((size_t)1, map.len, "%zu");
+        ASSERT_EQ((size_t)2, ac_map_get(SizeOpt, &map, ac_str_slice_from("hello")).some, "%zu");
+
+        // The first inserted key is kept
+        ASSERT_STR_LEN_EQ("Hello", ac_map_find(&map, ac_str_slice_from("hello"))->key.chars, 5);
+
+        ac_map_free(&map);
+    });
+
+    TEST_END;
+}
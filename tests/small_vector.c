@@ -0,0 +1,146 @@
+#include <stdio.h>
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "test.h"
+
+typedef Ac_VecDef(int) IntVec;
+typedef Ac_SmallVecDef(int, 4) IntSmallVec;
+typedef Ac_SmallVecDef(char, 5) CharSmallVec;
+typedef Ac_OptDef(int) IntOpt;
+
+int main(void)
+{
+    TEST_INIT;
+
+    TEST(zero_init_is_empty, {
+        IntSmallVec ivec = {0};
+
+        ASSERT_EQ((size_t)0, ivec.len, "%zu");
+        ASSERT_EQ((size_t)0, ivec.cap, "%zu");
+        ac_vec_free(ivec);
+    });
+
+    TEST(push_inline, {
+        IntSmallVec ivec = {0};
+
+        for (int i = 0; i < 4; i++)
+            ac_vec_push(&ivec, i);
+
+        ASSERT(ac_smallvec_is_inline(ivec));
+        ASSERT_EQ((size_t)4, ivec.len, "%zu");
+        ASSERT_EQ((size_t)4, ivec.cap, "%zu");
+        ASSERT_ARR_EQ(((int[]){0, 1, 2, 3}), ivec.items, 4, "%d");
+        ASSERT_EQ((const Ac_Allocator*)0, ivec.allocator, "%p");
+
+        ac_vec_free(ivec);
+    });
+
+    TEST(push_spills_to_heap, {
+        IntSmallVec ivec = {0};
+
+        for (int i = 0; i < 5; i++)
+            ac_vec_push(&ivec, i);
+
+        ASSERT(!ac_smallvec_is_inline(ivec));
+        ASSERT_EQ((size_t)5, ivec.len, "%zu");
+        ASSERT_LTE((size_t)5, ivec.cap, "%zu");
+        ASSERT_ARR_EQ(((int[]){0, 1, 2, 3, 4}), ivec.items, 5, "%d");
+
+        for (int i = 5; i < 100; i++)
+            ac_vec_push(&ivec, i);
+        ASSERT_EQ(99, ivec.items[99], "%d");
+
+        ac_vec_free(ivec);
+        ASSERT_EQ((size_t)0, ivec.len, "%zu");
+
+        // A freed small vector starts out inline again
+        ac_vec_push(&ivec, 1);
+        ASSERT(ac_smallvec_is_inline(ivec));
+        ac_vec_free(ivec);
+    });
+
+    TEST(append_and_prepend, {
+        IntSmallVec ivec = {0};
+
+        ac_vec_append(&ivec, ((int[]){2, 3}), 2);
+        ac_vec_unshift(&ivec, 1);
+        ASSERT(ac_smallvec_is_inline(ivec));
+        ac_vec_append(&ivec, ((int[]){4, 5, 6}), 3);
+        ASSERT(!ac_smallvec_is_inline(ivec));
+        ac_vec_prepend(&ivec, ((int[]){-1, 0}), 2);
+
+        ASSERT_ARR_EQ(((int[]){-1, 0, 1, 2, 3, 4, 5, 6}), ivec.items, 8, "%d");
+
+        int shifted;
+        ac_vec_shift(&ivec, &shifted);
+        ASSERT_EQ(-1, shifted, "%d");
+
+        ac_vec_free(ivec);
+    });
+
+    TEST(pop_and_pop_opt, {
+        IntSmallVec ivec = {0};
+        ac_vec_push(&ivec, 1);
+        ac_vec_push(&ivec, 2);
+
+        ASSERT_EQ(2, ac_vec_pop(&ivec), "%d");
+
+        IntOpt opt = ac_vec_pop_opt(IntOpt, &ivec);
+        ASSERT_EQ(AC_OPT_SOME, opt.tag, "%d");
+        ASSERT_EQ(1, opt.some, "%d");
+
+        opt = ac_vec_pop_opt(IntOpt, &ivec);
+        ASSERT_EQ(AC_OPT_NONE, opt.tag, "%d");
+
+        ac_vec_free(ivec);
+    });
+
+    TEST(foreach, {
+        IntSmallVec ivec = {0};
+        ac_vec_append(&ivec, ((int[]){1, 2, 3, 4, 5}), 5);
+
+        int i = 1;
+        AC_VEC_FOREACH(int, ivec, x)
+        {
+            ASSERT_EQ(i, *x, "%d");
+            i++;
+        }
+        ASSERT_EQ(6, i, "%d");
+
+        ac_vec_free(ivec);
+    });
+
+    TEST(reserve_and_shrink, {
+        IntSmallVec ivec = {0};
+
+        ac_vec_reserve_exact(&ivec, 3);
+        ASSERT(ac_smallvec_is_inline(ivec));
+        ac_vec_shrink_to_fit(&ivec);
+        ASSERT(ac_smallvec_is_inline(ivec));
+
+        ac_vec_reserve_exact(&ivec, 20);
+        ASSERT(!ac_smallvec_is_inline(ivec));
+        ASSERT_LTE((size_t)20, ivec.cap, "%zu");
+
+        ac_vec_push(&ivec, 7);
+        ac_vec_shrink_to_fit(&ivec);
+        ASSERT_EQ((size_t)1, ivec.cap, "%zu");
+        ASSERT_EQ(7, ivec.items[0], "%d");
+
+        ac_vec_free(ivec);
+    });
+
+    TEST(vector_has_no_inline_items, {
+        IntVec ivec = {0};
+        ac_vec_push(&ivec, 1);
+
+        ASSERT_EQ((size_t)0, __aclib_vec_inline_cap(&ivec), "%zu");
+        ASSERT_EQ((size_t)4, __aclib_vec_inline_cap((IntSmallVec*)0), "%zu");
+        // The inline capacity includes the padding after the inline items
+        ASSERT_LTE((size_t)5, __aclib_vec_inline_cap((CharSmallVec*)0), "%zu");
+
+        ac_vec_free(ivec);
+    });
+
+    TEST_END;
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#define ACLIB_IMPLEMENTATION
+#include "../aclib.h"
+#include "test.h"
+
+int main(void)
+{
+    TEST_INIT;
+
+    TEST(zero_init_is_empty, {
+        Ac_SsoString str = {0};
+
+        ASSERT(ac_sso_is_inline(&str));
+        ASSERT_EQ((size_t)0, ac_sso_len(&str), "%zu");
+        ASSERT_EQ((size_t)AC_SSO_CAP, ac_sso_cap(&str), "%zu");
+        ASSERT_STR_EQ("", ac_sso_chars(&str));
+    });
+
+    TEST(size_of_struct, {
+        ASSERT_EQ(3 * sizeof(size_t), sizeof(Ac_SsoString), "%zu");
+    });
+
+    TEST(short_string_is_inline, {
+        Ac_SsoString str = ac_sso_from("foo");
+
+        ASSERT(ac_sso_is_inline(&str));
+        ASSERT_EQ((size_t)3, ac_sso_len(&str), "%zu");
+        ASSERT_STR_EQ("foo", ac_sso_chars(&str));
+        ASSERT_EQ((char*)&str, ac_sso_chars(&str), "%p");
+
+        ac_sso_free(&str);
+    });
+
+    TEST(full_inline_string, {
+        char chs[AC_SSO_CAP + 1];
+        memset(chs, 'a', AC_SSO_CAP);
+        chs[AC_SSO_CAP] = '\0';
+
+        Ac_SsoString str = ac_sso_from(chs);
+        ASSERT(ac_sso_is_inline(&str));
+        ASSERT_EQ((size_t)AC_SSO_CAP, ac_sso_len(&str), "%zu");
+        ASSERT_STR_EQ(chs, ac_sso_chars(&str));
+
+        ac_sso_free(&str);
+    });
+
+    TEST(push_spills_to_heap, {
+        Ac_SsoString str = {0};
+
+        for (size_t i = 0; i < AC_SSO_CAP; i++)
+            ac_sso_push(&str, 'a' + (i % 26));
+        ASSERT(ac_sso_is_inline(&str));
+
+        ac_sso_push(&str, '!');
+        ASSERT(!ac_sso_is_inline(&str));
+        ASSERT_EQ((size_t)AC_SSO_CAP + 1, ac_sso_len(&str), "%zu");
+        ASSERT_LTE((size_t)AC_SSO_CAP + 1, ac_sso_cap(&str), "%zu");
+        ASSERT_EQ('a', ac_sso_chars(&str)[0], "%c");
+        ASSERT_EQ('!', ac_sso_chars(&str)[AC_SSO_CAP], "%c");
+        ASSERT_EQ('\0', ac_sso_chars(&str)[AC_SSO_CAP + 1], "%c");
+
+        ac_sso_free(&str);
+        ASSERT(ac_sso_is_inline(&str));
+        ASSERT_EQ((size_t)0, ac_sso_len(&str), "%zu");
+    });
+
+    TEST(append_long_string, {
+        Ac_SsoString str = ac_sso_from("foo");
+        ac_sso_append(&str, " and a string that is longer than the inline capacity");
+
+        ASSERT(!ac_sso_is_inline(&str));
+        ASSERT_STR_EQ("foo and a string that is longer than the inline capacity",
+                      ac_sso_chars(&str));
+
+        ac_sso_append(&str, "!");
+        ASSERT_STR_EQ("foo and a string that is longer than the inline capacity!",
+                      ac_sso_chars(&str));
+
+        ac_sso_free(&str);
+    });
+
+    TEST(pop_and_empty, {
+        Ac_SsoString str = ac_sso_from("bar");
+
+        ASSERT_EQ('r', ac_sso_pop(&str), "%c");
+        ASSERT_STR_EQ("ba", ac_sso_chars(&str));
+
+        ac_sso_empty(&str);
+        ASSERT_EQ((size_t)0, ac_sso_len(&str), "%zu");
+        ASSERT_STR_EQ("", ac_sso_chars(&str));
+
+        ac_sso_free(&str);
+    });
+
+    TEST(slice_and_fmt, {
+        Ac_SsoString str = ac_sso_from_slice(ac_str_slice_from("hello"));
+        Ac_StrSlice slice = ac_sso_slice(&str);
+        ASSERT_EQ((size_t)5, slice.len, "%zu");
+
+        char buf[32];
+        sprintf(buf, "'" AC_STR_FMT "'", AC_SSO_ARG(str));
+        ASSERT_STR_EQ("'hello'", buf);
+
+        ac_sso_free(&str);
+    });
+
+    TEST_END;
+}
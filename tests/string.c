@@ -1,8 +1,82 @@
+#include <inttypes.h>
 #include <stdio.h>
 #define ACLIB_IMPLEMENTATION
 #include "../aclib.h"
 #include "test.h"
 
+char* split_iter_inputs[] = {"", "a", ",", "a,b", ",a,,b,", "no delims here"};
+char* split_iter_substr_parts[] = {"a", "b:c", "", ""};
+
+/// A naive substring search to check the fast ones against
+size_t naive_find(Ac_StrSlice haystack, Ac_StrSlice needle, bool last)
+{
+    size_t found = SIZE_MAX;
+    for (size_t i = 0; i + needle.len <= haystack.len; i++)
+    {
+        if (memcmp(haystack.chars + i, needle.chars, needle.len) == 0)
+        {
+            found = i;
+            if (!last)
+                break;
+        }
+    }
+    return found;
+}
+
+bool slice_eql(Ac_StrSlice a, Ac_StrSlice b)
+{
+    return a.len == b.len && memcmp(a.chars, b.chars, a.len) == 0;
+}
+
+// Lengths that go through every path of the hash
+size_t hash_lens[8] = {1, 3, 8, 16, 47, 200, 256, 2048};
+size_t hash_chunk_sizes[5] = {1, 7, 64, 100, 300};
+
+char* multi_patterns[] = {"he", "she", "his", "hers", ""};
+
+double f64_samples[] = {0.1, 1.0 / 3.0, 2.5e-310, 6.02214076e23, 1e22, 9007199254740993.0, 1e-5};
+
+// Numbers that go through every path of the double parser
+char* f64_inputs[] = {
+    "0",         "-0.0",         "3.14159",   ".5",         "1e22",
+    "1e23",      "123456789012", "-2.5e-3",   "5e-324",     "2.2250738585072011e-308",
+    "7.038531e-26", "1.7976931348623157e308", "123456789012345678901234567890",
+    "9007199254740992.5000000000000000001",   "0.000000000000000000000000000001234567890123456789",
+    // Halfway between 1 and the next double, exactly, just below and just above
+    "1.00000000000000011102230246251565404236316680908203125",
+    "1.000000000000000111022302462515654042363166809082031249999999",
+    "1.00000000000000011102230246251565404236316680908203125000000000000000000000000000000001",
+};
+
+// Invalid UTF-8: a lone continuation, an overlong '/', a surrogate, a code point past U+10FFFF, a
+// truncated euro sign and a lead byte that never starts a sequence
+char* invalid_utf8[] = {"\x80", "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE2\x82", "\xFF"};
+
+// An allocator that is always out of memory
+void* failing_alloc(void* ctx, size_t size)
+{
+    return NULL;
+}
+
+Ac_StrInterner shared_interner;
+uint32_t interned_ids[4][1000];
+
+// Intern the same 1000 names as the other threads, each thread starting at a different name
+void* intern_names(void* arg)
+{
+    size_t thread = (size_t)arg;
+    char name[32];
+
+    for (size_t i = 0; i < 1000; i++)
+    {
+        size_t n = (i + thread * 250) % 1000;
+        snprintf(name, sizeof(name), "host-%zu", n);
+        Ac_InternedStr interned = ac_str_interner_intern(&shared_interner, ac_str_slice_from(name));
+        interned_ids[thread][n] = interned.id;
+    }
+    return NULL;
+}
+
 int main(void)
 {
     TEST_INIT;
@@ -11,7 +85,7 @@ int main(void)
         Ac_String str = ac_str_from("foo");
 
         ASSERT_EQ((size_t)3, str.len, "%zu");
-        ASSERT_GTE((size_t)3, str.cap, "%zu");
+        ASSERT_LTE((size_t)3, str.cap, "%zu");
         ASSERT_STR_EQ("foo", str.chars);
 
         ac_str_free(&str);
@@ -22,7 +96,7 @@ int main(void)
         Ac_String str = ac_str_from(cstr);
 
         ASSERT_EQ((size_t)3, str.len, "%zu");
-        ASSERT_GTE((size_t)3, str.cap, "%zu");
+        ASSERT_LTE((size_t)3, str.cap, "%zu");
         ASSERT_STR_EQ(cstr, str.chars);
         ASSERT_NEQ(cstr, str.chars, "%p");
 
@@ -34,7 +108,7 @@ int main(void)
         Ac_String str = ac_str_from(slice.chars);
 
         ASSERT_EQ((size_t)3, str.len, "%zu");
-        ASSERT_GTE((size_t)3, str.cap, "%zu");
+        ASSERT_LTE((size_t)3, str.cap, "%zu");
         ASSERT_STR_EQ(slice.chars, str.chars);
         ASSERT_NEQ(slice.chars, str.chars, "%p");
 
@@ -59,7 +133,7 @@ int main(void)
 
         ac_str_push(&str, 'E');
         ASSERT_EQ((size_t)1, str.len, "%zu");
-        ASSERT_GTE((size_t)1, str.cap, "%zu");
+        ASSERT_LTE((size_t)1, str.cap, "%zu");
         ASSERT_STR_EQ("E", str.chars);
         size_t prev_cap = str.cap;
 
@@ -107,7 +181,7 @@ int main(void)
 
         ac_str_unshift(&str, 'E');
         ASSERT_EQ((size_t)1, str.len, "%zu");
-        ASSERT_GTE((size_t)1, str.cap, "%zu");
+        ASSERT_LTE((size_t)1, str.cap, "%zu");
         ASSERT_STR_EQ("E", str.chars);
         size_t prev_cap = str.cap;
 
@@ -151,6 +225,297 @@ int main(void)
         ac_str_free(&str);
     });
 
+    TEST(format_past_capacity, {
+        Ac_String str = ac_str_with_capacity(4);
+        char* long_word = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+        // The first format doesn't fit in the spare capacity, so it is formatted again
+        ac_str_appendf(&str, "%s", long_word);
+        ac_str_appendf(&str, "-%d-", 1234567);
+        ASSERT_STR_EQ("abcdefghijklmnopqrstuvwxyz0123456789-1234567-", str.chars);
+        ASSERT_EQ((size_t)45, str.len, "%zu");
+
+        ac_str_prependf(&str, "%s|", long_word);
+        ac_str_prependf(&str, "%d:", 7);
+        ac_str_prependf(&str, "%s", "");
+        ASSERT_STR_EQ("7:abcdefghijklmnopqrstuvwxyz0123456789|"
+                      "abcdefghijklmnopqrstuvwxyz0123456789-1234567-",
+                      str.chars);
+        ASSERT_EQ((size_t)84, str.len, "%zu");
+
+        ac_str_free(&str);
+    });
+
+    TEST(append_integers, {
+        Ac_String str = {0};
+
+        ac_str_append_i64(&str, 0);
+        ac_str_push(&str, ' ');
+        ac_str_append_i64(&str, -42);
+        ac_str_push(&str, ' ');
+        ac_str_append_i64(&str, INT64_MIN);
+        ac_str_push(&str, ' ');
+        ac_str_append_u64(&str, UINT64_MAX);
+        ac_str_push(&str, ' ');
+        ac_str_append_u64_hex(&str, 0);
+        ac_str_push(&str, ' ');
+        ac_str_append_u64_hex(&str, 0xDEADBEEF);
+        ASSERT_STR_EQ("0 -42 -9223372036854775808 18446744073709551615 0 deadbeef", str.chars);
+
+        // Every digit count, against printf
+        char expected[32];
+        for (uint64_t value = 1; value != 0 && value < UINT64_MAX / 3; value = value * 3 + 1)
+        {
+            ac_str_empty(&str);
+            ac_str_append_u64(&str, value);
+            snprintf(expected, sizeof(expected), "%llu", (unsigned long long)value);
+            ASSERT_STR_EQ(expected, str.chars);
+            ASSERT_EQ(strlen(expected), str.len, "%zu");
+        }
+
+        ac_str_free(&str);
+    });
+
+    TEST(append_padded_integers, {
+        Ac_String str = {0};
+
+        ac_str_append_i64_padded(&str, -42, 6, '0');
+        ac_str_push(&str, '|');
+        ac_str_append_i64_padded(&str, -42, 6, ' ');
+        ac_str_push(&str, '|');
+        ac_str_append_u64_padded(&str, 12345, 3, '0');
+        ac_str_push(&str, '|');
+        ac_str_append_u64_hex_padded(&str, 0xBEEF, 8, '0');
+        ASSERT_STR_EQ("-00042|   -42|12345|0000beef", str.chars);
+
+        ac_str_free(&str);
+    });
+
+    TEST(append_f64, {
+        Ac_String str = {0};
+
+        ac_str_append_f64(&str, 0.1);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, -1.5e300);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, 100.0);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, 1e21);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, 0.000125);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, 5e-324);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, -0.0);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, 1.0 / 0.0);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, 0.0 / 0.0);
+        ASSERT_STR_EQ("0.1 -1.5e+300 100 1e+21 0.000125 5e-324 -0 inf nan", str.chars);
+
+        // Doubles too close to call with 64-bit math are still written in the fewest digits
+        ac_str_empty(&str);
+        ac_str_append_f64(&str, 1e23);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, 9e-265);
+        ac_str_push(&str, ' ');
+        ac_str_append_f64(&str, 8.41e21);
+        ASSERT_STR_EQ("1e+23 9e-265 8.41e+21", str.chars);
+
+        // The written digits parse back to the same double
+        for (size_t i = 0; i < sizeof(f64_samples) / sizeof(f64_samples[0]); i++)
+        {
+            ac_str_empty(&str);
+            ac_str_append_f64(&str, f64_samples[i]);
+            ASSERT_EQ(f64_samples[i], strtod(str.chars, NULL), "%.17g");
+            ASSERT_LTE(str.len, (size_t)24, "%zu");
+        }
+
+        ac_str_free(&str);
+    });
+
+    TEST(parse_integers, {
+        Ac_ParsedI64Res i64 = ac_str_parse_i64(ac_str_slice_from("-1234567890123,rest"));
+        ASSERT_EQ(AC_RES_OK, i64.tag, "%d");
+        ASSERT_EQ((int64_t)-1234567890123, i64.ok.value, "%" PRId64);
+        ASSERT_EQ((size_t)14, i64.ok.consumed, "%zu");
+
+        i64 = ac_str_parse_i64(ac_str_slice_from("-9223372036854775808"));
+        ASSERT_EQ(INT64_MIN, i64.ok.value, "%" PRId64);
+        i64 = ac_str_parse_i64(ac_str_slice_from("9223372036854775808"));
+        ASSERT_EQ(AC_RES_ERR, i64.tag, "%d");
+        ASSERT_EQ(ERANGE, i64.err, "%d");
+        i64 = ac_str_parse_i64(ac_str_slice_from("+"));
+        ASSERT_EQ(EINVAL, i64.err, "%d");
+        i64 = ac_str_parse_i64(ac_str_slice_from(" 1"));
+        ASSERT_EQ(EINVAL, i64.err, "%d");
+
+        Ac_ParsedU64Res u64 = ac_str_parse_u64(ac_str_slice_from("18446744073709551615"));
+        ASSERT_EQ(UINT64_MAX, u64.ok.value, "%" PRIu64);
+        u64 = ac_str_parse_u64(ac_str_slice_from("0000000000000000000000042"));
+        ASSERT_EQ((uint64_t)42, u64.ok.value, "%" PRIu64);
+        ASSERT_EQ((size_t)25, u64.ok.consumed, "%zu");
+        u64 = ac_str_parse_u64(ac_str_slice_from("18446744073709551616"));
+        ASSERT_EQ(ERANGE, u64.err, "%d");
+        u64 = ac_str_parse_u64(ac_str_slice_from("-1"));
+        ASSERT_EQ(EINVAL, u64.err, "%d");
+
+        // Every digit count, so the digits are parsed both eight at a time and one at a time
+        Ac_String str = {0};
+        for (uint64_t value = 1; value != 0 && value < UINT64_MAX / 3; value = value * 3 + 1)
+        {
+            ac_str_empty(&str);
+            ac_str_append_u64(&str, value);
+            ac_str_push(&str, 'x');
+            u64 = ac_str_parse_u64(str.slice);
+            ASSERT_EQ(value, u64.ok.value, "%" PRIu64);
+            ASSERT_EQ(str.len - 1, u64.ok.consumed, "%zu");
+        }
+        ac_str_free(&str);
+    });
+
+    TEST(parse_f64, {
+        // Every input is parsed to the same double, from the same chars, as strtod
+        for (size_t i = 0; i < sizeof(f64_inputs) / sizeof(f64_inputs[0]); i++)
+        {
+            char* end;
+            double expected = strtod(f64_inputs[i], &end);
+            Ac_ParsedF64Res res = ac_str_parse_f64(ac_str_slice_from(f64_inputs[i]));
+            ASSERT_EQ(AC_RES_OK, res.tag, "%d");
+            ASSERT_EQ(0, memcmp(&expected, &res.ok.value, sizeof(double)), "%d");
+            ASSERT_EQ((size_t)(end - f64_inputs[i]), res.ok.consumed, "%zu");
+        }
+
+        // The exponent is left out without digits
+        Ac_ParsedF64Res res = ac_str_parse_f64(ac_str_slice_from("1.5e+;"));
+        ASSERT_EQ(1.5, res.ok.value, "%g");
+        ASSERT_EQ((size_t)3, res.ok.consumed, "%zu");
+
+        res = ac_str_parse_f64(ac_str_slice_from("-Infinity"));
+        ASSERT_EQ(-1.0 / 0.0, res.ok.value, "%g");
+        ASSERT_EQ((size_t)9, res.ok.consumed, "%zu");
+        res = ac_str_parse_f64(ac_str_slice_from("nan"));
+        ASSERT(res.ok.value != res.ok.value);
+
+        res = ac_str_parse_f64(ac_str_slice_from("1e309"));
+        ASSERT_EQ(ERANGE, res.err, "%d");
+        res = ac_str_parse_f64(ac_str_slice_from("-."));
+        ASSERT_EQ(EINVAL, res.err, "%d");
+
+        // Rounding by all of the digits doesn't allocate
+        Ac_Allocator allocator = {.alloc = failing_alloc};
+        aclib_thread_allocator = &allocator;
+        res = ac_str_parse_f64(ac_str_slice_from(f64_inputs[15]));
+        ASSERT_EQ(1.0, res.ok.value, "%.17g");
+        res = ac_str_parse_f64(ac_str_slice_from(f64_inputs[17]));
+        ASSERT_EQ(1.0000000000000002, res.ok.value, "%.17g");
+        aclib_thread_allocator = NULL;
+
+        // Written doubles parse back to themselves
+        Ac_String str = {0};
+        for (size_t i = 0; i < sizeof(f64_samples) / sizeof(f64_samples[0]); i++)
+        {
+            ac_str_empty(&str);
+            ac_str_append_f64(&str, f64_samples[i]);
+            ASSERT_EQ(f64_samples[i], ac_str_parse_f64(str.slice).ok.value, "%.17g");
+        }
+        ac_str_free(&str);
+    });
+
+    TEST(utf8_validate_and_count, {
+        Ac_String str = {0};
+        ASSERT(ac_str_utf8_validate(str.slice));
+        ASSERT_EQ((size_t)0, ac_str_utf8_count(str.slice), "%zu");
+
+        // Long enough for every block size, with the multi-byte chars crossing block boundaries
+        for (int i = 0; i < 20; i++)
+            ac_str_append(&str, "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"); // "aé€😀"
+        ASSERT(ac_str_utf8_validate(str.slice));
+        ASSERT_EQ((size_t)80, ac_str_utf8_count(str.slice), "%zu");
+
+        // Every invalid sequence is caught at every offset
+        size_t valid_len = str.len;
+        for (size_t i = 0; i < sizeof(invalid_utf8) / sizeof(invalid_utf8[0]); i++)
+        {
+            for (size_t at = 0; at <= valid_len; at += 10)
+            {
+                Ac_String invalid = ac_str_from("");
+                ac_str_append_slice(&invalid, ((Ac_StrSlice){.chars = str.chars, .len = at}));
+                ac_str_append(&invalid, invalid_utf8[i]);
+                ASSERT(!ac_str_utf8_validate(invalid.slice));
+
+                ac_str_append(&invalid, "bcdefghijklmnopqrstuvwxyz");
+                ASSERT(!ac_str_utf8_validate(invalid.slice));
+                ac_str_free(&invalid);
+            }
+        }
+
+        ac_str_free(&str);
+    });
+
+    TEST(utf8_slice_range, {
+        Ac_StrSlice slice = ac_str_slice_from("a\xC3\xA9\xE2\x82\xAC!"); // "aé€!"
+
+        // Both ends move back to the start of the code point they are in
+        Ac_StrSlice part = ac_str_utf8_slice_range(slice, 2, 5);
+        ASSERT_STR_LEN_EQ("\xC3\xA9", part.chars, part.len);
+        ASSERT_EQ((size_t)2, part.len, "%zu");
+
+        part = ac_str_utf8_slice_range(slice, 0, slice.len);
+        ASSERT_EQ(slice.len, part.len, "%zu");
+
+        part = ac_str_utf8_slice_range(slice, 4, 5);
+        ASSERT_EQ((size_t)0, part.len, "%zu");
+
+        // Ranges that meet in the middle of a code point still cover the slice between them
+        Ac_StrSlice first = ac_str_utf8_slice_range(slice, 0, 4);
+        Ac_StrSlice second = ac_str_utf8_slice_range(slice, 4, slice.len);
+        ASSERT_EQ(first.chars + first.len, second.chars, "%p");
+        ASSERT_EQ(slice.len, first.len + second.len, "%zu");
+
+        part = ac_str_utf8_slice_range(slice, 3, 100);
+        ASSERT_EQ((char*)0, part.chars, "%p");
+    });
+
+    TEST(prependf_in_place, {
+        Ac_String str = ac_str_with_capacity(64);
+        for (size_t i = 0; i < 50; i++)
+            ac_str_push(&str, 'a' + i % 26);
+        size_t cap = str.cap;
+
+        // The formatted chars fit in the spare capacity, so the string doesn't grow
+        ac_str_prependf(&str, "%d|", 123456789);
+        ASSERT_EQ(cap, str.cap, "%zu");
+        ASSERT_EQ((size_t)60, str.len, "%zu");
+        ASSERT_STR_LEN_EQ("123456789|abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwx", str.chars,
+                          60);
+
+        // Longer than the stack buffer, so it is rotated into place by reversals
+        char long_chars[301];
+        memset(long_chars, 'z', 300);
+        long_chars[0] = '<';
+        long_chars[299] = '>';
+        long_chars[300] = '\0';
+        ac_str_prependf(&str, "%s", long_chars);
+        ASSERT_EQ((size_t)360, str.len, "%zu");
+        ASSERT_STR_LEN_EQ(long_chars, str.chars, 300);
+        ASSERT_STR_EQ("123456789|abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwx",
+                      str.chars + 300);
+
+        ac_str_free(&str);
+    });
+
+    TEST(prepend_shorter_than_string, {
+        Ac_String str = ac_str_from("0123456789abcdefghij");
+
+        // The old chars are moved up by less than their length, so they overlap their new place
+        ac_str_prepend(&str, "xyz");
+        ASSERT_STR_EQ("xyz0123456789abcdefghij", str.chars);
+        ASSERT_EQ((size_t)23, str.len, "%zu");
+
+        ac_str_free(&str);
+    });
+
     TEST(pop_opt_some, {
         Ac_String str = ac_str_from("foobar");
         ASSERT_EQ((size_t)6, str.len, "%zu");
@@ -454,8 +819,7 @@ int main(void)
 
         ac_str_free(&str);
 
-        for (size_t i = 0; i < parts.len; i++)
-            ac_str_slice_free(&parts.items[i]);
+        ac_str_parts_free(&parts);
     });
 
     TEST(split_by_no_matches, {
@@ -493,8 +857,7 @@ int main(void)
 
         ac_str_free(&str);
 
-        for (size_t i = 0; i < parts.len; i++)
-            ac_str_slice_free(&parts.items[i]);
+        ac_str_parts_free(&parts);
     });
 
     TEST(simple_split_by_many, {
@@ -524,8 +887,7 @@ int main(void)
 
         ac_str_free(&str);
 
-        for (size_t i = 0; i < parts.len; i++)
-            ac_str_slice_free(&parts.items[i]);
+        ac_str_parts_free(&parts);
     });
 
     TEST(simple_split_at, {
@@ -552,8 +914,7 @@ int main(void)
 
         ac_str_free(&str);
 
-        for (size_t i = 0; i < parts.len; i++)
-            ac_str_slice_free(&parts.items[i]);
+        ac_str_parts_free(&parts);
     });
 
     TEST(simple_split_at_out_of_bounds, {
@@ -577,8 +938,218 @@ int main(void)
 
         ac_str_free(&str);
 
-        for (size_t i = 0; i < parts.len; i++)
-            ac_str_slice_free(&parts.items[i]);
+        ac_str_parts_free(&parts);
+    });
+
+    TEST(split_by_keeps_empty_parts, {
+        Ac_String str = ac_str_from("a,,b,");
+
+        Ac_StrVec parts = ac_str_split_by(str, ',');
+
+        ASSERT_EQ((size_t)4, parts.len, "%zu");
+        ASSERT_STR_EQ("a", parts.items[0].chars);
+        ASSERT_STR_EQ("", parts.items[1].chars);
+        ASSERT_STR_EQ("b", parts.items[2].chars);
+        ASSERT_STR_EQ("", parts.items[3].chars);
+
+        ac_str_free(&str);
+
+        ac_str_parts_free(&parts);
+    });
+
+    TEST(split_by_once_no_matches, {
+        Ac_String str = ac_str_from("foobar");
+
+        Ac_StrVec parts = ac_str_split_by_once(str, ' ');
+
+        ASSERT_EQ((size_t)1, parts.len, "%zu");
+        ASSERT_STR_EQ("foobar", parts.items[0].chars);
+        ASSERT_NEQ(str.chars, parts.items[0].chars, "%p");
+
+        ac_str_free(&str);
+
+        ac_str_parts_free(&parts);
+    });
+
+    TEST(split_by_borrowed, {
+        Ac_StrSlice slc = ac_str_slice_from("foo bar  baz");
+
+        Ac_StrVec parts = ac_str_split_by_borrowed(slc, ' ');
+
+        ASSERT_EQ((size_t)4, parts.len, "%zu");
+        ASSERT_STR_LEN_EQ("foo", parts.items[0].chars, parts.items[0].len);
+        ASSERT_STR_LEN_EQ("bar", parts.items[1].chars, parts.items[1].len);
+        ASSERT_EQ((size_t)0, parts.items[2].len, "%zu");
+        ASSERT_STR_LEN_EQ("baz", parts.items[3].chars, parts.items[3].len);
+
+        // The parts point into the original slice
+        ASSERT_EQ(slc.chars, parts.items[0].chars, "%p");
+        ASSERT_EQ(slc.chars + 4, parts.items[1].chars, "%p");
+        ASSERT_EQ(slc.chars + 9, parts.items[3].chars, "%p");
+
+        ac_vec_free(parts);
+    });
+
+    TEST(split_by_many_borrowed, {
+        Ac_StrSlice slc = ac_str_slice_from("foo bar\tbaz");
+
+        Ac_StrVec parts = ac_str_split_by_many_borrowed(slc, " \t");
+
+        ASSERT_EQ((size_t)3, parts.len, "%zu");
+        ASSERT_STR_LEN_EQ("foo", parts.items[0].chars, parts.items[0].len);
+        ASSERT_STR_LEN_EQ("bar", parts.items[1].chars, parts.items[1].len);
+        ASSERT_STR_LEN_EQ("baz", parts.items[2].chars, parts.items[2].len);
+        ASSERT_EQ(slc.chars + 8, parts.items[2].chars, "%p");
+
+        ac_vec_free(parts);
+    });
+
+    TEST(split_by_once_and_at_borrowed, {
+        Ac_StrSlice slc = ac_str_slice_from("foo bar baz");
+
+        Ac_StrVec parts = ac_str_split_by_once_borrowed(slc, ' ');
+
+        ASSERT_EQ((size_t)2, parts.len, "%zu");
+        ASSERT_STR_LEN_EQ("foo", parts.items[0].chars, parts.items[0].len);
+        ASSERT_STR_LEN_EQ("bar baz", parts.items[1].chars, parts.items[1].len);
+        ASSERT_EQ(slc.chars + 4, parts.items[1].chars, "%p");
+        ac_vec_free(parts);
+
+        parts = ac_str_split_at_borrowed(slc, 3);
+
+        ASSERT_EQ((size_t)2, parts.len, "%zu");
+        ASSERT_STR_LEN_EQ("foo", parts.items[0].chars, parts.items[0].len);
+        ASSERT_STR_LEN_EQ(" bar baz", parts.items[1].chars, parts.items[1].len);
+        ASSERT_EQ(slc.chars + 3, parts.items[1].chars, "%p");
+        ac_vec_free(parts);
+    });
+
+    TEST(split_into_reuses_vector, {
+        Ac_StrVec parts = {0};
+
+        ac_str_split_by_into(&parts, ac_str_slice_from("a b c d"), ' ');
+        ASSERT_EQ((size_t)4, parts.len, "%zu");
+        Ac_StrSlice* old_items = parts.items;
+        size_t old_cap = parts.cap;
+
+        ac_vec_empty(&parts);
+        ac_str_split_by_into(&parts, ac_str_slice_from("x y"), ' ');
+        ASSERT_EQ((size_t)2, parts.len, "%zu");
+        ASSERT_EQ(old_items, parts.items, "%p");
+        ASSERT_EQ(old_cap, parts.cap, "%zu");
+        ASSERT_STR_LEN_EQ("y", parts.items[1].chars, parts.items[1].len);
+
+        // Appends after the existing parts
+        ac_str_split_at_into(&parts, ac_str_slice_from("zw"), 1);
+        ASSERT_EQ((size_t)4, parts.len, "%zu");
+        ASSERT_STR_LEN_EQ("w", parts.items[3].chars, parts.items[3].len);
+
+        ac_vec_free(parts);
+    });
+
+    TEST(split_iter_by_char, {
+        Ac_StrSlice slc = ac_str_slice_from("foo,,bar,");
+        Ac_StrSplitIter iter = ac_str_split_iter(slc, ',');
+
+        Ac_StrSliceOpt part = ac_str_split_iter_next(&iter);
+        ASSERT_EQ(AC_OPT_SOME, part.tag, "{tag: %d}");
+        ASSERT_STR_LEN_EQ("foo", part.some.chars, part.some.len);
+        ASSERT_EQ(slc.chars, part.some.chars, "%p");
+
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_EQ((size_t)0, part.some.len, "%zu");
+
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_STR_LEN_EQ("bar", part.some.chars, part.some.len);
+        ASSERT_EQ(slc.chars + 5, part.some.chars, "%p");
+
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_EQ(AC_OPT_SOME, part.tag, "{tag: %d}");
+        ASSERT_EQ((size_t)0, part.some.len, "%zu");
+
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_EQ(AC_OPT_NONE, part.tag, "{tag: %d}");
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_EQ(AC_OPT_NONE, part.tag, "{tag: %d}");
+    });
+
+    TEST(split_iter_matches_split_by, {
+        for (size_t i = 0; i < sizeof(split_iter_inputs) / sizeof(*split_iter_inputs); i++)
+        {
+            Ac_StrSlice slc = ac_str_slice_from(split_iter_inputs[i]);
+            Ac_StrVec parts = ac_str_split_by_borrowed(slc, ',');
+            Ac_StrSplitIter iter = ac_str_split_iter(slc, ',');
+
+            size_t n = 0;
+            for (Ac_StrSliceOpt part = ac_str_split_iter_next(&iter); part.tag == AC_OPT_SOME;
+                 part = ac_str_split_iter_next(&iter))
+            {
+                ASSERT_EQ(parts.items[n].chars, part.some.chars, "%p");
+                ASSERT_EQ(parts.items[n].len, part.some.len, "%zu");
+                n++;
+            }
+            ASSERT_EQ(parts.len, n, "%zu");
+
+            ac_vec_free(parts);
+        }
+    });
+
+    TEST(split_iter_many, {
+        Ac_StrSplitIter iter = ac_str_split_iter_many(ac_str_slice_from("foo bar\tbaz"), " \t");
+
+        Ac_StrSliceOpt part = ac_str_split_iter_next(&iter);
+        ASSERT_STR_LEN_EQ("foo", part.some.chars, part.some.len);
+
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_STR_LEN_EQ("bar", part.some.chars, part.some.len);
+
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_STR_LEN_EQ("baz", part.some.chars, part.some.len);
+        ASSERT_EQ((size_t)3, part.some.len, "%zu");
+
+        ASSERT_EQ(AC_OPT_NONE, ac_str_split_iter_next(&iter).tag, "{tag: %d}");
+    });
+
+    TEST(split_iter_substr, {
+        Ac_StrSplitIter iter =
+            ac_str_split_iter_substr(ac_str_slice_from("a::b:c::::"), ac_str_slice_from("::"));
+
+        char** expected = split_iter_substr_parts;
+        for (size_t i = 0; i < 4; i++)
+        {
+            Ac_StrSliceOpt part = ac_str_split_iter_next(&iter);
+            ASSERT_EQ(AC_OPT_SOME, part.tag, "{tag: %d}");
+            ASSERT_EQ(strlen(expected[i]), part.some.len, "%zu");
+            ASSERT_STR_LEN_EQ(expected[i], part.some.chars, part.some.len);
+        }
+        ASSERT_EQ(AC_OPT_NONE, ac_str_split_iter_next(&iter).tag, "{tag: %d}");
+
+        // An empty needle never splits
+        iter = ac_str_split_iter_substr(ac_str_slice_from("abc"), ac_str_slice_from(""));
+        Ac_StrSliceOpt whole = ac_str_split_iter_next(&iter);
+        ASSERT_EQ((size_t)3, ac_opt_unwrap(whole).len, "%zu");
+        ASSERT_EQ(AC_OPT_NONE, ac_str_split_iter_next(&iter).tag, "{tag: %d}");
+    });
+
+    TEST(split_iter_limit, {
+        Ac_StrSplitIter iter = ac_str_split_iter(ac_str_slice_from("k=v=w"), '=');
+        ac_str_split_iter_limit(&iter, 1);
+
+        Ac_StrSliceOpt part = ac_str_split_iter_next(&iter);
+        ASSERT_STR_LEN_EQ("k", part.some.chars, part.some.len);
+        ASSERT_EQ((size_t)1, part.some.len, "%zu");
+
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_STR_LEN_EQ("v=w", part.some.chars, part.some.len);
+        ASSERT_EQ((size_t)3, part.some.len, "%zu");
+
+        ASSERT_EQ(AC_OPT_NONE, ac_str_split_iter_next(&iter).tag, "{tag: %d}");
+
+        // A limit of zero yields the whole slice
+        iter = ac_str_split_iter(ac_str_slice_from("a=b"), '=');
+        ac_str_split_iter_limit(&iter, 0);
+        part = ac_str_split_iter_next(&iter);
+        ASSERT_EQ((size_t)3, ac_opt_unwrap(part).len, "%zu");
     });
 
     TEST(simple_read_file, {
@@ -599,6 +1170,113 @@ int main(void)
         ac_str_free(&str);
     });
 
+    TEST(read_file_regular_file, {
+        FILE* file = tmpfile();
+
+        // Embedded NULs, and more than a single read chunk
+        fwrite("ab\0cd", 1, 5, file);
+        for (size_t i = 0; i < 300000; i++)
+            fputc('0' + i % 10, file);
+        rewind(file);
+
+        // Reads from the current position of the file
+        ASSERT_EQ('a', fgetc(file), "%c");
+
+        Ac_String str = ac_str_from("xy");
+        size_t bytes_read = ac_str_read_file(&str, file);
+
+        ASSERT_EQ((size_t)300004, bytes_read, "%zu");
+        ASSERT_EQ((size_t)300006, str.len, "%zu");
+        ASSERT_EQ(0, memcmp("xyb\0cd012", str.chars, 9), "%d");
+        ASSERT_EQ('9', str.chars[str.len - 1], "%c");
+        ASSERT_EQ('\0', str.chars[str.len], "%c");
+
+        ac_str_free(&str);
+        fclose(file);
+    });
+
+    TEST(read_file_pipe, {
+        int fds[2];
+        ASSERT_EQ(0, pipe(fds), "%d");
+
+        char data[10000];
+        for (size_t i = 0; i < sizeof(data); i++)
+            data[i] = (char)i;
+        ASSERT_EQ((ssize_t)sizeof(data), write(fds[1], data, sizeof(data)), "%zd");
+        close(fds[1]);
+
+        FILE* file = fdopen(fds[0], "r");
+        Ac_String str = {0};
+        size_t bytes_read = ac_str_read_file(&str, file);
+
+        ASSERT_EQ(sizeof(data), bytes_read, "%zu");
+        ASSERT_EQ(sizeof(data), str.len, "%zu");
+        ASSERT_EQ(0, memcmp(data, str.chars, sizeof(data)), "%d");
+
+        ac_str_free(&str);
+        fclose(file);
+    });
+
+    TEST(map_file, {
+        char path[] = "/tmp/aclib_map_file_XXXXXX";
+        int fd = mkstemp(path);
+        ASSERT_NEQ(-1, fd, "%d");
+
+        char* contents = "  foo,bar\0baz\n";
+        ASSERT_EQ((ssize_t)14, write(fd, contents, 14), "%zd");
+        close(fd);
+
+        Ac_StrSliceRes res = ac_str_map_file(path, AC_MAP_SEQUENTIAL | AC_MAP_WILLNEED);
+        ASSERT_EQ(AC_RES_OK, res.tag, "{tag: %d}");
+
+        Ac_StrSlice file = res.ok;
+        ASSERT_EQ((size_t)14, file.len, "%zu");
+        ASSERT_EQ(0, memcmp(contents, file.chars, 14), "%d");
+
+        // Slice functions work on the mapping without copying it
+        Ac_StrSlice trimmed = ac_str_trimmed(file);
+        ASSERT_EQ(file.chars + 2, trimmed.chars, "%p");
+
+        Ac_StrVec parts = ac_str_split_by_borrowed(trimmed, ',');
+        ASSERT_EQ((size_t)2, parts.len, "%zu");
+        ASSERT_EQ((size_t)7, parts.items[1].len, "%zu");
+        ASSERT_EQ(file.chars + 6, parts.items[1].chars, "%p");
+        ac_vec_free(parts);
+
+        ac_str_unmap_file(&file);
+        ASSERT_EQ((size_t)0, file.len, "%zu");
+        ASSERT_EQ((char*)0, file.chars, "%p");
+
+        unlink(path);
+    });
+
+    TEST(map_file_empty_missing_and_special, {
+        char path[] = "/tmp/aclib_map_file_XXXXXX";
+        int fd = mkstemp(path);
+        ASSERT_NEQ(-1, fd, "%d");
+        close(fd);
+
+        Ac_StrSliceRes res = ac_str_map_file(path, AC_MAP_NORMAL);
+        ASSERT_EQ(AC_RES_OK, res.tag, "{tag: %d}");
+        ASSERT_EQ((size_t)0, res.ok.len, "%zu");
+        ac_str_unmap_file(&res.ok);
+
+        unlink(path);
+
+        res = ac_str_map_file(path, AC_MAP_HUGEPAGE);
+        ASSERT_EQ(AC_RES_ERR, res.tag, "{tag: %d}");
+        ASSERT_EQ(ENOENT, res.err, "%d");
+
+        // Neither of these can be mapped, even though the /proc entry has contents
+        res = ac_str_map_file("/dev/null", AC_MAP_NORMAL);
+        ASSERT_EQ(AC_RES_ERR, res.tag, "{tag: %d}");
+        ASSERT_EQ(EINVAL, res.err, "%d");
+
+        res = ac_str_map_file("/proc/self/status", AC_MAP_NORMAL);
+        ASSERT_EQ(AC_RES_ERR, res.tag, "{tag: %d}");
+        ASSERT_EQ(EINVAL, res.err, "%d");
+    });
+
     TEST(simple_read_file_lines, {
         char* file_buf = NULL;
         size_t file_len = 0;
@@ -626,6 +1304,212 @@ int main(void)
         ac_vec_free(lines);
     });
 
+    TEST(read_file_lines_across_chunks, {
+        FILE* file = tmpfile();
+
+        // Lines longer than the read chunk, and empty lines
+        for (size_t i = 0; i < 150000; i++)
+            fputc('a' + i % 26, file);
+        fputs("\n\n", file);
+        for (size_t i = 0; i < 70000; i++)
+            fputc('x', file);
+        fputs("\nlast", file);
+        rewind(file);
+
+        Ac_StrVec lines = {0};
+
+        size_t bytes_read = ac_str_read_lines(&lines, file);
+
+        ASSERT_EQ((size_t)150000 + 2 + 70000 + 5, bytes_read, "%zu");
+        ASSERT_EQ((size_t)4, lines.len, "%zu");
+        ASSERT_EQ((size_t)150000, lines.items[0].len, "%zu");
+        char expected = 'a' + 149999 % 26;
+        ASSERT_EQ(expected, lines.items[0].chars[149999], "%c");
+        ASSERT_EQ((size_t)0, lines.items[1].len, "%zu");
+        ASSERT_EQ((size_t)70000, lines.items[2].len, "%zu");
+        ASSERT_EQ('\0', lines.items[2].chars[70000], "%c");
+        ASSERT_STR_EQ("last", lines.items[3].chars);
+
+        for (size_t i = 0; i < lines.len; i++)
+            ac_str_slice_free(&lines.items[i]);
+
+        ac_vec_free(lines);
+        fclose(file);
+    });
+
+    TEST(read_lines_alloc_failure, {
+        FILE* file = tmpfile();
+        fputs("foo\nbar\n", file);
+        rewind(file);
+
+        Ac_Allocator allocator = {.alloc = failing_alloc};
+        Ac_StrVec lines = {.allocator = &allocator};
+
+        ASSERT_EQ((size_t)0, ac_str_read_lines(&lines, file), "%zu");
+        ASSERT_EQ((size_t)0, lines.len, "%zu");
+        ASSERT_EQ(0L, ftell(file), "%ld");
+
+        fclose(file);
+    });
+
+    TEST(read_lines_buffered, {
+        FILE* file = tmpfile();
+        fputs("foo bar\n\nbaz\nqux", file);
+        rewind(file);
+
+        Ac_StrLines lines = ac_str_read_lines_buffered(file);
+
+        ASSERT_EQ((size_t)4, lines.lines.len, "%zu");
+        ASSERT_STR_EQ("foo bar", lines.lines.items[0].chars);
+        ASSERT_EQ((size_t)7, lines.lines.items[0].len, "%zu");
+        ASSERT_STR_EQ("", lines.lines.items[1].chars);
+        ASSERT_STR_EQ("baz", lines.lines.items[2].chars);
+        ASSERT_STR_EQ("qux", lines.lines.items[3].chars);
+
+        // Every line points into the single buffer
+        ASSERT_EQ(lines.buffer.chars, lines.lines.items[0].chars, "%p");
+        ASSERT_EQ(lines.buffer.chars + 13, lines.lines.items[3].chars, "%p");
+
+        ac_str_lines_free(&lines);
+        ASSERT_EQ((char*)0, lines.buffer.chars, "%p");
+        ASSERT_EQ((size_t)0, lines.lines.len, "%zu");
+        fclose(file);
+    });
+
+    TEST(split_lines_into, {
+        Ac_StrVec lines = {0};
+
+        ac_str_split_lines_into(&lines, ac_str_slice_from("a\nb\n"));
+        ASSERT_EQ((size_t)2, lines.len, "%zu");
+        ASSERT_STR_LEN_EQ("b", lines.items[1].chars, lines.items[1].len);
+
+        ac_vec_empty(&lines);
+        ac_str_split_lines_into(&lines, ac_str_slice_from(""));
+        ASSERT_EQ((size_t)0, lines.len, "%zu");
+
+        ac_str_split_lines_into(&lines, ac_str_slice_from("\n\nc"));
+        ASSERT_EQ((size_t)3, lines.len, "%zu");
+        ASSERT_EQ((size_t)0, lines.items[0].len, "%zu");
+        ASSERT_EQ((size_t)0, lines.items[1].len, "%zu");
+        ASSERT_STR_LEN_EQ("c", lines.items[2].chars, lines.items[2].len);
+
+        ac_vec_free(lines);
+    });
+
+    TEST(line_reader_file, {
+        FILE* file = tmpfile();
+
+        // Lines of growing length, so they straddle the end of the buffer at different offsets,
+        // and one line longer than the whole buffer
+        for (size_t i = 0; i < 2000; i++)
+        {
+            for (size_t j = 0; j < i; j++)
+                fputc('a' + i % 26, file);
+            fputc('\n', file);
+        }
+        for (size_t j = 0; j < ACLIB_LINE_READER_BUF_SIZE * 3; j++)
+            fputc('z', file);
+        rewind(file);
+
+        Ac_LineReader reader = ac_line_reader_from_file(file);
+
+        for (size_t i = 0; i < 2000; i++)
+        {
+            Ac_StrSliceOpt line = ac_line_reader_next(&reader);
+            ASSERT_EQ(AC_OPT_SOME, line.tag, "{tag: %d}");
+            ASSERT_EQ(i, line.some.len, "%zu");
+            ASSERT_EQ('\0', line.some.chars[line.some.len], "%c");
+            if (i > 0)
+            {
+                char expected = 'a' + i % 26;
+                ASSERT_EQ(expected, line.some.chars[i - 1], "%c");
+            }
+        }
+
+        Ac_StrSliceOpt line = ac_line_reader_next(&reader);
+        ASSERT_EQ((size_t)ACLIB_LINE_READER_BUF_SIZE * 3, line.some.len, "%zu");
+        ASSERT_EQ('z', line.some.chars[line.some.len - 1], "%c");
+
+        ASSERT_EQ(AC_OPT_NONE, ac_line_reader_next(&reader).tag, "{tag: %d}");
+        ASSERT_EQ(AC_OPT_NONE, ac_line_reader_next(&reader).tag, "{tag: %d}");
+
+        ac_line_reader_free(&reader);
+        fclose(file);
+    });
+
+    TEST(line_reader_fd, {
+        int fds[2];
+        ASSERT_EQ(0, pipe(fds), "%d");
+        char* input = "foo\n\nbar baz\n";
+        ASSERT_EQ((ssize_t)strlen(input), write(fds[1], input, strlen(input)), "%zd");
+        close(fds[1]);
+
+        Ac_LineReader reader = ac_line_reader_from_fd(fds[0]);
+
+        Ac_StrSliceOpt line = ac_line_reader_next(&reader);
+        ASSERT_STR_EQ("foo", line.some.chars);
+        line = ac_line_reader_next(&reader);
+        ASSERT_STR_EQ("", line.some.chars);
+        ASSERT_EQ(AC_OPT_SOME, line.tag, "{tag: %d}");
+        line = ac_line_reader_next(&reader);
+        ASSERT_STR_EQ("bar baz", line.some.chars);
+        ASSERT_EQ((size_t)7, line.some.len, "%zu");
+
+        // A trailing '\n' doesn't start a new line
+        ASSERT_EQ(AC_OPT_NONE, ac_line_reader_next(&reader).tag, "{tag: %d}");
+        ASSERT_EQ(0, reader.error, "%d");
+
+        ac_line_reader_free(&reader);
+        close(fds[0]);
+    });
+
+    TEST(line_reader_errors, {
+        int fds[2];
+        ASSERT_EQ(0, pipe(fds), "%d");
+        ASSERT_EQ(0, fcntl(fds[0], F_SETFL, O_NONBLOCK), "%d");
+        ASSERT_EQ((ssize_t)6, write(fds[1], "foo\nba", 6), "%zd");
+
+        Ac_LineReader reader = ac_line_reader_from_fd(fds[0]);
+
+        Ac_StrSliceOpt line = ac_line_reader_next(&reader);
+        ASSERT_STR_EQ("foo", line.some.chars);
+
+        // The pipe is still open but empty, which is not the end of the input
+        line = ac_line_reader_next(&reader);
+        ASSERT_EQ(AC_OPT_NONE, line.tag, "{tag: %d}");
+        ASSERT_EQ(EAGAIN, reader.error, "%d");
+
+        // The partial line is kept, and finished once more input arrives
+        ASSERT_EQ((ssize_t)2, write(fds[1], "r\n", 2), "%zd");
+        close(fds[1]);
+        line = ac_line_reader_next(&reader);
+        ASSERT_EQ(0, reader.error, "%d");
+        ASSERT_STR_EQ("bar", line.some.chars);
+        ASSERT_EQ(AC_OPT_NONE, ac_line_reader_next(&reader).tag, "{tag: %d}");
+        ASSERT_EQ(0, reader.error, "%d");
+
+        ac_line_reader_free(&reader);
+        close(fds[0]);
+
+        reader = ac_line_reader_from_fd(-1);
+        ASSERT_EQ(AC_OPT_NONE, ac_line_reader_next(&reader).tag, "{tag: %d}");
+        ASSERT_EQ(EBADF, reader.error, "%d");
+        ac_line_reader_free(&reader);
+        ASSERT_EQ(0, reader.error, "%d");
+        ASSERT(!reader.eof);
+
+        // A file whose fd was closed under it fails to be read from
+        ASSERT_EQ(0, pipe(fds), "%d");
+        close(fds[1]);
+        FILE* file = fdopen(fds[0], "r");
+        close(fds[0]);
+        reader = ac_line_reader_from_file(file);
+        ASSERT_EQ(AC_OPT_NONE, ac_line_reader_next(&reader).tag, "{tag: %d}");
+        ASSERT_EQ(EBADF, reader.error, "%d");
+        ac_line_reader_free(&reader);
+        fclose(file);
+    });
+
     TEST(string_fmt, {
         Ac_String str = ac_str_from("foobar");
 
@@ -650,6 +1534,509 @@ int main(void)
         ac_str_free(&str);
     });
 
+    TEST(string_push_keeps_capacity, {
+        Ac_String str = {0};
+
+        ac_str_push(&str, 'a');
+        size_t cap = str.cap;
+        char* chars = str.chars;
+        for (size_t i = 1; i < cap; i++)
+            ac_str_push(&str, 'a');
+
+        // Filling the capacity must not reallocate
+        ASSERT_EQ(chars, str.chars, "%p");
+        ASSERT_EQ(cap, str.len, "%zu");
+        ASSERT_EQ('\0', str.chars[str.len], "%c");
+
+        ac_str_free(&str);
+    });
+
+    TEST(string_reserve_exact_and_shrink_to_fit, {
+        Ac_String str = {0};
+
+        ac_str_reserve_exact(&str, 100);
+        ASSERT_LTE((size_t)100, str.cap, "%zu");
+        ASSERT_STR_EQ("", str.chars);
+
+        ac_str_append(&str, "foo");
+        ac_str_shrink_to_fit(&str);
+        ASSERT_EQ((size_t)3, str.cap, "%zu");
+        ASSERT_STR_EQ("foo", str.chars);
+
+        ac_str_free(&str);
+    });
+
+    TEST(split_finds_delims_at_every_offset, {
+        char buf[100];
+
+        for (size_t len = 1; len <= sizeof(buf); len++)
+        {
+            for (size_t pos = 0; pos < len; pos++)
+            {
+                memset(buf, 'a', len);
+                buf[pos] = '\t';
+
+                Ac_StrVec parts = ac_str_split_by_borrowed((Ac_StrSlice){buf, len}, '\t');
+                ASSERT_EQ((size_t)2, parts.len, "%zu");
+                ASSERT_EQ(pos, parts.items[0].len, "%zu");
+                ASSERT_EQ(len - pos - 1, parts.items[1].len, "%zu");
+                ac_vec_free(parts);
+
+                parts = ac_str_split_by_many_borrowed((Ac_StrSlice){buf, len}, " \t");
+                ASSERT_EQ((size_t)2, parts.len, "%zu");
+                ASSERT_EQ(pos, parts.items[0].len, "%zu");
+                ac_vec_free(parts);
+            }
+
+            // The bytes after the slice must not be matched
+            memset(buf, 'a', sizeof(buf));
+            buf[len - 1] = ',';
+            Ac_StrVec parts = ac_str_split_by_borrowed((Ac_StrSlice){buf, len - 1}, ',');
+            ASSERT_EQ((size_t)1, parts.len, "%zu");
+            ac_vec_free(parts);
+        }
+    });
+
+    TEST(trimmed_long_whitespace, {
+        char buf[100];
+
+        for (size_t front = 0; front < 40; front++)
+        {
+            for (size_t back = 0; back < 40; back++)
+            {
+                memset(buf, '\v', front);
+                memcpy(buf + front, "x \ty", 4);
+                memset(buf + front + 4, ' ', back);
+
+                Ac_StrSlice trimmed = ac_str_trimmed((Ac_StrSlice){buf, front + 4 + back});
+                ASSERT_EQ(buf + front, trimmed.chars, "%p");
+                ASSERT_EQ((size_t)4, trimmed.len, "%zu");
+            }
+
+            memset(buf, '\r', front);
+            Ac_StrSlice trimmed = ac_str_trimmed((Ac_StrSlice){buf, front});
+            ASSERT_EQ((size_t)0, trimmed.len, "%zu");
+        }
+    });
+
+    TEST(byteset_contains, {
+        Ac_ByteSet set = ac_byteset_from(" ,;");
+        ac_byteset_add(&set, (char)0xFF);
+        ac_byteset_add_range(&set, '0', '9');
+
+        for (int ch = 0; ch < 256; ch++)
+        {
+            bool expected = ch == ' ' || ch == ',' || ch == ';' || ch == 0xFF ||
+                            (ch >= '0' && ch <= '9');
+            ASSERT_EQ(expected, ac_byteset_contains(&set, (char)ch), "%d");
+        }
+
+        ac_byteset_invert(&set);
+        ASSERT_EQ(false, ac_byteset_contains(&set, ','), "%d");
+        ASSERT_EQ(true, ac_byteset_contains(&set, 'a'), "%d");
+        ASSERT_EQ(true, ac_byteset_contains(&set, '\0'), "%d");
+    });
+
+    TEST(byteset_find_every_byte_and_offset, {
+        char buf[100];
+
+        for (int ch = 0; ch < 256; ch++)
+        {
+            Ac_ByteSet set = {0};
+            ac_byteset_add(&set, (char)ch);
+            // A byte sharing the nibbles of ch, but not in the set, must not match
+            char filler = (char)((ch ^ 0x80) == ch ? 0x01 : (ch ^ 0x80));
+
+            for (size_t len = 1; len <= sizeof(buf); len += 7)
+            {
+                memset(buf, filler, sizeof(buf));
+                ASSERT_EQ(len, ac_byteset_find(&set, (Ac_StrSlice){buf, len}), "%zu");
+
+                size_t pos = (size_t)ch % len;
+                buf[pos] = (char)ch;
+                ASSERT_EQ(pos, ac_byteset_find(&set, (Ac_StrSlice){buf, len}), "%zu");
+            }
+        }
+    });
+
+    TEST(byteset_find_not_and_classify, {
+        char buf[100];
+        bool classes[100];
+        Ac_ByteSet set = ac_byteset_from("ab");
+
+        for (size_t len = 1; len <= sizeof(buf); len++)
+        {
+            for (size_t i = 0; i < len; i++)
+                buf[i] = "ab"[i % 2];
+            ASSERT_EQ(len, ac_byteset_find_not(&set, (Ac_StrSlice){buf, len}), "%zu");
+
+            buf[len - 1] = 'c';
+            ASSERT_EQ(len - 1, ac_byteset_find_not(&set, (Ac_StrSlice){buf, len}), "%zu");
+
+            ac_byteset_classify(&set, (Ac_StrSlice){buf, len}, classes);
+            for (size_t i = 0; i + 1 < len; i++)
+                ASSERT_EQ(true, classes[i], "%d");
+            ASSERT_EQ(false, classes[len - 1], "%d");
+        }
+    });
+
+    TEST(split_by_set, {
+        Ac_ByteSet set = ac_byteset_from(" \t;");
+        Ac_StrSlice slc = ac_str_slice_from("foo bar;;baz\tqux");
+
+        Ac_StrVec parts = ac_str_split_by_set_borrowed(slc, &set);
+
+        ASSERT_EQ((size_t)5, parts.len, "%zu");
+        ASSERT_STR_LEN_EQ("foo", parts.items[0].chars, parts.items[0].len);
+        ASSERT_STR_LEN_EQ("bar", parts.items[1].chars, parts.items[1].len);
+        ASSERT_EQ((size_t)0, parts.items[2].len, "%zu");
+        ASSERT_STR_LEN_EQ("baz", parts.items[3].chars, parts.items[3].len);
+        ASSERT_STR_LEN_EQ("qux", parts.items[4].chars, parts.items[4].len);
+        ac_vec_free(parts);
+
+        Ac_StrSplitIter iter = ac_str_split_iter_set(slc, &set);
+        size_t count = 0;
+        while (ac_str_split_iter_next(&iter).tag == AC_OPT_SOME)
+            count++;
+        ASSERT_EQ((size_t)5, count, "%zu");
+    });
+
+    TEST(trimmed_by_set, {
+        Ac_ByteSet set = ac_byteset_from("-_");
+        char buf[100];
+
+        for (size_t pad = 0; pad < 45; pad++)
+        {
+            memset(buf, '-', pad);
+            memcpy(buf + pad, "a-b", 3);
+            memset(buf + pad + 3, '_', pad);
+
+            Ac_StrSlice trimmed = ac_str_trimmed_by((Ac_StrSlice){buf, pad * 2 + 3}, &set);
+            ASSERT_EQ(buf + pad, trimmed.chars, "%p");
+            ASSERT_EQ((size_t)3, trimmed.len, "%zu");
+        }
+
+        Ac_StrSlice trimmed = ac_str_trimmed_by(ac_str_slice_from("-_-_-_-_-_-_-_-_-_-_"), &set);
+        ASSERT_EQ((size_t)0, trimmed.len, "%zu");
+    });
+
+    TEST(simple_find_and_rfind, {
+        Ac_StrSlice slc = ac_str_slice_from("foo bar foo baz");
+
+        Ac_SizeOpt found = ac_str_find(slc, ac_str_slice_from("foo"));
+        ASSERT_EQ(AC_OPT_SOME, found.tag, "{tag: %d}");
+        ASSERT_EQ((size_t)0, found.some, "%zu");
+
+        found = ac_str_rfind(slc, ac_str_slice_from("foo"));
+        ASSERT_EQ((size_t)8, found.some, "%zu");
+
+        found = ac_str_find(slc, ac_str_slice_from("ba"));
+        ASSERT_EQ((size_t)4, found.some, "%zu");
+
+        found = ac_str_find(slc, ac_str_slice_from("qux"));
+        ASSERT_EQ(AC_OPT_NONE, found.tag, "{tag: %d}");
+
+        found = ac_str_find(ac_str_slice_from("fo"), ac_str_slice_from("foo"));
+        ASSERT_EQ(AC_OPT_NONE, found.tag, "{tag: %d}");
+
+        found = ac_str_find(slc, ac_str_slice_from(""));
+        ASSERT_EQ((size_t)0, found.some, "%zu");
+        found = ac_str_rfind(slc, ac_str_slice_from(""));
+        ASSERT_EQ(slc.len, found.some, "%zu");
+
+        // Works on slices that aren't '\0' terminated, and can hold '\0'
+        Ac_StrSlice bytes = ((Ac_StrSlice){.chars = "ab\0cd\0cdX", .len = 8});
+        found = ac_str_rfind(bytes, (Ac_StrSlice){.chars = "\0cd", .len = 3});
+        ASSERT_EQ((size_t)5, found.some, "%zu");
+        found = ac_str_find(bytes, ac_str_slice_from("dX"));
+        ASSERT_EQ(AC_OPT_NONE, found.tag, "{tag: %d}");
+    });
+
+    TEST(find_matches_naive_search, {
+        char haystack[300];
+        char needle[80];
+        unsigned seed = 1234;
+
+        for (size_t round = 0; round < 3000; round++)
+        {
+            // Small alphabets give many partial and periodic matches
+            size_t alphabet = 2 + round % 3;
+            size_t len = 1 + (seed = seed * 1103515245 + 12345) % sizeof(haystack);
+            size_t needle_len = 1 + (seed = seed * 1103515245 + 12345) % sizeof(needle);
+            if (needle_len > len)
+                needle_len = len;
+
+            for (size_t i = 0; i < len; i++)
+                haystack[i] = 'a' + (seed = seed * 1103515245 + 12345) / 65536 % alphabet;
+
+            // Mostly take the needle from the haystack, so it is often found
+            size_t from = (seed = seed * 1103515245 + 12345) / 65536 % (len - needle_len + 1);
+            memcpy(needle, haystack + from, needle_len);
+            if (round % 4 == 0)
+                needle[needle_len / 2] = 'a' + (needle[needle_len / 2] - 'a' + 1) % alphabet;
+
+            Ac_StrSlice hay = ((Ac_StrSlice){.chars = haystack, .len = len});
+            Ac_StrSlice ndl = ((Ac_StrSlice){.chars = needle, .len = needle_len});
+            Ac_StrNeedle compiled = ac_str_needle(ndl);
+
+            size_t expected = naive_find(hay, ndl, false);
+            Ac_SizeOpt found = ac_str_needle_find(&compiled, hay);
+            ASSERT_EQ(expected, ac_opt_unwrap_or(found, SIZE_MAX), "%zu");
+            found = ac_str_find(hay, ndl);
+            ASSERT_EQ(expected, ac_opt_unwrap_or(found, SIZE_MAX), "%zu");
+
+            expected = naive_find(hay, ndl, true);
+            found = ac_str_needle_rfind(&compiled, hay);
+            ASSERT_EQ(expected, ac_opt_unwrap_or(found, SIZE_MAX), "%zu");
+            found = ac_str_rfind(hay, ndl);
+            ASSERT_EQ(expected, ac_opt_unwrap_or(found, SIZE_MAX), "%zu");
+        }
+    });
+
+    TEST(find_all, {
+        Ac_StrSlice slc = ac_str_slice_from("aaaa-aa-a");
+
+        Ac_SizeVec matches = ac_str_find_all(slc, ac_str_slice_from("aa"));
+
+        // Matches don't overlap
+        ASSERT_EQ((size_t)3, matches.len, "%zu");
+        ASSERT_EQ((size_t)0, matches.items[0], "%zu");
+        ASSERT_EQ((size_t)2, matches.items[1], "%zu");
+        ASSERT_EQ((size_t)5, matches.items[2], "%zu");
+        ac_vec_free(matches);
+
+        matches = ac_str_find_all(slc, ac_str_slice_from(""));
+        ASSERT_EQ((size_t)0, matches.len, "%zu");
+
+        // A long needle, found with Two-Way
+        Ac_String str = {0};
+        for (size_t i = 0; i < 5; i++)
+            ac_str_append(&str, "0123456789abcdefghijklmnopqrstuvwxyz|");
+
+        Ac_StrSlice long_needle = ac_str_slice_from("0123456789abcdefghijklmnopqrstuvwxyz");
+        Ac_StrNeedle needle = ac_str_needle(long_needle);
+        ac_str_needle_find_all_into(&matches, &needle, str.slice);
+        ASSERT_EQ((size_t)5, matches.len, "%zu");
+        ASSERT_EQ((size_t)37 * 4, matches.items[4], "%zu");
+
+        ac_vec_free(matches);
+        ac_str_free(&str);
+    });
+
+    TEST(hash_seeds_and_bytes, {
+        Ac_StrSlice slc = ac_str_slice_from("the quick brown fox");
+
+        ASSERT_EQ(ac_str_hash(slc, 1), ac_str_hash_bytes(slc.chars, slc.len, 1), "%" PRIu64);
+        ASSERT_NEQ(ac_str_hash(slc, 1), ac_str_hash(slc, 2), "%" PRIu64);
+        ASSERT_NEQ(ac_str_hash(ac_str_slice_from(""), 0), ac_str_hash(ac_str_slice_from("a"), 0),
+                   "%" PRIu64);
+
+        // Flipping any bit of inputs of every length path changes the hash
+        static char bytes[2048];
+        for (size_t i = 0; i < sizeof(bytes); i++)
+            bytes[i] = (char)(i * 7 + 3);
+
+        for (size_t i = 0; i < 8; i++)
+        {
+            uint64_t hash = ac_str_hash_bytes(bytes, hash_lens[i], 0);
+            for (size_t bit = 0; bit < hash_lens[i] * 8; bit += 5)
+            {
+                bytes[bit / 8] ^= (char)(1 << (bit % 8));
+                ASSERT_NEQ(hash, ac_str_hash_bytes(bytes, hash_lens[i], 0), "%" PRIu64);
+                bytes[bit / 8] ^= (char)(1 << (bit % 8));
+            }
+        }
+    });
+
+    TEST(hasher_matches_one_shot, {
+        static char bytes[5000];
+        for (size_t i = 0; i < sizeof(bytes); i++)
+            bytes[i] = (char)(i * 31 + i / 7);
+
+        for (size_t len = 0; len <= sizeof(bytes); len += len < 600 ? 1 : 97)
+        {
+            uint64_t expected = ac_str_hash_bytes(bytes, len, 42);
+            for (size_t i = 0; i < 5; i++)
+            {
+                Ac_StrHasher hasher = ac_str_hasher(42);
+                for (size_t start = 0; start < len; start += hash_chunk_sizes[i])
+                {
+                    size_t end = start + hash_chunk_sizes[i];
+                    if (end > len)
+                        end = len;
+                    Ac_StrSlice chunk = ((Ac_StrSlice){.chars = bytes + start});
+                    chunk.len = end - start;
+                    ac_str_hasher_update(&hasher, chunk);
+                }
+                ASSERT_EQ(expected, ac_str_hasher_finish(&hasher), "%" PRIu64);
+            }
+        }
+    });
+
+    TEST(multi_matcher_find_all, {
+        Ac_StrVec patterns = {0};
+        for (size_t i = 0; i < 5; i++)
+            ac_vec_push(&patterns, ac_str_slice_from(multi_patterns[i]));
+
+        Ac_MultiMatcher matcher = ac_multi_matcher_from(patterns, false);
+        Ac_MultiMatchVec matches = ac_multi_matcher_find_all(&matcher, ac_str_slice_from("ushers"));
+
+        // "she" and "he" both end at the 'e', the longest first. The empty pattern never matches
+        ASSERT_EQ((size_t)3, matches.len, "%zu");
+        ASSERT_EQ((size_t)1, matches.items[0].pattern, "%zu");
+        ASSERT_EQ((size_t)1, matches.items[0].start, "%zu");
+        ASSERT_EQ((size_t)3, matches.items[0].len, "%zu");
+        ASSERT_EQ((size_t)0, matches.items[1].pattern, "%zu");
+        ASSERT_EQ((size_t)2, matches.items[1].start, "%zu");
+        ASSERT_EQ((size_t)3, matches.items[2].pattern, "%zu");
+        ASSERT_EQ((size_t)2, matches.items[2].start, "%zu");
+        ASSERT_EQ((size_t)4, matches.items[2].len, "%zu");
+
+        ASSERT(ac_multi_matcher_is_match(&matcher, ac_str_slice_from("this")));
+        ASSERT(!ac_multi_matcher_is_match(&matcher, ac_str_slice_from("HERS")));
+        ASSERT(!ac_multi_matcher_is_match(&matcher, ac_str_slice_from("")));
+
+        ac_vec_free(matches);
+        ac_multi_matcher_free(&matcher);
+
+        matcher = ac_multi_matcher_from(patterns, true);
+        matches = ac_multi_matcher_find_all(&matcher, ac_str_slice_from("HiS [hErS]"));
+        ASSERT_EQ((size_t)3, matches.len, "%zu");
+        ASSERT_EQ((size_t)2, matches.items[0].pattern, "%zu");
+        ASSERT_EQ((size_t)0, matches.items[0].start, "%zu");
+        ASSERT_EQ((size_t)0, matches.items[1].pattern, "%zu");
+        ASSERT_EQ((size_t)5, matches.items[1].start, "%zu");
+        ASSERT_EQ((size_t)3, matches.items[2].pattern, "%zu");
+
+        ac_vec_free(matches);
+        ac_multi_matcher_free(&matcher);
+        ac_vec_free(patterns);
+    });
+
+    TEST(multi_matcher_matches_naive, {
+        char haystack[256];
+        char pattern_chars[64][6];
+        uint32_t seed = 7;
+
+        for (size_t round = 0; round < 50; round++)
+        {
+            size_t alphabet = 2 + round % 5;
+            size_t len = (seed = seed * 1103515245 + 12345) / 65536 % sizeof(haystack);
+            for (size_t i = 0; i < len; i++)
+                haystack[i] = 'a' + (seed = seed * 1103515245 + 12345) / 65536 % alphabet;
+
+            Ac_StrVec patterns = {0};
+            size_t pattern_count = 1 + round;
+            for (size_t i = 0; i < pattern_count; i++)
+            {
+                size_t pattern_len = 1 + (seed = seed * 1103515245 + 12345) / 65536 % 5;
+                for (size_t j = 0; j < pattern_len; j++)
+                {
+                    seed = seed * 1103515245 + 12345;
+                    pattern_chars[i][j] = 'a' + seed / 65536 % alphabet;
+                }
+                Ac_StrSlice pattern = ((Ac_StrSlice){.chars = pattern_chars[i]});
+                pattern.len = pattern_len;
+                ac_vec_push(&patterns, pattern);
+            }
+
+            Ac_MultiMatcher matcher = ac_multi_matcher_from(patterns, false);
+            Ac_StrSlice hay = ((Ac_StrSlice){.chars = haystack, .len = len});
+            Ac_MultiMatchVec matches = ac_multi_matcher_find_all(&matcher, hay);
+
+            // Every reported match is real, and it is the first index of its pattern
+            size_t expected = 0;
+            for (size_t i = 0; i < matches.len; i++)
+            {
+                Ac_MultiMatch match = matches.items[i];
+                Ac_StrSlice pattern = patterns.items[match.pattern];
+                ASSERT_EQ(pattern.len, match.len, "%zu");
+                ASSERT_EQ(0, memcmp(haystack + match.start, pattern.chars, pattern.len), "%d");
+                for (size_t j = 0; j < match.pattern; j++)
+                    ASSERT(!slice_eql(patterns.items[j], pattern));
+            }
+
+            // Count the occurrences of every distinct pattern naively
+            for (size_t i = 0; i < pattern_count; i++)
+            {
+                bool duplicate = false;
+                for (size_t j = 0; j < i; j++)
+                    duplicate = duplicate || slice_eql(patterns.items[j], patterns.items[i]);
+                if (duplicate)
+                    continue;
+
+                for (size_t start = 0; start + patterns.items[i].len <= len; start++)
+                {
+                    Ac_StrSlice rest = ((Ac_StrSlice){.chars = haystack + start});
+                    rest.len = len - start;
+                    if (naive_find(rest, patterns.items[i], false) == 0)
+                        expected++;
+                }
+            }
+            ASSERT_EQ(expected, matches.len, "%zu");
+            ASSERT_EQ(expected > 0, ac_multi_matcher_is_match(&matcher, hay), "%d");
+
+            ac_vec_free(matches);
+            ac_multi_matcher_free(&matcher);
+            ac_vec_free(patterns);
+        }
+    });
+
+    TEST(interner, {
+        Ac_StrInterner interner;
+        ac_str_interner_init(&interner);
+
+        char name[] = "metric.cpu";
+        Ac_InternedStr cpu = ac_str_interner_intern(&interner, ac_str_slice_from(name));
+        Ac_InternedStr mem = ac_str_interner_intern(&interner, ac_str_slice_from("metric.mem"));
+        ASSERT_EQ((uint32_t)0, cpu.id, "%u");
+        ASSERT_EQ((uint32_t)1, mem.id, "%u");
+
+        // The interned copy doesn't depend on the original chars
+        name[0] = 'M';
+        ASSERT_STR_EQ("metric.cpu", cpu.str.chars);
+
+        Ac_InternedStr again = ac_str_interner_intern(&interner, ac_str_slice_from("metric.cpu"));
+        ASSERT_EQ(cpu.id, again.id, "%u");
+        ASSERT_EQ(cpu.str.chars, again.str.chars, "%p");
+
+        Ac_InternedStrOpt found = ac_str_interner_find(&interner, mem.str);
+        ASSERT_EQ(AC_OPT_SOME, found.tag, "%d");
+        ASSERT_EQ(mem.id, found.some.id, "%u");
+
+        found = ac_str_interner_find(&interner, ac_str_slice_from("Metric.cpu"));
+        ASSERT_EQ(AC_OPT_NONE, found.tag, "%d");
+
+        Ac_StrSlice str = ac_str_interner_get(&interner, mem.id);
+        ASSERT_STR_EQ("metric.mem", str.chars);
+
+        ac_str_interner_free(&interner);
+    });
+
+    TEST(interner_threads, {
+        ac_str_interner_init(&shared_interner);
+
+        pthread_t threads[4];
+        for (size_t i = 0; i < 4; i++)
+            pthread_create(&threads[i], NULL, intern_names, (void*)i);
+        for (size_t i = 0; i < 4; i++)
+            pthread_join(threads[i], NULL);
+
+        // Every thread got the same id for each name, and every name got its own id
+        ASSERT_EQ((size_t)1000, shared_interner.strings.len, "%zu");
+        for (size_t n = 0; n < 1000; n++)
+        {
+            for (size_t i = 1; i < 4; i++)
+                ASSERT_EQ(interned_ids[0][n], interned_ids[i][n], "%u");
+
+            char name[32];
+            snprintf(name, sizeof(name), "host-%zu", n);
+            Ac_StrSlice str = ac_str_interner_get(&shared_interner, interned_ids[0][n]);
+            ASSERT_STR_EQ(name, str.chars);
+        }
+
+        ac_str_interner_free(&shared_interner);
+    });
 
     TEST_END;
 }
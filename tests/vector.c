@@ -5,6 +5,30 @@
 typedef Ac_VecDef(int) IntVec;
 typedef Ac_OptDef(int) IntOpt;
 
+size_t realloc_count = 0;
+
+void* counting_alloc(void* ctx, size_t size)
+{
+    return malloc(size);
+}
+
+void* counting_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size)
+{
+    realloc_count++;
+    return realloc(ptr, new_size);
+}
+
+void counting_free(void* ctx, void* ptr)
+{
+    free(ptr);
+}
+
+const Ac_Allocator counting_allocator = {
+    .alloc = counting_alloc,
+    .realloc = counting_realloc,
+    .free = counting_free,
+};
+
 int main(void)
 {
     TEST_INIT;
@@ -40,7 +64,7 @@ int main(void)
         ac_vec_push(&ivec, 1);
         ASSERT_EQ(1, ivec.items[0], "%d");
         ASSERT_EQ((size_t)1, ivec.len, "%zu");
-        ASSERT_GTE((size_t)1, ivec.cap, "%zu");
+        ASSERT_LTE((size_t)1, ivec.cap, "%zu");
         ASSERT_NEQ((void *)0, ivec.items, "%p");
 
         ac_vec_free(ivec);
@@ -143,6 +167,26 @@ int main(void)
         ASSERT_EQ(2, shifted, "%d");
     });
 
+    TEST(unshift_shift_many, {
+        IntVec ivec = {0};
+
+        for (int i = 0; i < 20; i++)
+            ac_vec_unshift(&ivec, i);
+
+        for (int i = 0; i < 20; i++)
+            ASSERT_EQ(19 - i, ivec.items[i], "%d");
+
+        int shifted;
+        for (int i = 19; i >= 0; i--)
+        {
+            ac_vec_shift(&ivec, &shifted);
+            ASSERT_EQ(i, shifted, "%d");
+        }
+        ASSERT_EQ((size_t)0, ivec.len, "%zu");
+
+        ac_vec_free(ivec);
+    });
+
     TEST(simple_prepend, {
         IntVec ivec = {0};
 
@@ -191,5 +235,49 @@ int main(void)
         ac_vec_free(ivec);
     });
 
+    TEST(push_reallocs_logarithmically, {
+        IntVec ivec = {.allocator = &counting_allocator};
+        realloc_count = 0;
+
+        for (int i = 0; i < 100000; i++)
+            ac_vec_push(&ivec, i);
+
+        // 10 * 2^14 > 100000
+        ASSERT_GTE((size_t)15, realloc_count, "%zu");
+        ASSERT_EQ(99999, ivec.items[99999], "%d");
+
+        ac_vec_free(ivec);
+    });
+
+    TEST(growth_policies, {
+        ASSERT_EQ((size_t)ACLIB_VEC_START_CAP, ac_growth_geometric(0, 1, sizeof(int)), "%zu");
+        ASSERT_EQ((size_t)40, ac_growth_geometric(10, 21, sizeof(int)), "%zu");
+        ASSERT_EQ((size_t)64, ac_growth_pow2(10, 33, sizeof(int)), "%zu");
+        ASSERT_EQ((size_t)1, ac_growth_pow2(0, 1, sizeof(int)), "%zu");
+        ASSERT_EQ((size_t)33, ac_growth_exact(10, 33, sizeof(int)), "%zu");
+    });
+
+    TEST(reserve_exact_and_shrink_to_fit, {
+        IntVec ivec = {.allocator = &counting_allocator};
+
+        ac_vec_reserve_exact(&ivec, 3);
+        ASSERT_EQ((size_t)3, ivec.cap, "%zu");
+
+        ac_vec_push(&ivec, 1);
+        ac_vec_push(&ivec, 2);
+        ac_vec_push(&ivec, 3);
+        ac_vec_push(&ivec, 4);
+        ASSERT_LT((size_t)4, ivec.cap, "%zu");
+
+        ac_vec_shrink_to_fit(&ivec);
+        ASSERT_EQ((size_t)4, ivec.cap, "%zu");
+        ASSERT_ARR_EQ(((int[]){1, 2, 3, 4}), ivec.items, 4, "%d");
+
+        ac_vec_empty(&ivec);
+        ac_vec_shrink_to_fit(&ivec);
+        ASSERT_EQ((size_t)0, ivec.cap, "%zu");
+        ASSERT_EQ((int*)0, ivec.items, "%p");
+    });
+
     TEST_END;
 }